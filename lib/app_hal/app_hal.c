@@ -5,6 +5,15 @@
 #include "drivers/sdl/lv_sdl_mouse.h"
 #include "drivers/sdl/lv_sdl_mousewheel.h"
 #include "drivers/sdl/lv_sdl_keyboard.h"
+#include "uiTiming.h"
+#ifdef HAL_BLIT_MODEL
+#include <stdlib.h>
+#include "lvglBlit.h"
+#endif
+#ifdef HAL_SWAP_MODEL
+#include "display/lv_display_private.h"
+#include "lvglSwap.h"
+#endif
 
 
 
@@ -15,6 +24,68 @@ static lv_indev_t *lvMouseWheel;
 static lv_indev_t *lvKeyboard;
 
 
+#ifdef HAL_BLIT_MODEL
+/* Host model of the target's flush path: every area SDL flushes is also copied
+ * into a model of the LTDC framebuffer through the blit backend, so the bytes
+ * and transfers per frame can be compared with the per-pixel baseline.*/
+static void blit_model_event_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_target(e);
+    const lv_area_t * area = lv_event_get_param(e);
+    lv_draw_buf_t * buf = lv_display_get_buf_active(disp);
+    uint32_t stride = buf->header.stride;
+    const uint8_t * px_map = buf->data;
+
+#if LV_SDL_RENDER_MODE != LV_DISPLAY_RENDER_MODE_PARTIAL
+    px_map += area->y1 * stride + area->x1 * lv_color_format_get_size(buf->header.cf);
+#endif
+
+    bool last = lv_display_flush_is_last(disp);
+    blit_area(area, px_map, stride, last, NULL, NULL);
+
+    if(last) {
+        blit_stats_t stats;
+        blit_get_stats(&stats);
+        if(stats.frames % 60 == 0) {
+            uint32_t px = stats.last_frame_bytes / sizeof(uint32_t);
+            LV_LOG_USER("blit (%s): %u bytes in %u transfers per frame (per-pixel path: %u calls)",
+                        blit_get_backend()->name, (unsigned)stats.last_frame_bytes,
+                        (unsigned)stats.last_frame_transfers, (unsigned)px);
+        }
+    }
+}
+#endif
+
+#ifdef HAL_SWAP_MODEL
+/* Host stand-in for the target's double buffered DIRECT/FULL mode: the flush only
+ * writes the layer address shadow register of `swap_layer_host()` and the simulated
+ * vblank loads it and presents the buffer through the SDL driver's flush.
+ * Needs LV_SDL_RENDER_MODE DIRECT or FULL with LV_SDL_BUF_COUNT 2.*/
+static lv_display_flush_cb_t sdl_flush_cb;
+
+static void swap_model_vblank(lv_display_t * disp)
+{
+    if(!swap_host_vblank()) return;
+
+    lv_area_t full;
+    lv_area_set(&full, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                 lv_display_get_vertical_resolution(disp) - 1);
+    sdl_flush_cb(disp, &full, (uint8_t *)swap_host_get_active_address());
+
+    swap_stats_t stats;
+    swap_get_stats(&stats);
+    if(stats.swaps % 60 == 0) {
+        LV_LOG_USER("swap: %u swaps, %u writes into the front buffer",
+                    (unsigned)stats.swaps, (unsigned)stats.front_buffer_writes);
+    }
+}
+
+static void swap_model_vblank_timer_cb(lv_timer_t * t)
+{
+    swap_model_vblank(lv_timer_get_user_data(t));
+}
+#endif
+
 #if LV_USE_LOG != 0
 static void lv_log_print_g_cb(lv_log_level_t level, const char * buf)
 {
@@ -47,9 +118,28 @@ void hal_setup(void)
     
     lv_sdl_window_set_zoom(lvDisplay, SDL_ZOOM);
 
+    #ifdef HAL_BLIT_MODEL
+        int32_t hor_res = lv_display_get_horizontal_resolution(lvDisplay);
+        int32_t ver_res = lv_display_get_vertical_resolution(lvDisplay);
+        blit_set_framebuffer(malloc(hor_res * ver_res * sizeof(uint32_t)), hor_res, ver_res, sizeof(uint32_t));
+        blit_set_backend(blit_backend_memcpy());
+        lv_display_add_event_cb(lvDisplay, blit_model_event_cb, LV_EVENT_FLUSH_START, NULL);
+    #endif
+
+    #ifdef HAL_SWAP_MODEL
+        sdl_flush_cb = lvDisplay->flush_cb;
+        lv_display_set_flush_cb(lvDisplay, swap_flush_cb);
+        /* LVGL waiting for the swap is a vblank, and there is one every 16 ms anyway */
+        lv_display_set_flush_wait_cb(lvDisplay, swap_model_vblank);
+        lv_timer_create(swap_model_vblank_timer_cb, 16, lvDisplay);
+        swap_init(lvDisplay, swap_layer_host(), lvDisplay->buf_2->data);
+    #endif
+
     lvMouse = lv_sdl_mouse_create();
     lvMouseWheel = lv_sdl_mousewheel_create();
     lvKeyboard = lv_sdl_keyboard_create();
+
+    ui_timing_log_every(10000);
 }
 
 void hal_loop(void)
@@ -60,6 +150,6 @@ void hal_loop(void)
         Uint32 current = SDL_GetTicks();
         lv_tick_inc(current - lastTick); // Update the tick timer. Tick is new for LVGL 9
         lastTick = current;
-        lv_timer_handler(); // Update the UI-
+        ui_timing_timer_handler(); // Update the UI and record how long it took
     }
 }
@@ -0,0 +1,2465 @@
+#include "drawBench.h"
+#include "display/lv_display_private.h"
+#include "misc/lv_text_private.h"
+#include "draw/lv_draw_buf_private.h"
+#include "draw/lv_image_decoder_private.h"
+#include "core/lv_global.h"
+#include "draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+#include "draw/sw/blend/x86/lv_blend_x86.h"
+#endif
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#include "stdlib/builtin/lv_tlsf.h"
+#endif
+#if LV_USE_LODEPNG
+#include "libs/lodepng/lodepng.h"
+#endif
+#include <stdlib.h>
+
+#define RECT_SIZE 4
+#define LABEL_COLS 6
+#define LABEL_ROWS 10
+#define CARD_COLS 4
+#define CARD_ROWS 3
+#define BUTTON_COLS 8
+#define BUTTON_ROWS 8
+#define STYLE_COLS 6
+#define STYLE_ROWS 6
+
+/*Size limits of the random blend cases*/
+#define BLEND_CHECK_W 70
+#define BLEND_CHECK_H 4
+#define BLEND_CHECK_PAD 4
+#define BLEND_CHECK_BUF_SIZE ((BLEND_CHECK_W + 2 * BLEND_CHECK_PAD) * 4 * BLEND_CHECK_H)
+
+/*Most TLSF pools of a replayed heap*/
+#define REPLAY_MAX_POOL_CNT 8
+
+/*Live blocks of the heaps benchmark*/
+#define HEAPS_SMALL_CNT 128
+#define HEAPS_BUF_CNT 8
+/*Blocks filling a heap in `draw_bench_heaps_check`, halved down to HEAPS_FILL_MIN (above the thread cache classes)*/
+#define HEAPS_FILL_CNT 64
+#define HEAPS_FILL_MIN 512
+
+/*Grid of the image cache benchmark, like the image scenes of demos/benchmark*/
+#define IMAGE_COLS 4
+#define IMAGE_ROWS 2
+#define IMAGE_SIZE 100
+
+/*Gallery of the asynchronous decoding benchmark and its placeholder*/
+#define GALLERY_COLS 3
+#define GALLERY_W 150
+#define GALLERY_H 100
+#define GALLERY_PAD 8
+#define GALLERY_THUMB_W 15
+#define GALLERY_THUMB_H 10
+
+#if defined(LV_BLEND_X86_SUPPORTED) && LV_BLEND_X86_SUPPORTED
+    #define BLEND_ISA_CNT 3     /*C, SSE2, AVX2*/
+#else
+    #define BLEND_ISA_CNT 1     /*Only the C code*/
+#endif
+
+typedef struct {
+    draw_bench_inv_result_t * res;
+    uint8_t * dirty;        /*One byte per pixel of the display, set if invalidated in the current frame*/
+    int32_t hor_res;
+    int32_t ver_res;
+} inv_ctx_t;
+
+typedef struct {
+    uint8_t * dest;
+    int32_t dest_stride;
+    const uint8_t * src;
+    int32_t src_stride;
+    lv_color_format_t src_cf;
+    const lv_opa_t * mask;
+    int32_t mask_stride;
+    int32_t w;
+    int32_t h;
+    lv_color_t color;
+    lv_opa_t opa;
+} blend_case_t;
+
+typedef struct {
+    draw_bench_allocator_t allocator;
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_tlsf_t tlsf;
+    void * pool_mems[REPLAY_MAX_POOL_CNT];
+    lv_pool_t pools[REPLAY_MAX_POOL_CNT];
+    uint32_t pool_cnt;
+#endif
+    void ** blocks;         /*Block of each allocation id of the trace*/
+    uint32_t * sizes;       /*Requested size of each allocation id*/
+    uint32_t id_cnt;
+} replay_t;
+
+static uint32_t add_tasks(lv_layer_t * layer, uint32_t task_cnt);
+static void dispatch_all(lv_display_t * disp, lv_layer_t * layer);
+static bool inv_measure_start(inv_ctx_t * ctx, draw_bench_inv_result_t * res);
+static void inv_measure_end(inv_ctx_t * ctx);
+static void inv_event_cb(lv_event_t * e);
+static void inv_log_result(const char * name, const draw_bench_inv_result_t * res);
+static void blend_exec(lv_color_format_t cf, draw_bench_blend_op_t op, const blend_case_t * c);
+static const char * blend_cf_name(lv_color_format_t cf);
+static uint32_t blend_set_isa(uint32_t isa);
+static uint8_t rand_opa(void);
+static void text_fill(char * txt, uint32_t len);
+static uint32_t redraw_time(uint32_t time_ms);
+static void shadow_log_result(const char * name, const int32_t widths[], uint32_t width_cnt);
+static void radius_log_result(const char * name, uint32_t radius_cnt);
+static void style_log_result(const char * name, bool cache_en);
+static void timer_cb(lv_timer_t * timer);
+static void anim_exec_cb(void * var, int32_t v);
+static void anim_init(lv_anim_t * a, int32_t * var);
+#if LV_USE_OS
+    static void mem_thread_cb(void * user_data);
+#endif
+#if LV_MEM_THREAD_CACHE
+    static uint32_t mem_cache_hits(void);
+#endif
+static void mem_log_result(const char * name, bool cache_en);
+static bool replay_open(replay_t * r, draw_bench_allocator_t allocator, uint32_t pool_size, uint32_t id_cnt);
+static void replay_close(replay_t * r);
+static void replay_run(replay_t * r, const lv_mem_track_event_t * events, uint32_t event_cnt,
+                       draw_bench_mem_replay_result_t * res);
+static void * replay_alloc(replay_t * r, size_t size);
+static void * replay_realloc(replay_t * r, void * p, size_t size);
+static void replay_free(replay_t * r, void * p);
+static uint32_t replay_frag_pct(replay_t * r);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    static void replay_frag_walker(void * ptr, size_t size, int used, void * user);
+#endif
+static void replay_log_result(const char * name, const draw_bench_mem_replay_result_t * res);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    static void heaps_log_result(const draw_bench_heaps_result_t * res);
+    static uint32_t heaps_expect(bool ok, const char * rule);
+    static uint32_t heaps_fill(lv_mem_heap_t heap, void ** blocks);
+    static void heaps_free(void ** blocks, uint32_t cnt);
+    static void heaps_pattern_set(uint8_t * p, size_t size);
+    static bool heaps_pattern_check(const uint8_t * p, size_t size);
+#endif
+static lv_result_t image_decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                      lv_image_header_t * header);
+static lv_result_t image_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static void image_decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static int32_t image_src_index(const void * src);
+static void image_cache_log_result(const char * name, const draw_bench_image_cache_result_t * res);
+#if LV_USE_LODEPNG
+    static bool gallery_create_pngs(void);
+    static void gallery_free_pngs(void);
+    static int frame_ms_cmp(const void * a, const void * b);
+    static void image_async_log_result(const char * name, const draw_bench_image_async_result_t * res);
+#endif
+
+static const uint32_t task_counts[DRAW_BENCH_TASK_COUNT_CNT] = DRAW_BENCH_TASK_COUNTS;
+static const uint32_t prop_counts[DRAW_BENCH_PROP_COUNT_CNT] = DRAW_BENCH_PROP_COUNTS;
+static const uint32_t timer_counts[DRAW_BENCH_TIMER_COUNT_CNT] = DRAW_BENCH_TIMER_COUNTS;
+static const uint32_t anim_counts[DRAW_BENCH_ANIM_COUNT_CNT] = DRAW_BENCH_ANIM_COUNTS;
+static const uint32_t mem_thread_counts[DRAW_BENCH_MEM_THREAD_COUNT_CNT] = DRAW_BENCH_MEM_THREAD_COUNTS;
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+static const uint32_t replay_pool_sizes[DRAW_BENCH_MEM_REPLAY_POOL_SIZE_CNT] = DRAW_BENCH_MEM_REPLAY_POOL_SIZES;
+#endif
+#if LV_MEM_BULK
+static const uint32_t heaps_bulk_sizes[DRAW_BENCH_HEAPS_BULK_SIZE_CNT] = DRAW_BENCH_HEAPS_BULK_SIZES;
+#endif
+static const uint32_t image_cache_budgets[DRAW_BENCH_IMAGE_CACHE_BUDGET_CNT] = DRAW_BENCH_IMAGE_CACHE_BUDGETS;
+
+/*Sources of the image cache benchmark, only their header is used: the decoder of the benchmark draws them.
+ *The image decoders ignore the sources without data.*/
+static lv_image_dsc_t image_srcs[DRAW_BENCH_IMAGE_CACHE_SRC_CNT];
+static const uint8_t image_src_data[1];
+static uint32_t image_decode_ms;
+
+#if LV_USE_LODEPNG
+static lv_image_dsc_t gallery_pngs[GALLERY_COLS * DRAW_BENCH_IMAGE_ASYNC_ROWS];
+static uint32_t gallery_thumb_buf[GALLERY_THUMB_W * GALLERY_THUMB_H];
+static lv_image_dsc_t gallery_thumb;
+#endif
+
+static const lv_anim_path_cb_t anim_paths[] = {
+    lv_anim_path_linear,
+    lv_anim_path_ease_in,
+    lv_anim_path_ease_out,
+    lv_anim_path_ease_in_out,
+    lv_anim_path_overshoot,
+    lv_anim_path_custom_bezier3,
+};
+
+static uint32_t anim_execs;
+
+static const lv_color_format_t blend_formats[] = {
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+    LV_COLOR_FORMAT_ARGB8888,
+#endif
+#if LV_DRAW_SW_SUPPORT_XRGB8888
+    LV_COLOR_FORMAT_XRGB8888,
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB888
+    LV_COLOR_FORMAT_RGB888,
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565
+    LV_COLOR_FORMAT_RGB565,
+#endif
+};
+
+static const char * const blend_op_names[DRAW_BENCH_BLEND_OP_CNT] = {
+    "fill", "fill opa", "fill mask", "fill mask opa", "image", "image opa", "image mask", "image mask opa"
+};
+
+static const char * const blend_isa_names[] = {"C", "SSE2", "AVX2"};
+
+void draw_bench_dispatch(uint32_t task_cnt, draw_bench_result_t * res)
+{
+    lv_display_t * disp = lv_display_get_default();
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+
+    lv_memzero(res, sizeof(*res));
+    res->task_cnt = task_cnt;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(hor_res, ver_res, cf, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) {
+        LV_LOG_WARN("couldn't allocate the layer buffer");
+        return;
+    }
+
+    /*Same seed in every run so the task lists are comparable*/
+    lv_rand_set_seed(0x1234);
+
+    uint64_t add_ms = 0;
+    uint64_t dispatch_ms = 0;
+    while(add_ms + dispatch_ms < DRAW_BENCH_MIN_TIME) {
+        /*The layer is not in the display's list so `lv_draw_dispatch` doesn't consume its tasks while adding*/
+        lv_layer_t layer;
+        lv_memzero(&layer, sizeof(layer));
+        layer.draw_buf = draw_buf;
+        layer.color_format = cf;
+        lv_area_set(&layer.buf_area, 0, 0, hor_res - 1, ver_res - 1);
+        layer._clip_area = layer.buf_area;
+        layer.phy_clip_area = layer.buf_area;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+        lv_matrix_identity(&layer.matrix);
+#endif
+
+        /*The first round may grow the pool, the next ones should reuse its blocks*/
+        if(res->rounds == 1) lv_draw_reset_pool_stats();
+
+        add_ms += add_tasks(&layer, task_cnt);
+
+        uint32_t start = lv_tick_get();
+        dispatch_all(disp, &layer);
+        dispatch_ms += lv_tick_elaps(start);
+
+        res->rounds++;
+    }
+
+    lv_draw_pool_stats_t pool_stats;
+    lv_draw_get_pool_stats(&pool_stats);
+    res->heap_allocs = res->rounds > 1 ? pool_stats.heap_alloc_cnt : 0;
+
+    uint64_t task_total = (uint64_t)task_cnt * res->rounds;
+    res->add_ns = (uint32_t)(add_ms * 1000000 / task_total);
+    res->dispatch_ns = (uint32_t)(dispatch_ms * 1000000 / task_total);
+
+    lv_draw_buf_destroy(draw_buf);
+}
+
+void draw_bench_dispatch_log(void)
+{
+    LV_LOG_USER("Draw task dispatch, %u draw unit(s):", (unsigned)lv_draw_get_unit_count());
+    LV_LOG_USER("  tasks  rounds  add ns/task  dispatch ns/task  heap allocs");
+
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_TASK_COUNT_CNT; i++) {
+        draw_bench_result_t res;
+        draw_bench_dispatch(task_counts[i], &res);
+        LV_LOG_USER("  %5u  %6u  %11u  %16u  %11u", (unsigned)res.task_cnt, (unsigned)res.rounds,
+                    (unsigned)res.add_ns, (unsigned)res.dispatch_ns, (unsigned)res.heap_allocs);
+    }
+}
+
+void draw_bench_inv_scroll(uint32_t frames, draw_bench_inv_result_t * res)
+{
+    inv_ctx_t ctx;
+    if(!inv_measure_start(&ctx, res)) return;
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, ctx.hor_res / 2, ctx.ver_res);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_width(btn, lv_pct(100));
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %u", (unsigned)i);
+    }
+
+    lv_obj_t * counter = lv_label_create(lv_screen_active());
+    lv_obj_align(counter, LV_ALIGN_TOP_RIGHT, -10, 10);
+    lv_obj_t * bar = lv_bar_create(lv_screen_active());
+    lv_obj_set_width(bar, ctx.hor_res / 3);
+    lv_obj_align(bar, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+
+    lv_refr_now(NULL);
+    lv_memzero(res, sizeof(*res));
+
+    for(i = 0; i < frames; i++) {
+        lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+        lv_label_set_text_fmt(counter, "%u", (unsigned)i);
+        lv_bar_set_value(bar, i % 100, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+
+    lv_obj_delete(cont);
+    lv_obj_delete(counter);
+    lv_obj_delete(bar);
+    inv_measure_end(&ctx);
+}
+
+void draw_bench_inv_labels(uint32_t frames, draw_bench_inv_result_t * res)
+{
+    inv_ctx_t ctx;
+    if(!inv_measure_start(&ctx, res)) return;
+
+    lv_obj_t * labels[LABEL_COLS * LABEL_ROWS];
+    uint32_t i;
+    for(i = 0; i < LABEL_COLS * LABEL_ROWS; i++) {
+        labels[i] = lv_label_create(lv_screen_active());
+        lv_obj_set_pos(labels[i], (i % LABEL_COLS) * ctx.hor_res / LABEL_COLS, (i / LABEL_COLS) * ctx.ver_res / LABEL_ROWS);
+        lv_label_set_text(labels[i], "0");
+    }
+
+    lv_refr_now(NULL);
+    lv_memzero(res, sizeof(*res));
+
+    /*Same seed in every run so the results are comparable*/
+    lv_rand_set_seed(0x1234);
+    for(i = 0; i < frames; i++) {
+        /*Change about the two thirds of the labels*/
+        uint32_t j;
+        for(j = 0; j < LABEL_COLS * LABEL_ROWS; j++) {
+            if(lv_rand(0, 2)) lv_label_set_text_fmt(labels[j], "%u", (unsigned)lv_rand(0, 1000));
+        }
+        lv_refr_now(NULL);
+    }
+
+    for(i = 0; i < LABEL_COLS * LABEL_ROWS; i++) {
+        lv_obj_delete(labels[i]);
+    }
+    inv_measure_end(&ctx);
+}
+
+void draw_bench_inv_log(void)
+{
+    draw_bench_inv_result_t res;
+
+    LV_LOG_USER("Invalidated vs rendered pixels, LV_INV_BUF_SIZE %d, LV_INV_AREA_COST %d:",
+                LV_INV_BUF_SIZE, LV_INV_AREA_COST);
+    LV_LOG_USER("  workload  frames  areas/frame  dirty px/frame  rendered px/frame  overdraw");
+
+    draw_bench_inv_scroll(DRAW_BENCH_INV_FRAMES, &res);
+    inv_log_result("scroll", &res);
+
+    draw_bench_inv_labels(DRAW_BENCH_INV_FRAMES, &res);
+    inv_log_result("labels", &res);
+}
+
+uint32_t draw_bench_blend_check(uint32_t case_cnt)
+{
+    uint32_t mismatch_cnt = 0;
+#if BLEND_ISA_CNT > 1
+    uint8_t * ori = lv_malloc(BLEND_CHECK_BUF_SIZE);
+    uint8_t * ref = lv_malloc(BLEND_CHECK_BUF_SIZE);
+    uint8_t * test = lv_malloc(BLEND_CHECK_BUF_SIZE);
+    uint8_t * src = lv_malloc(BLEND_CHECK_BUF_SIZE);
+    lv_opa_t * mask = lv_malloc(BLEND_CHECK_BUF_SIZE);
+    if(ori == NULL || ref == NULL || test == NULL || src == NULL || mask == NULL) {
+        LV_LOG_WARN("couldn't allocate the buffers");
+        case_cnt = 0;
+    }
+
+    uint32_t isa_ori = lv_blend_x86_get_isa();
+    uint32_t i;
+    for(i = 0; i < case_cnt; i++) {
+        lv_color_format_t cf = blend_formats[lv_rand(0, sizeof(blend_formats) / sizeof(blend_formats[0]) - 1)];
+        draw_bench_blend_op_t op = lv_rand(0, DRAW_BENCH_BLEND_OP_CNT - 1);
+        uint32_t px_size = lv_color_format_get_size(cf);
+        /*Every image format, also the ones blended by the C code to show that the kernels leave them to it*/
+        lv_color_format_t src_cf = blend_formats[lv_rand(0, sizeof(blend_formats) / sizeof(blend_formats[0]) - 1)];
+        uint32_t src_px_size = lv_color_format_get_size(src_cf);
+
+        blend_case_t c;
+        c.w = lv_rand(1, BLEND_CHECK_W);
+        c.h = lv_rand(1, BLEND_CHECK_H);
+        c.dest_stride = (c.w + lv_rand(0, BLEND_CHECK_PAD)) * px_size;
+        c.src_stride = (c.w + lv_rand(0, BLEND_CHECK_PAD)) * src_px_size;
+        c.src_cf = src_cf;
+        c.mask_stride = c.w + lv_rand(0, BLEND_CHECK_PAD);
+        /*Start at any pixel (not only at vector boundaries)*/
+        int32_t dest_ofs = lv_rand(0, BLEND_CHECK_PAD) * px_size;
+        c.src = src + lv_rand(0, BLEND_CHECK_PAD) * src_px_size;
+        c.mask = mask + lv_rand(0, BLEND_CHECK_PAD);
+        c.color = lv_color_make(rand_opa(), rand_opa(), rand_opa());
+        c.opa = (op & 1) ? LV_MIN(rand_opa(), LV_OPA_MAX - 1) : LV_OPA_COVER;
+
+        uint32_t j;
+        for(j = 0; j < BLEND_CHECK_BUF_SIZE; j++) {
+            ori[j] = rand_opa();
+            src[j] = rand_opa();
+            mask[j] = rand_opa();
+        }
+
+        lv_memcpy(ref, ori, BLEND_CHECK_BUF_SIZE);
+        c.dest = ref + dest_ofs;
+        blend_set_isa(0);
+        blend_exec(cf, op, &c);
+
+        uint32_t isa;
+        for(isa = 1; isa < BLEND_ISA_CNT; isa++) {
+            if(blend_set_isa(isa) != isa) break;
+
+            lv_memcpy(test, ori, BLEND_CHECK_BUF_SIZE);
+            c.dest = test + dest_ofs;
+            blend_exec(cf, op, &c);
+            if(lv_memcmp(ref, test, BLEND_CHECK_BUF_SIZE) != 0) {
+                if(mismatch_cnt < 10) {
+                    LV_LOG_USER("%s differs from C: %s, %s%s%s, %dx%d", blend_isa_names[isa], blend_cf_name(cf),
+                                blend_op_names[op], (op & 4) ? " of " : "", (op & 4) ? blend_cf_name(src_cf) : "",
+                                (int)c.w, (int)c.h);
+                }
+                mismatch_cnt++;
+            }
+        }
+    }
+
+    blend_set_isa(isa_ori);
+    lv_free(ori);
+    lv_free(ref);
+    lv_free(test);
+    lv_free(src);
+    lv_free(mask);
+#else
+    LV_UNUSED(case_cnt);
+#endif
+    return mismatch_cnt;
+}
+
+uint32_t draw_bench_blend(lv_color_format_t cf, draw_bench_blend_op_t op, lv_color_format_t src_cf, int32_t w,
+                          int32_t h)
+{
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint8_t * dest = lv_malloc(w * h * px_size);
+    uint8_t * src = lv_malloc(w * h * 4);
+    lv_opa_t * mask = lv_malloc(w * h);
+    if(dest == NULL || src == NULL || mask == NULL) {
+        LV_LOG_WARN("couldn't allocate the buffers");
+        lv_free(dest);
+        lv_free(src);
+        lv_free(mask);
+        return 0;
+    }
+
+    /*Opaque screen content, images with partly transparent pixels and anti-aliased masks*/
+    int32_t i;
+    for(i = 0; i < w * h * (int32_t)px_size; i++) dest[i] = lv_rand(0, 255);
+    if(cf == LV_COLOR_FORMAT_ARGB8888) {
+        for(i = 3; i < w * h * 4; i += 4) dest[i] = 0xff;
+    }
+    for(i = 0; i < w * h * 4; i++) src[i] = rand_opa();
+    for(i = 0; i < w * h; i++) mask[i] = rand_opa();
+
+    blend_case_t c;
+    c.dest = dest;
+    c.dest_stride = w * px_size;
+    c.src = src;
+    c.src_stride = w * lv_color_format_get_size(src_cf);
+    c.src_cf = src_cf;
+    c.mask = mask;
+    c.mask_stride = w;
+    c.w = w;
+    c.h = h;
+    c.color = lv_color_hex(0x3080c0);
+    c.opa = (op & 1) ? LV_OPA_50 : LV_OPA_COVER;
+
+    uint32_t rounds = 0;
+    uint32_t t_start = lv_tick_get();
+    uint32_t elapsed;
+    do {
+        blend_exec(cf, op, &c);
+        rounds++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_BLEND_TIME);
+
+    lv_free(dest);
+    lv_free(src);
+    lv_free(mask);
+
+    return (uint32_t)((uint64_t)w * h * rounds / (elapsed * 1000));
+}
+
+void draw_bench_blend_log(void)
+{
+    uint32_t mismatch_cnt = draw_bench_blend_check(DRAW_BENCH_BLEND_CHECK_CNT);
+    LV_LOG_USER("Blend kernels: %d random cases compared with C, %d mismatches%s", DRAW_BENCH_BLEND_CHECK_CNT,
+                (int)mismatch_cnt, BLEND_ISA_CNT > 1 ? "" : " (no SIMD kernels enabled)");
+
+    lv_display_t * disp = lv_display_get_default();
+    int32_t w = lv_display_get_horizontal_resolution(disp);
+    int32_t h = lv_display_get_vertical_resolution(disp);
+    /*The best available kernels are the default*/
+    uint32_t isa_max = blend_set_isa(BLEND_ISA_CNT);
+
+    char cols[BLEND_ISA_CNT * 8 + 1];
+    uint32_t isa;
+    uint32_t len = 0;
+    for(isa = 0; isa <= isa_max; isa++) {
+        len += lv_snprintf(cols + len, sizeof(cols) - len, "%8s", blend_isa_names[isa]);
+    }
+    LV_LOG_USER("Blend throughput on %dx%d in Mpx/s:", (int)w, (int)h);
+    LV_LOG_USER("  format    operation       image     %s", cols);
+
+    uint32_t f;
+    for(f = 0; f < sizeof(blend_formats) / sizeof(blend_formats[0]); f++) {
+        uint32_t op;
+        for(op = 0; op < DRAW_BENCH_BLEND_OP_CNT; op++) {
+            /*The fills are measured once, the image operations for every image format*/
+            uint32_t src_f;
+            uint32_t src_f_cnt = (op & 4) ? sizeof(blend_formats) / sizeof(blend_formats[0]) : 1;
+            for(src_f = 0; src_f < src_f_cnt; src_f++) {
+                len = 0;
+                for(isa = 0; isa <= isa_max; isa++) {
+                    blend_set_isa(isa);
+                    uint32_t mpx = draw_bench_blend(blend_formats[f], op, blend_formats[src_f], w, h);
+                    len += lv_snprintf(cols + len, sizeof(cols) - len, "%8d", (int)mpx);
+                }
+                LV_LOG_USER("  %-10s%-16s%-10s%s", blend_cf_name(blend_formats[f]), blend_op_names[op],
+                            (op & 4) ? blend_cf_name(blend_formats[src_f]) : "-", cols);
+            }
+        }
+    }
+
+    blend_set_isa(isa_max);
+}
+
+void draw_bench_glyph_cache_log(void)
+{
+    lv_font_fmt_txt_glyph_cache_stats_t stats;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    if(stats.max_size == 0) {
+        LV_LOG_USER("Glyph cache: disabled");
+        return;
+    }
+
+    uint32_t lookups = stats.hits + stats.misses;
+    LV_LOG_USER("Glyph cache: %u hits, %u misses (%u%% hit rate), %u / %u bytes used",
+                (unsigned)stats.hits, (unsigned)stats.misses, lookups ? (unsigned)((uint64_t)stats.hits * 100 / lookups) : 0,
+                (unsigned)stats.size, (unsigned)stats.max_size);
+}
+
+void draw_bench_gradient_cache_log(void)
+{
+    lv_draw_sw_gradient_cache_stats_t stats;
+    lv_draw_sw_gradient_cache_get_stats(&stats);
+    if(stats.max_size == 0) {
+        LV_LOG_USER("Gradient cache: disabled");
+        return;
+    }
+
+    uint32_t lookups = stats.hits + stats.misses;
+    LV_LOG_USER("Gradient cache: %u hits, %u misses (%u%% hit rate), %u / %u bytes used",
+                (unsigned)stats.hits, (unsigned)stats.misses, lookups ? (unsigned)((uint64_t)stats.hits * 100 / lookups) : 0,
+                (unsigned)stats.size, (unsigned)stats.max_size);
+}
+
+uint32_t draw_bench_text_layout(const lv_font_t * font, int32_t max_width)
+{
+    char * txt = lv_malloc(DRAW_BENCH_TEXT_LEN + 1);
+    LV_ASSERT_MALLOC(txt);
+    if(txt == NULL) return 0;
+    text_fill(txt, DRAW_BENCH_TEXT_LEN);
+
+    /*Count the characters, the Latin-1 ones take 2 bytes*/
+    uint32_t char_cnt = lv_text_get_encoded_length(txt);
+
+    /*Once to create the lookup tables of the font*/
+    lv_point_t size;
+    lv_text_get_size(&size, txt, font, 0, 0, max_width, LV_TEXT_FLAG_NONE);
+
+    uint32_t rounds = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        lv_text_get_size(&size, txt, font, 0, 0, max_width, LV_TEXT_FLAG_NONE);
+        rounds++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_TEXT_TIME);
+
+    lv_free(txt);
+
+    return (uint32_t)((uint64_t)elapsed * 1000000 / ((uint64_t)rounds * char_cnt));
+}
+
+void draw_bench_text_layout_log(void)
+{
+    static const struct {
+        const char * name;
+        const lv_font_t * font;
+    } fonts[] = {
+#if LV_FONT_MONTSERRAT_14
+        {"montserrat_14", &lv_font_montserrat_14},
+#endif
+#if LV_FONT_MONTSERRAT_24
+        {"montserrat_24", &lv_font_montserrat_24},
+#endif
+#if LV_FONT_UNSCII_8
+        {"unscii_8", &lv_font_unscii_8},
+#endif
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+        {"dejavu_16_persian_hebrew", &lv_font_dejavu_16_persian_hebrew},
+#endif
+#if LV_FONT_SIMSUN_16_CJK
+        {"simsun_16_cjk", &lv_font_simsun_16_cjk},
+#endif
+        {"default", LV_FONT_DEFAULT},
+    };
+
+    lv_display_t * disp = lv_display_get_default();
+    int32_t max_width = lv_display_get_horizontal_resolution(disp);
+
+    LV_LOG_USER("Text layout of %d bytes wrapped to %d px (lookup tables %s):", DRAW_BENCH_TEXT_LEN, (int)max_width,
+                LV_FONT_FMT_TXT_ACCEL ? "on" : "off");
+    LV_LOG_USER("  font                          ns/char");
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        LV_LOG_USER("  %-28s  %7u", fonts[i].name, (unsigned)draw_bench_text_layout(fonts[i].font, max_width));
+    }
+}
+
+uint32_t draw_bench_shadow_cards(const int32_t widths[], uint32_t width_cnt)
+{
+    lv_display_t * disp = lv_display_get_default();
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    int32_t cell_w = hor_res / CARD_COLS;
+    int32_t cell_h = ver_res / CARD_ROWS;
+
+    lv_obj_t * cards[CARD_COLS * CARD_ROWS];
+    uint32_t i;
+    for(i = 0; i < CARD_COLS * CARD_ROWS; i++) {
+        cards[i] = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(cards[i]);
+        lv_obj_set_size(cards[i], cell_w / 2, cell_h / 2);
+        lv_obj_set_pos(cards[i], (i % CARD_COLS) * cell_w + cell_w / 4, (i / CARD_COLS) * cell_h + cell_h / 4);
+        lv_obj_set_style_bg_opa(cards[i], LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(cards[i], lv_color_white(), 0);
+        lv_obj_set_style_radius(cards[i], 8, 0);
+        lv_obj_set_style_shadow_width(cards[i], widths[i % width_cnt], 0);
+        lv_obj_set_style_shadow_offset_y(cards[i], 4, 0);
+        lv_obj_set_style_shadow_opa(cards[i], LV_OPA_50, 0);
+    }
+
+    uint32_t us = redraw_time(DRAW_BENCH_SHADOW_TIME);
+
+    for(i = 0; i < CARD_COLS * CARD_ROWS; i++) {
+        lv_obj_delete(cards[i]);
+    }
+
+    return us;
+}
+
+void draw_bench_shadow_log(void)
+{
+    static const int32_t single[] = {20};
+    static const int32_t mixed[] = {10, 20, 30, 15};
+
+    LV_LOG_USER("Cards with box shadows, %d x %d per screen:", CARD_COLS, CARD_ROWS);
+    shadow_log_result("one width", single, sizeof(single) / sizeof(single[0]));
+    shadow_log_result("mixed widths", mixed, sizeof(mixed) / sizeof(mixed[0]));
+}
+
+uint32_t draw_bench_radius_buttons(uint32_t radius_cnt)
+{
+    lv_display_t * disp = lv_display_get_default();
+    int32_t cell_w = lv_display_get_horizontal_resolution(disp) / BUTTON_COLS;
+    int32_t cell_h = lv_display_get_vertical_resolution(disp) / BUTTON_ROWS;
+
+    lv_obj_t * buttons[BUTTON_COLS * BUTTON_ROWS];
+    uint32_t i;
+    for(i = 0; i < BUTTON_COLS * BUTTON_ROWS; i++) {
+        buttons[i] = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(buttons[i]);
+        lv_obj_set_size(buttons[i], cell_w - 4, cell_h - 4);
+        lv_obj_set_pos(buttons[i], (i % BUTTON_COLS) * cell_w + 2, (i / BUTTON_COLS) * cell_h + 2);
+        lv_obj_set_style_bg_opa(buttons[i], LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(buttons[i], lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_border_width(buttons[i], 2, 0);
+        lv_obj_set_style_border_color(buttons[i], lv_palette_darken(LV_PALETTE_BLUE, 3), 0);
+        lv_obj_set_style_radius(buttons[i], 4 + (i % radius_cnt), 0);
+    }
+
+    uint32_t us = redraw_time(DRAW_BENCH_RADIUS_TIME);
+
+    for(i = 0; i < BUTTON_COLS * BUTTON_ROWS; i++) {
+        lv_obj_delete(buttons[i]);
+    }
+
+    return us;
+}
+
+void draw_bench_radius_log(void)
+{
+    LV_LOG_USER("Rounded buttons, %d x %d per screen, %d draw unit(s):", BUTTON_COLS, BUTTON_ROWS,
+                LV_DRAW_SW_DRAW_UNIT_CNT);
+    radius_log_result("one radius", 1);
+    radius_log_result("12 radii", 12);
+}
+
+void draw_bench_style_buttons(bool cache_en, draw_bench_style_result_t * res)
+{
+    lv_display_t * disp = lv_display_get_default();
+    int32_t cell_w = lv_display_get_horizontal_resolution(disp) / STYLE_COLS;
+    int32_t cell_h = lv_display_get_vertical_resolution(disp) / STYLE_ROWS;
+
+    lv_memzero(res, sizeof(*res));
+    lv_obj_style_enable_resolved_cache(cache_en);
+
+    /*Shared styles on top of the theme, for some states only, like in a real UI*/
+    static lv_style_t style_base;
+    static lv_style_t style_checked;
+    static lv_style_t style_focused;
+    lv_style_init(&style_base);
+    lv_style_set_radius(&style_base, 6);
+    lv_style_set_border_width(&style_base, 2);
+    lv_style_set_border_color(&style_base, lv_palette_darken(LV_PALETTE_GREY, 2));
+    lv_style_set_text_letter_space(&style_base, 1);
+    lv_style_init(&style_checked);
+    lv_style_set_bg_color(&style_checked, lv_palette_main(LV_PALETTE_ORANGE));
+    lv_style_set_text_color(&style_checked, lv_color_black());
+    lv_style_init(&style_focused);
+    lv_style_set_outline_width(&style_focused, 2);
+    lv_style_set_outline_color(&style_focused, lv_palette_main(LV_PALETTE_RED));
+
+    lv_obj_t * buttons[STYLE_COLS * STYLE_ROWS];
+    uint32_t i;
+    for(i = 0; i < STYLE_COLS * STYLE_ROWS; i++) {
+        buttons[i] = lv_button_create(lv_screen_active());
+        lv_obj_add_style(buttons[i], &style_base, 0);
+        lv_obj_add_style(buttons[i], &style_checked, LV_STATE_CHECKED);
+        lv_obj_add_style(buttons[i], &style_focused, LV_STATE_FOCUSED);
+        lv_obj_set_size(buttons[i], cell_w - 8, cell_h - 8);
+        lv_obj_set_pos(buttons[i], (i % STYLE_COLS) * cell_w + 4, (i / STYLE_COLS) * cell_h + 4);
+        if(i % 3 == 0) lv_obj_add_state(buttons[i], LV_STATE_CHECKED);
+        if(i % 5 == 0) lv_obj_add_state(buttons[i], LV_STATE_FOCUSED);
+
+        lv_obj_t * label = lv_label_create(buttons[i]);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+        lv_obj_center(label);
+    }
+
+    lv_obj_style_reset_resolved_stats();
+    res->frame_us = redraw_time(DRAW_BENCH_STYLE_TIME);
+
+    /*What the draw events of the buttons and the labels read*/
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_label_dsc_t label_dsc;
+    uint32_t cnt = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        for(i = 0; i < STYLE_COLS * STYLE_ROWS; i++) {
+            lv_draw_rect_dsc_init(&rect_dsc);
+            lv_obj_init_draw_rect_dsc(buttons[i], LV_PART_MAIN, &rect_dsc);
+            lv_draw_label_dsc_init(&label_dsc);
+            lv_obj_init_draw_label_dsc(lv_obj_get_child(buttons[i], 0), LV_PART_MAIN, &label_dsc);
+        }
+        cnt += STYLE_COLS * STYLE_ROWS;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_STYLE_TIME);
+    res->dsc_ns = (uint32_t)((uint64_t)elapsed * 1000000 / cnt);
+
+    lv_obj_style_resolved_stats_t stats;
+    lv_obj_style_get_resolved_stats(&stats);
+    res->hits = stats.hits;
+    res->misses = stats.misses;
+
+    /*A state change drops the cached values of that button and its label only*/
+    lv_obj_style_reset_resolved_stats();
+    uint32_t frames = 0;
+    t_start = lv_tick_get();
+    do {
+        lv_obj_t * btn = buttons[frames % (STYLE_COLS * STYLE_ROWS)];
+        if(lv_obj_has_state(btn, LV_STATE_CHECKED)) lv_obj_remove_state(btn, LV_STATE_CHECKED);
+        else lv_obj_add_state(btn, LV_STATE_CHECKED);
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        frames++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_STYLE_TIME);
+    res->toggle_frame_us = (uint32_t)((uint64_t)elapsed * 1000 / frames);
+
+    lv_obj_style_get_resolved_stats(&stats);
+    res->toggle_hits = stats.hits;
+    res->toggle_misses = stats.misses;
+
+    for(i = 0; i < STYLE_COLS * STYLE_ROWS; i++) {
+        lv_obj_delete(buttons[i]);
+    }
+
+    lv_style_reset(&style_base);
+    lv_style_reset(&style_checked);
+    lv_style_reset(&style_focused);
+    lv_obj_style_enable_resolved_cache(true);
+}
+
+void draw_bench_style_log(void)
+{
+    LV_LOG_USER("Themed buttons with labels, %d x %d per screen, %d values cached per object:", STYLE_COLS, STYLE_ROWS,
+                LV_OBJ_STYLE_RESOLVED_CACHE);
+    style_log_result("no cache", false);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    style_log_result("cache", true);
+#endif
+}
+
+uint32_t draw_bench_style_props(uint32_t prop_cnt, bool const_style)
+{
+    /*Same seed in every run so the styles and the lookups are comparable*/
+    lv_rand_set_seed(0x1234);
+
+    /*Take the first props of a shuffled list so that the IDs are spread like in real styles*/
+    lv_style_prop_t ids[LV_STYLE_LAST_BUILT_IN_PROP];
+    uint32_t i;
+    for(i = 0; i < LV_STYLE_LAST_BUILT_IN_PROP; i++) ids[i] = (lv_style_prop_t)(i + 1);
+    for(i = LV_STYLE_LAST_BUILT_IN_PROP - 1; i > 0; i--) {
+        uint32_t j = lv_rand(0, i);
+        lv_style_prop_t tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+    }
+
+    if(prop_cnt > LV_STYLE_LAST_BUILT_IN_PROP) prop_cnt = LV_STYLE_LAST_BUILT_IN_PROP;
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_const_prop_t * const_props = NULL;
+    if(const_style) {
+        const_props = lv_malloc((prop_cnt + 1) * sizeof(lv_style_const_prop_t));
+        if(const_props == NULL) {
+            LV_LOG_WARN("couldn't allocate the constant props");
+            return 0;
+        }
+        for(i = 0; i < prop_cnt; i++) {
+            const_props[i].prop = ids[i];
+            const_props[i].value.num = i;
+        }
+        const_props[prop_cnt].prop = LV_STYLE_PROP_INV;
+        /*What LV_STYLE_CONST_INIT sets*/
+        style.values_and_props = const_props;
+        style.has_group = 0xFFFFFFFF;
+        style.prop_cnt = 255;
+    }
+    else {
+        for(i = 0; i < prop_cnt; i++) {
+            lv_style_value_t v = { .num = i };
+            lv_style_set_prop(&style, ids[i], v);
+        }
+    }
+
+    lv_style_prop_t queries[256];
+    for(i = 0; i < 256; i++) queries[i] = (lv_style_prop_t)lv_rand(1, LV_STYLE_LAST_BUILT_IN_PROP);
+
+    uint32_t cnt = 0;
+    volatile uint32_t found = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        for(i = 0; i < 256; i++) {
+            lv_style_value_t v;
+            if(lv_style_get_prop_inlined(&style, queries[i], &v) == LV_STYLE_RES_FOUND) found++;
+        }
+        cnt += 256;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_PROPS_TIME);
+
+    if(const_style) lv_free(const_props);
+    else lv_style_reset(&style);
+
+    return cnt / elapsed;
+}
+
+void draw_bench_style_props_log(void)
+{
+    LV_LOG_USER("Style property lookups per ms, random built-in IDs, index from %d props:", LV_STYLE_PROP_INDEX_MIN);
+    LV_LOG_USER("  props     style  const style");
+
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_PROP_COUNT_CNT; i++) {
+        uint32_t normal = draw_bench_style_props(prop_counts[i], false);
+        uint32_t constant = draw_bench_style_props(prop_counts[i], true);
+        LV_LOG_USER("  %5u  %8u  %11u", (unsigned)prop_counts[i], (unsigned)normal, (unsigned)constant);
+    }
+}
+
+void draw_bench_timer(uint32_t timer_cnt, draw_bench_timer_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+    res->timer_cnt = timer_cnt;
+
+    lv_timer_t ** timers = lv_malloc(timer_cnt * sizeof(lv_timer_t *));
+    if(timers == NULL) {
+        LV_LOG_WARN("couldn't allocate the timer list");
+        return;
+    }
+
+    /*Only the timers of the benchmark should do real work*/
+    lv_timer_t * refr_timer = lv_display_get_refr_timer(lv_display_get_default());
+    if(refr_timer) lv_timer_pause(refr_timer);
+
+    /*Same seed in every run so the periods are comparable*/
+    lv_rand_set_seed(0x1234);
+
+    uint32_t runs = 0;
+    uint32_t i;
+    for(i = 0; i < timer_cnt; i++) {
+        timers[i] = lv_timer_create(timer_cb, lv_rand(5, 500), &runs);
+    }
+
+    uint32_t calls = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        lv_timer_handler();
+        calls++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_TIMER_TIME);
+    res->handler_ns = (uint32_t)((uint64_t)elapsed * 1000000 / calls);
+    res->runs = runs;
+
+    uint32_t cnt = 0;
+    t_start = lv_tick_get();
+    do {
+        for(i = 0; i < 100; i++) {
+            lv_timer_delete(lv_timer_create(timer_cb, 100, &runs));
+        }
+        cnt += 100;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_TIMER_TIME);
+    res->create_delete_ns = (uint32_t)((uint64_t)elapsed * 1000000 / cnt);
+
+    for(i = 0; i < timer_cnt; i++) {
+        if(timers[i]) lv_timer_delete(timers[i]);
+    }
+    lv_free(timers);
+
+    if(refr_timer) lv_timer_resume(refr_timer);
+}
+
+void draw_bench_timer_log(void)
+{
+    LV_LOG_USER("Timer handler with random periods (5..500 ms):");
+    LV_LOG_USER("  timers  ns/handler call  callbacks/s  ns/create+delete");
+
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_TIMER_COUNT_CNT; i++) {
+        draw_bench_timer_result_t res;
+        draw_bench_timer(timer_counts[i], &res);
+        LV_LOG_USER("  %6u  %15u  %11u  %16u", (unsigned)res.timer_cnt, (unsigned)res.handler_ns,
+                    (unsigned)(res.runs * 1000 / DRAW_BENCH_TIMER_TIME), (unsigned)res.create_delete_ns);
+    }
+}
+
+void draw_bench_anim(uint32_t anim_cnt, draw_bench_anim_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+    res->anim_cnt = anim_cnt;
+
+    int32_t * vars = lv_malloc_zeroed(anim_cnt * sizeof(int32_t));
+    if(vars == NULL) {
+        LV_LOG_WARN("couldn't allocate the animated variables");
+        return;
+    }
+
+    /*Same seed in every run so the paths and durations are comparable*/
+    lv_rand_set_seed(0x1234);
+
+    uint32_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        lv_anim_t a;
+        anim_init(&a, &vars[i]);
+        lv_anim_start(&a);
+    }
+
+    anim_execs = 0;
+    uint32_t calls = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        lv_anim_refr_now();
+        calls++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_ANIM_TIME);
+    res->refr_ns = (uint32_t)((uint64_t)elapsed * 1000000 / calls);
+    res->execs = anim_execs;
+
+    /*The new animation replaces the running one of the same variable*/
+    uint32_t cnt = 0;
+    t_start = lv_tick_get();
+    do {
+        for(i = 0; i < 100; i++) {
+            lv_anim_t a;
+            anim_init(&a, &vars[lv_rand(0, anim_cnt - 1)]);
+            lv_anim_start(&a);
+        }
+        cnt += 100;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_ANIM_TIME);
+    res->restart_ns = (uint32_t)((uint64_t)elapsed * 1000000 / cnt);
+
+    for(i = 0; i < anim_cnt; i++) {
+        lv_anim_delete(&vars[i], anim_exec_cb);
+    }
+    lv_free(vars);
+}
+
+void draw_bench_anim_log(void)
+{
+    LV_LOG_USER("Animations with built-in paths and random durations (200..2000 ms):");
+    LV_LOG_USER("  anims  ns/refresh  values/s  ns/restart");
+
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_ANIM_COUNT_CNT; i++) {
+        draw_bench_anim_result_t res;
+        draw_bench_anim(anim_counts[i], &res);
+        LV_LOG_USER("  %5u  %10u  %8u  %10u", (unsigned)res.anim_cnt, (unsigned)res.refr_ns,
+                    (unsigned)(res.execs * 1000 / DRAW_BENCH_ANIM_TIME), (unsigned)res.restart_ns);
+    }
+}
+
+void draw_bench_mem(uint32_t thread_cnt, bool cache_en, draw_bench_mem_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+    res->thread_cnt = thread_cnt;
+
+#if LV_USE_OS
+    lv_thread_t * threads = lv_malloc_zeroed(thread_cnt * sizeof(lv_thread_t));
+    uint32_t * small_cnts = lv_malloc_zeroed(thread_cnt * sizeof(uint32_t));
+    if(threads == NULL || small_cnts == NULL) {
+        LV_LOG_WARN("couldn't allocate the threads");
+        lv_free(threads);
+        lv_free(small_cnts);
+        return;
+    }
+
+#if LV_MEM_THREAD_CACHE
+    lv_mem_enable_thread_cache(cache_en);
+    uint32_t hits_start = mem_cache_hits();
+#else
+    LV_UNUSED(cache_en);
+#endif
+
+    /*The threads only allocate and free, the caches are given back when they exit*/
+    uint32_t t_start = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < thread_cnt; i++) {
+        small_cnts[i] = i + 1;  /*Seed of the thread, the number of small allocations when done*/
+        lv_thread_init(&threads[i], LV_THREAD_PRIO_MID, mem_thread_cb, 32 * 1024, &small_cnts[i]);
+    }
+    uint64_t small_cnt = 0;
+    for(i = 0; i < thread_cnt; i++) {
+        lv_thread_delete(&threads[i]);
+        small_cnt += small_cnts[i];
+    }
+    uint32_t elapsed = lv_tick_elaps(t_start);
+    res->op_ns = (uint32_t)((uint64_t)elapsed * 1000000 / ((uint64_t)DRAW_BENCH_MEM_OPS * thread_cnt));
+
+#if LV_MEM_THREAD_CACHE
+    if(small_cnt) res->hit_pct = (uint32_t)((uint64_t)(mem_cache_hits() - hits_start) * 100 / small_cnt);
+    lv_mem_enable_thread_cache(true);
+#endif
+
+    lv_free(threads);
+    lv_free(small_cnts);
+#else
+    LV_UNUSED(cache_en);
+    LV_LOG_WARN("needs LV_USE_OS");
+#endif
+}
+
+void draw_bench_mem_log(void)
+{
+    LV_LOG_USER("lv_malloc/lv_free from several threads (32 live blocks per thread):");
+    mem_log_result("locked", false);
+#if LV_MEM_THREAD_CACHE
+    mem_log_result("cached", true);
+#else
+    LV_LOG_USER("  the thread caches need the builtin heap, LV_OS_PTHREAD and LV_MEM_THREAD_CACHE_SIZE > 0");
+#endif
+}
+
+lv_result_t draw_bench_mem_replay(const lv_mem_track_event_t * events, uint32_t event_cnt,
+                                  draw_bench_allocator_t allocator, uint32_t pool_size,
+                                  draw_bench_mem_replay_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+    res->pool_size = allocator == DRAW_BENCH_ALLOCATOR_TLSF ? pool_size : 0;
+    res->first_fail = UINT32_MAX;
+
+    uint32_t id_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        if(events[i].id >= id_cnt) id_cnt = events[i].id + 1;
+    }
+
+    /*Replay once to get the statistics, then again without measuring the fragmentation to get the time*/
+    replay_t r;
+    if(!replay_open(&r, allocator, pool_size, id_cnt)) return LV_RESULT_INVALID;
+    replay_run(&r, events, event_cnt, res);
+    replay_close(&r);
+
+    uint32_t rounds = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        if(!replay_open(&r, allocator, pool_size, id_cnt)) return LV_RESULT_INVALID;
+        replay_run(&r, events, event_cnt, NULL);
+        replay_close(&r);
+        rounds++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < DRAW_BENCH_MEM_REPLAY_TIME);
+
+    if(event_cnt) res->op_ns = (uint32_t)((uint64_t)elapsed * 1000000 / ((uint64_t)rounds * event_cnt));
+    return LV_RESULT_OK;
+}
+
+void draw_bench_mem_replay_log(const lv_mem_track_event_t * events, uint32_t event_cnt)
+{
+    LV_LOG_USER("replay of %u allocation events:", (unsigned)event_cnt);
+
+    draw_bench_mem_replay_result_t res;
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_MEM_REPLAY_POOL_SIZE_CNT; i++) {
+        char name[32];
+        lv_snprintf(name, sizeof(name), "TLSF %3u KB", (unsigned)replay_pool_sizes[i]);
+        if(draw_bench_mem_replay(events, event_cnt, DRAW_BENCH_ALLOCATOR_TLSF, replay_pool_sizes[i] * 1024,
+                                 &res) == LV_RESULT_OK) {
+            replay_log_result(name, &res);
+        }
+        else {
+            LV_LOG_USER("  %s: couldn't create the heap", name);
+        }
+    }
+#else
+    LV_LOG_USER("  the TLSF heaps need the builtin heap (LV_STDLIB_BUILTIN)");
+#endif
+
+    if(draw_bench_mem_replay(events, event_cnt, DRAW_BENCH_ALLOCATOR_CLIB, 0, &res) == LV_RESULT_OK) {
+        replay_log_result("C library  ", &res);
+    }
+}
+
+void draw_bench_heaps(draw_bench_heaps_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_heap_monitor_t mon;
+    lv_mem_heap_monitor(LV_MEM_HEAP_FAST, &mon);
+    res->fast_size = mon.total_size;
+    lv_mem_heap_monitor(LV_MEM_HEAP_BULK, &mon);
+    res->bulk_size = mon.total_size;
+
+    const lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    void * smalls[HEAPS_SMALL_CNT] = {NULL};
+    void * bufs[HEAPS_BUF_CNT] = {NULL};
+    uint32_t small_cnt = 0;
+    uint32_t small_fast_cnt = 0;
+    uint32_t buf_cnt = 0;
+    uint32_t buf_bulk_cnt = 0;
+    uint32_t seed = 1;
+
+    lv_mem_heap_reset_stats();
+    uint32_t t_start = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_HEAPS_OPS; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        if((i & 7) == 7) {
+            uint32_t slot = (i >> 3) % HEAPS_BUF_CNT;
+            if(bufs[slot]) handlers->buf_free_cb(bufs[slot]);
+
+            uint32_t side = 32 + (seed >> 8) % 97;
+            bufs[slot] = handlers->buf_malloc_cb(side * side * 4, LV_COLOR_FORMAT_ARGB8888);
+            if(bufs[slot] == NULL) res->buf_fails++;
+            else if(lv_mem_get_heap(bufs[slot]) == LV_MEM_HEAP_BULK) buf_bulk_cnt++;
+            buf_cnt++;
+        }
+        else {
+            uint32_t slot = i % HEAPS_SMALL_CNT;
+            lv_free(smalls[slot]);
+
+            smalls[slot] = lv_malloc(16 + (seed >> 8) % 241);
+            if(smalls[slot] == NULL) res->small_fails++;
+            else if(lv_mem_get_heap(smalls[slot]) == LV_MEM_HEAP_FAST) small_fast_cnt++;
+            small_cnt++;
+        }
+    }
+    uint32_t elapsed = lv_tick_elaps(t_start);
+    res->op_ns = (uint32_t)((uint64_t)elapsed * 1000000 / DRAW_BENCH_HEAPS_OPS);
+
+    for(i = 0; i < HEAPS_SMALL_CNT; i++) lv_free(smalls[i]);
+    for(i = 0; i < HEAPS_BUF_CNT; i++) {
+        if(bufs[i]) handlers->buf_free_cb(bufs[i]);
+    }
+
+    res->small_fast_pct = small_fast_cnt * 100 / small_cnt;
+    res->buf_bulk_pct = buf_bulk_cnt * 100 / buf_cnt;
+    lv_mem_heap_monitor(LV_MEM_HEAP_FAST, &mon);
+    res->fast_peak = mon.max_used;
+    lv_mem_heap_monitor(LV_MEM_HEAP_BULK, &mon);
+    res->bulk_peak = mon.max_used;
+#else
+    LV_LOG_WARN("needs the builtin heap (LV_STDLIB_BUILTIN)");
+#endif
+}
+
+uint32_t draw_bench_heaps_check(void)
+{
+    uint32_t violated = 0;
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    const lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    void * blocks[HEAPS_FILL_CNT];
+    uint32_t block_cnt;
+    lv_mem_heap_monitor_t fast_mon;
+    lv_mem_heap_monitor_t bulk_mon;
+    lv_mem_heap_monitor(LV_MEM_HEAP_FAST, &fast_mon);
+    lv_mem_heap_monitor(LV_MEM_HEAP_BULK, &bulk_mon);
+    bool bulk_en = bulk_mon.total_size > 0;
+    lv_mem_heap_t buf_heap = bulk_en ? LV_MEM_HEAP_BULK : LV_MEM_HEAP_FAST;
+    uint32_t i;
+
+    /*Both heaps have room: each allocation is placed in its own heap*/
+    bool small_fast = true;
+    for(i = 0; i < HEAPS_FILL_CNT; i++) {
+        blocks[i] = lv_malloc(16 + i * 4);
+        if(blocks[i] == NULL || lv_mem_get_heap(blocks[i]) != LV_MEM_HEAP_FAST) small_fast = false;
+    }
+    heaps_free(blocks, HEAPS_FILL_CNT);
+    violated += heaps_expect(small_fast, "small blocks in the fast heap");
+
+    bool buf_placed = true;
+    for(i = 0; i < 4; i++) {
+        blocks[i] = handlers->buf_malloc_cb(32 * 32 * 4, LV_COLOR_FORMAT_ARGB8888);
+        if(blocks[i] == NULL || lv_mem_get_heap(blocks[i]) != buf_heap) buf_placed = false;
+    }
+    for(i = 0; i < 4; i++) handlers->buf_free_cb(blocks[i]);
+    violated += heaps_expect(buf_placed, bulk_en ? "draw buffers in the bulk heap" :
+                             "draw buffers in the fast heap without bulk heap");
+
+    if(!bulk_en) return violated;
+
+    /*Fast heap full: the small blocks go to the bulk heap, a growing block is moved there with its data*/
+    uint8_t * moved = lv_malloc(HEAPS_FILL_MIN);
+    if(moved) heaps_pattern_set(moved, HEAPS_FILL_MIN);
+    block_cnt = heaps_fill(LV_MEM_HEAP_FAST, blocks);
+
+    void * fallback = lv_malloc(HEAPS_FILL_MIN * 2);
+    violated += heaps_expect(fallback && lv_mem_get_heap(fallback) == LV_MEM_HEAP_BULK,
+                             "small blocks in the bulk heap when the fast heap is full");
+    lv_free(fallback);
+
+    if(moved) {
+        uint8_t * grown = lv_realloc(moved, HEAPS_FILL_MIN * 16);
+        if(grown) moved = grown;
+        violated += heaps_expect(grown && lv_mem_get_heap(grown) == LV_MEM_HEAP_BULK &&
+                                 heaps_pattern_check(grown, HEAPS_FILL_MIN),
+                                 "realloc moves a fast block to the bulk heap with its data");
+    }
+    lv_free(moved);
+    heaps_free(blocks, block_cnt);
+
+    /*Bulk heap full: a growing block is moved to the fast heap with its data*/
+    moved = lv_malloc_heap(HEAPS_FILL_MIN, LV_MEM_HEAP_BULK);
+    if(moved) heaps_pattern_set(moved, HEAPS_FILL_MIN);
+    block_cnt = heaps_fill(LV_MEM_HEAP_BULK, blocks);
+
+    if(moved) {
+        uint8_t * grown = lv_realloc(moved, HEAPS_FILL_MIN * 16);
+        if(grown) moved = grown;
+        violated += heaps_expect(grown && lv_mem_get_heap(grown) == LV_MEM_HEAP_FAST &&
+                                 heaps_pattern_check(grown, HEAPS_FILL_MIN),
+                                 "realloc moves a bulk block to the fast heap with its data");
+    }
+    lv_free(moved);
+
+    /*Then the draw buffers go to the fast heap until only a quarter of it is free, the small blocks still fit*/
+    size_t buf_size = fast_mon.total_size / HEAPS_FILL_CNT;
+    size_t fast_limit = fast_mon.total_size - fast_mon.total_size / 4;
+    void * bufs[HEAPS_FILL_CNT] = {NULL};
+    bool reserve_kept = true;
+    bool buf_refused = false;
+    for(i = 0; i < HEAPS_FILL_CNT; i++) {
+        /*Checked with a buffer of tolerance: the heap takes the quarter of its pools, which are a bit larger than
+         *the `total_size` of the monitor*/
+        lv_mem_heap_monitor(LV_MEM_HEAP_FAST, &fast_mon);
+        bool fits = fast_mon.cur_used <= fast_limit;
+        bufs[i] = handlers->buf_malloc_cb(buf_size, LV_COLOR_FORMAT_ARGB8888);
+        if(bufs[i] == NULL) {
+            /*Refused only because of the reserve (the block has an alignment margin and a header in addition)*/
+            buf_refused = fast_mon.cur_used + 2 * buf_size > fast_limit;
+            break;
+        }
+        if(lv_mem_get_heap(bufs[i]) != LV_MEM_HEAP_FAST || !fits) reserve_kept = false;
+    }
+    violated += heaps_expect(reserve_kept && buf_refused,
+                             "draw buffers in the fast heap when the bulk heap is full, a quarter of it kept free");
+
+    bool small_kept = true;
+    void * smalls[4];
+    for(i = 0; i < 4; i++) {
+        smalls[i] = lv_malloc(HEAPS_FILL_MIN * 2);
+        if(smalls[i] == NULL || lv_mem_get_heap(smalls[i]) != LV_MEM_HEAP_FAST) small_kept = false;
+    }
+    heaps_free(smalls, 4);
+    violated += heaps_expect(small_kept, "small blocks in the quarter of the fast heap kept free");
+
+    for(i = 0; i < HEAPS_FILL_CNT && bufs[i]; i++) handlers->buf_free_cb(bufs[i]);
+    heaps_free(blocks, block_cnt);
+#endif
+    return violated;
+}
+
+uint32_t draw_bench_heaps_log(void)
+{
+    LV_LOG_USER("small blocks with lv_malloc and draw buffers with the default draw buffer handlers:");
+
+    draw_bench_heaps_result_t res;
+    uint32_t violated = 0;
+#if LV_MEM_BULK
+    uint32_t bulk_size = 0;
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_HEAPS_BULK_SIZE_CNT; i++) {
+        uint32_t size = heaps_bulk_sizes[i] * 1024;
+        if(size > bulk_size) {
+            /*The pool stands for the external RAM, it can't be removed*/
+            void * mem = malloc(size - bulk_size);
+            if(mem == NULL || lv_mem_add_heap_pool(LV_MEM_HEAP_BULK, mem, size - bulk_size) == NULL) {
+                LV_LOG_USER("  couldn't grow the bulk heap to %u KB", (unsigned)heaps_bulk_sizes[i]);
+                free(mem);
+                return violated;
+            }
+            bulk_size = size;
+        }
+
+        draw_bench_heaps(&res);
+        heaps_log_result(&res);
+        violated += draw_bench_heaps_check();
+    }
+#elif LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    draw_bench_heaps(&res);
+    heaps_log_result(&res);
+    violated += draw_bench_heaps_check();
+    LV_LOG_USER("  the bulk heap needs LV_MEM_BULK_SIZE > 0");
+#else
+    LV_UNUSED(res);
+    LV_LOG_USER("  the heaps need the builtin heap (LV_STDLIB_BUILTIN)");
+#endif
+
+    LV_LOG_USER("placement rules: %u violated", (unsigned)violated);
+    return violated;
+}
+
+void draw_bench_image_cache(lv_color_format_t cf, const lv_cache_class_t * cache_class, uint32_t budget,
+                            draw_bench_image_cache_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+    res->budget = budget;
+
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_IMAGE_CACHE_SRC_CNT; i++) {
+        image_srcs[i].header.magic = LV_IMAGE_HEADER_MAGIC;
+        image_srcs[i].header.cf = cf;
+        image_srcs[i].header.w = IMAGE_SIZE;
+        image_srcs[i].header.h = IMAGE_SIZE;
+        image_srcs[i].header.stride = lv_draw_buf_width_to_stride(IMAGE_SIZE, cf);
+        image_srcs[i].data = image_src_data;
+    }
+
+    /*Tried before the other decoders*/
+    lv_image_decoder_t * decoder = lv_image_decoder_create();
+    lv_image_decoder_set_info_cb(decoder, image_decoder_info);
+    lv_image_decoder_set_open_cb(decoder, image_decoder_open);
+    lv_image_decoder_set_close_cb(decoder, image_decoder_close);
+
+    lv_image_cache_drop(NULL);
+    lv_image_cache_set_class(cache_class);
+    lv_image_cache_resize(budget, true);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_t * images[IMAGE_COLS * IMAGE_ROWS];
+    int32_t col_w = lv_display_get_horizontal_resolution(NULL) / IMAGE_COLS;
+    int32_t row_h = lv_display_get_vertical_resolution(NULL) / IMAGE_ROWS;
+    for(i = 0; i < IMAGE_COLS * IMAGE_ROWS; i++) {
+        images[i] = lv_image_create(scr);
+        lv_obj_set_pos(images[i], (i % IMAGE_COLS) * col_w + (col_w - IMAGE_SIZE) / 2,
+                       (i / IMAGE_COLS) * row_h + (row_h - IMAGE_SIZE) / 2);
+    }
+
+    lv_image_cache_reset_stats();
+    image_decode_ms = 0;
+    uint32_t seed = 1;
+    uint32_t t_start = lv_tick_get();
+    uint32_t f;
+    for(f = 0; f < DRAW_BENCH_IMAGE_CACHE_FRAMES; f++) {
+        for(i = 0; i < IMAGE_COLS * IMAGE_ROWS; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+
+            /*The product of two uniform picks: the first images are much more popular*/
+            uint32_t a = (seed >> 4) % DRAW_BENCH_IMAGE_CACHE_SRC_CNT;
+            uint32_t b = (seed >> 16) % DRAW_BENCH_IMAGE_CACHE_SRC_CNT;
+            lv_image_set_src(images[i], &image_srcs[a * b / DRAW_BENCH_IMAGE_CACHE_SRC_CNT]);
+        }
+        lv_refr_now(NULL);
+    }
+    uint32_t elapsed = lv_tick_elaps(t_start);
+    res->frame_us = (uint32_t)((uint64_t)elapsed * 1000 / DRAW_BENCH_IMAGE_CACHE_FRAMES);
+    res->decode_ms = image_decode_ms;
+
+    lv_cache_stats_t stats;
+    lv_image_cache_get_stats(&stats);
+    uint32_t lookups = stats.hits + stats.misses;
+    res->hit_pct = lookups ? (uint32_t)((uint64_t)stats.hits * 100 / lookups) : 0;
+    res->evictions = stats.evictions;
+
+    for(i = 0; i < IMAGE_COLS * IMAGE_ROWS; i++) lv_obj_delete(images[i]);
+
+    /*The cached images refer to the decoder*/
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_delete(decoder);
+}
+
+void draw_bench_image_cache_log(void)
+{
+    lv_cache_stats_t stats;
+    lv_image_cache_get_stats(&stats);
+    uint32_t max_size = stats.max_size;
+    const lv_cache_class_t * cache_class = LV_GLOBAL_DEFAULT()->img_cache->clz;
+
+    static const lv_color_format_t cfs[] = {LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888};
+    static const char * const scenes[] = {"multiple_rgb_images", "multiple_argb_images"};
+    draw_bench_image_cache_result_t res;
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        uint32_t total = lv_draw_buf_width_to_stride(IMAGE_SIZE, cfs[c]) * IMAGE_SIZE * DRAW_BENCH_IMAGE_CACHE_SRC_CNT;
+        LV_LOG_USER("%s: %u images of %u bytes, %u of %u decoded in %u ms:", scenes[c],
+                    DRAW_BENCH_IMAGE_CACHE_SRC_CNT, (unsigned)(total / DRAW_BENCH_IMAGE_CACHE_SRC_CNT),
+                    DRAW_BENCH_IMAGE_CACHE_SRC_CNT / 2, DRAW_BENCH_IMAGE_CACHE_SRC_CNT, DRAW_BENCH_IMAGE_CACHE_SLOW_MS);
+
+        uint32_t i;
+        for(i = 0; i < DRAW_BENCH_IMAGE_CACHE_BUDGET_CNT; i++) {
+            uint32_t budget = (uint32_t)((uint64_t)total * image_cache_budgets[i] / 100);
+            draw_bench_image_cache(cfs[c], &lv_cache_class_lru_rb_size, budget, &res);
+            image_cache_log_result("LRU", &res);
+            draw_bench_image_cache(cfs[c], &lv_cache_class_gds_size, budget, &res);
+            image_cache_log_result("GDS", &res);
+        }
+    }
+
+    lv_image_cache_set_class(cache_class);
+    lv_image_cache_resize(max_size, true);
+}
+
+void draw_bench_image_async(bool async, draw_bench_image_async_result_t * res)
+{
+    lv_memzero(res, sizeof(*res));
+#if LV_USE_LODEPNG
+    if(!gallery_create_pngs()) {
+        LV_LOG_WARN("couldn't encode the PNG images");
+        return;
+    }
+
+#if LV_IMAGE_DECODER_ASYNC
+    lv_image_decoder_enable_async(async);
+    lv_image_decoder_reset_async_stats();
+#else
+    LV_UNUSED(async);
+#endif
+    lv_image_cache_drop(NULL);
+
+    /*A grey image 10 times smaller, drawn stretched*/
+    uint32_t i;
+    for(i = 0; i < GALLERY_THUMB_W * GALLERY_THUMB_H; i++) gallery_thumb_buf[i] = 0xff808080;
+    gallery_thumb.header.magic = LV_IMAGE_HEADER_MAGIC;
+    gallery_thumb.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    gallery_thumb.header.w = GALLERY_THUMB_W;
+    gallery_thumb.header.h = GALLERY_THUMB_H;
+    gallery_thumb.header.stride = GALLERY_THUMB_W * 4;
+    gallery_thumb.data = (const uint8_t *)gallery_thumb_buf;
+    gallery_thumb.data_size = sizeof(gallery_thumb_buf);
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+    lv_obj_set_style_pad_all(cont, GALLERY_PAD, 0);
+    lv_obj_set_style_pad_row(cont, GALLERY_PAD, 0);
+    for(i = 0; i < GALLERY_COLS * DRAW_BENCH_IMAGE_ASYNC_ROWS; i++) {
+        lv_obj_t * img = lv_image_create(cont);
+        lv_image_set_src(img, &gallery_pngs[i]);
+#if LV_IMAGE_DECODER_ASYNC
+        lv_image_set_placeholder(img, &gallery_thumb);
+#endif
+    }
+    lv_obj_update_layout(cont);
+
+    /*The frames are drawn here, the other timers (e.g. the one calling back the decoder thread) run before each*/
+    lv_timer_t * refr_timer = lv_display_get_refr_timer(lv_display_get_default());
+    if(refr_timer) lv_timer_pause(refr_timer);
+
+    int32_t scroll_steps = lv_obj_get_scroll_bottom(cont) / DRAW_BENCH_IMAGE_ASYNC_STEP;
+    uint32_t frame_cnt = 2 * scroll_steps + 1;
+    uint32_t * frame_ms = lv_malloc(frame_cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(frame_ms);
+    if(frame_ms == NULL) frame_cnt = 0;
+
+    uint32_t f;
+    for(f = 0; f < frame_cnt; f++) {
+        int32_t step = (int32_t)f <= scroll_steps ? (int32_t)f : 2 * scroll_steps - (int32_t)f;
+        uint32_t t_start = lv_tick_get();
+        lv_timer_handler();
+        lv_obj_scroll_to_y(cont, step * DRAW_BENCH_IMAGE_ASYNC_STEP, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+        frame_ms[f] = lv_tick_elaps(t_start);
+
+#if LV_IMAGE_DECODER_ASYNC
+        lv_image_decoder_async_stats_t stats;
+        lv_image_decoder_get_async_stats(&stats);
+        if(stats.pending) res->late_frames++;
+#endif
+        if(frame_ms[f] < DRAW_BENCH_IMAGE_ASYNC_PERIOD) lv_delay_ms(DRAW_BENCH_IMAGE_ASYNC_PERIOD - frame_ms[f]);
+    }
+
+    if(refr_timer) lv_timer_resume(refr_timer);
+
+    /*Cancels the queued images*/
+    lv_obj_delete(cont);
+
+#if LV_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_stats_t stats;
+    lv_image_decoder_get_async_stats(&stats);
+    while(stats.pending) {
+        lv_delay_ms(1);
+        lv_image_decoder_get_async_stats(&stats);
+    }
+    res->decoded = stats.decoded;
+    res->merged = stats.merged;
+    res->canceled = stats.canceled;
+    lv_image_decoder_enable_async(true);
+#endif
+
+    /*The cached images refer to the PNG data*/
+    lv_image_cache_drop(NULL);
+    gallery_free_pngs();
+
+    if(frame_cnt) {
+        qsort(frame_ms, frame_cnt, sizeof(uint32_t), frame_ms_cmp);
+        res->frames = frame_cnt;
+        res->p50_ms = frame_ms[(frame_cnt - 1) * 50 / 100];
+        res->p90_ms = frame_ms[(frame_cnt - 1) * 90 / 100];
+        res->p99_ms = frame_ms[(frame_cnt - 1) * 99 / 100];
+        res->max_ms = frame_ms[frame_cnt - 1];
+    }
+    lv_free(frame_ms);
+#else
+    LV_UNUSED(async);
+#endif
+}
+
+void draw_bench_image_async_log(void)
+{
+#if LV_USE_LODEPNG
+    lv_cache_stats_t stats;
+    lv_image_cache_get_stats(&stats);
+    uint32_t max_size = stats.max_size;
+    lv_image_cache_resize(DRAW_BENCH_IMAGE_ASYNC_CACHE_SIZE, true);
+
+    LV_LOG_USER("gallery of %u PNG images of %ux%u, %u px scrolled every %u ms, image cache of %u KB:",
+                GALLERY_COLS * DRAW_BENCH_IMAGE_ASYNC_ROWS, GALLERY_W, GALLERY_H, DRAW_BENCH_IMAGE_ASYNC_STEP,
+                DRAW_BENCH_IMAGE_ASYNC_PERIOD, (unsigned)(DRAW_BENCH_IMAGE_ASYNC_CACHE_SIZE / 1024));
+
+    draw_bench_image_async_result_t res;
+    draw_bench_image_async(false, &res);
+    image_async_log_result("decoded while drawn", &res);
+#if LV_IMAGE_DECODER_ASYNC
+    draw_bench_image_async(true, &res);
+    image_async_log_result("decoded in a thread", &res);
+    LV_LOG_USER("  %u decoded in the thread, %u requests merged, %u canceled, %u frames with placeholders",
+                (unsigned)res.decoded, (unsigned)res.merged, (unsigned)res.canceled, (unsigned)res.late_frames);
+#else
+    LV_LOG_USER("  the decoding in a thread needs LV_USE_IMAGE_DECODER_ASYNC and LV_USE_OS");
+#endif
+
+    lv_image_cache_resize(max_size, true);
+#else
+    LV_LOG_USER("the PNG gallery needs LV_USE_LODEPNG");
+#endif
+}
+
+static uint32_t add_tasks(lv_layer_t * layer, uint32_t task_cnt)
+{
+    int32_t hor_res = lv_area_get_width(&layer->buf_area);
+    int32_t ver_res = lv_area_get_height(&layer->buf_area);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+
+    uint32_t start = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < task_cnt; i++) {
+        lv_area_t a;
+        a.x1 = lv_rand(0, hor_res - RECT_SIZE);
+        a.y1 = lv_rand(0, ver_res - RECT_SIZE);
+        a.x2 = a.x1 + RECT_SIZE - 1;
+        a.y2 = a.y1 + RECT_SIZE - 1;
+        lv_draw_rect(layer, &dsc, &a);
+    }
+
+    return lv_tick_elaps(start);
+}
+
+static void dispatch_all(lv_display_t * disp, lv_layer_t * layer)
+{
+    while(layer->draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        bool task_dispatched = lv_draw_dispatch_layer(disp, layer);
+
+        if(!task_dispatched) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+}
+
+static bool inv_measure_start(inv_ctx_t * ctx, draw_bench_inv_result_t * res)
+{
+    lv_display_t * disp = lv_display_get_default();
+    ctx->res = res;
+    ctx->hor_res = lv_display_get_horizontal_resolution(disp);
+    ctx->ver_res = lv_display_get_vertical_resolution(disp);
+    ctx->dirty = lv_malloc_zeroed(ctx->hor_res * ctx->ver_res);
+    lv_memzero(res, sizeof(*res));
+    if(ctx->dirty == NULL) {
+        LV_LOG_WARN("couldn't allocate the dirty pixel map");
+        return false;
+    }
+
+    lv_display_add_event_cb(disp, inv_event_cb, LV_EVENT_ALL, ctx);
+    return true;
+}
+
+static void inv_measure_end(inv_ctx_t * ctx)
+{
+    /*Refresh the area of the deleted widgets before detaching so no frame is counted half*/
+    lv_display_remove_event_cb_with_user_data(lv_display_get_default(), inv_event_cb, ctx);
+    lv_refr_now(NULL);
+    lv_free(ctx->dirty);
+}
+
+static void inv_event_cb(lv_event_t * e)
+{
+    inv_ctx_t * ctx = lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if(code == LV_EVENT_INVALIDATE_AREA) {
+        const lv_area_t * a = lv_event_get_param(e);
+        int32_t y;
+        for(y = a->y1; y <= a->y2; y++) {
+            lv_memset(&ctx->dirty[y * ctx->hor_res + a->x1], 1, lv_area_get_width(a));
+        }
+    }
+    else if(code == LV_EVENT_RENDER_READY) {
+        /*The joined areas are still available here*/
+        lv_display_t * disp = lv_event_get_current_target(e);
+        uint32_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(disp->inv_area_joined[i]) continue;
+            ctx->res->area_cnt++;
+            ctx->res->rendered_px += lv_area_get_size(&disp->inv_areas[i]);
+        }
+
+        int32_t px_cnt = ctx->hor_res * ctx->ver_res;
+        int32_t p;
+        for(p = 0; p < px_cnt; p++) {
+            ctx->res->dirty_px += ctx->dirty[p];
+        }
+        lv_memzero(ctx->dirty, px_cnt);
+        ctx->res->frames++;
+    }
+}
+
+static void inv_log_result(const char * name, const draw_bench_inv_result_t * res)
+{
+    if(res->frames == 0) return;
+
+    uint32_t overdraw = res->dirty_px ? (uint32_t)((res->rendered_px - res->dirty_px) * 100 / res->dirty_px) : 0;
+    LV_LOG_USER("  %-8s  %6u  %11u  %14u  %17u  %7u%%", name, (unsigned)res->frames,
+                (unsigned)(res->area_cnt / res->frames), (unsigned)(res->dirty_px / res->frames),
+                (unsigned)(res->rendered_px / res->frames), (unsigned)overdraw);
+}
+
+static void blend_exec(lv_color_format_t cf, draw_bench_blend_op_t op, const blend_case_t * c)
+{
+    if(op & 4) {
+        lv_draw_sw_blend_image_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = c->dest;
+        dsc.dest_w = c->w;
+        dsc.dest_h = c->h;
+        dsc.dest_stride = c->dest_stride;
+        dsc.mask_buf = (op & 2) ? c->mask : NULL;
+        dsc.mask_stride = c->mask_stride;
+        dsc.src_buf = c->src;
+        dsc.src_stride = c->src_stride;
+        dsc.src_color_format = c->src_cf;
+        dsc.opa = c->opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        switch(cf) {
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+            case LV_COLOR_FORMAT_ARGB8888:
+                lv_draw_sw_blend_image_to_argb8888(&dsc);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_XRGB8888
+            case LV_COLOR_FORMAT_XRGB8888:
+                lv_draw_sw_blend_image_to_rgb888(&dsc, 4);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB888
+            case LV_COLOR_FORMAT_RGB888:
+                lv_draw_sw_blend_image_to_rgb888(&dsc, 3);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565
+            case LV_COLOR_FORMAT_RGB565:
+                lv_draw_sw_blend_image_to_rgb565(&dsc);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    else {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = c->dest;
+        dsc.dest_w = c->w;
+        dsc.dest_h = c->h;
+        dsc.dest_stride = c->dest_stride;
+        dsc.mask_buf = (op & 2) ? c->mask : NULL;
+        dsc.mask_stride = c->mask_stride;
+        dsc.color = c->color;
+        dsc.opa = c->opa;
+        switch(cf) {
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+            case LV_COLOR_FORMAT_ARGB8888:
+                lv_draw_sw_blend_color_to_argb8888(&dsc);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_XRGB8888
+            case LV_COLOR_FORMAT_XRGB8888:
+                lv_draw_sw_blend_color_to_rgb888(&dsc, 4);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB888
+            case LV_COLOR_FORMAT_RGB888:
+                lv_draw_sw_blend_color_to_rgb888(&dsc, 3);
+                break;
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565
+            case LV_COLOR_FORMAT_RGB565:
+                lv_draw_sw_blend_color_to_rgb565(&dsc);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+}
+
+static const char * blend_cf_name(lv_color_format_t cf)
+{
+    return cf == LV_COLOR_FORMAT_ARGB8888 ? "ARGB8888" :
+           cf == LV_COLOR_FORMAT_XRGB8888 ? "XRGB8888" :
+           cf == LV_COLOR_FORMAT_RGB888 ? "RGB888" : "RGB565";
+}
+
+/**
+ * Select the blend code: 0: C, 1: SSE2, 2: AVX2
+ * @return      the really selected one, limited to what's available
+ */
+static uint32_t blend_set_isa(uint32_t isa)
+{
+#if BLEND_ISA_CNT > 1
+    return lv_blend_x86_set_isa((lv_blend_x86_isa_t)isa);
+#else
+    LV_UNUSED(isa);
+    return 0;
+#endif
+}
+
+/**
+ * Random byte, often one of the opacity values handled specially by the blend code
+ */
+static uint8_t rand_opa(void)
+{
+    static const uint8_t special[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    if(lv_rand(0, 1)) return special[lv_rand(0, sizeof(special) - 1)];
+    return (uint8_t)lv_rand(0, 255);
+}
+
+/**
+ * Fill `txt` with words in English and French (with Latin-1 letters), `len` bytes and a closing '\0'
+ */
+static void text_fill(char * txt, uint32_t len)
+{
+    static const char words[] = "The quick brown fox jumps over the lazy dog. "
+                                "Voix ambigu\xc3\xab d'un c\xc5\x93ur qui, au z\xc3\xa9phyr, "
+                                "pr\xc3\xa9" "f\xc3\xa8re les jattes de kiwis. ";
+    uint32_t words_len = sizeof(words) - 1;
+    uint32_t i = 0;
+    while(i + words_len <= len) {
+        lv_memcpy(txt + i, words, words_len);
+        i += words_len;
+    }
+
+    /*Pad with spaces to not cut a multi-byte character*/
+    while(i < len) txt[i++] = ' ';
+    txt[len] = '\0';
+}
+
+/**
+ * Redraw the whole active screen for `time_ms` milliseconds
+ * @param time_ms   measuring time in ms
+ * @return          microseconds per frame
+ */
+static uint32_t redraw_time(uint32_t time_ms)
+{
+    lv_display_t * disp = lv_display_get_default();
+
+    /*Once to fill the caches*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+
+    uint32_t frames = 0;
+    uint32_t elapsed;
+    uint32_t t_start = lv_tick_get();
+    do {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        frames++;
+        elapsed = lv_tick_elaps(t_start);
+    } while(elapsed < time_ms);
+
+    return (uint32_t)((uint64_t)elapsed * 1000 / frames);
+}
+
+static void shadow_log_result(const char * name, const int32_t widths[], uint32_t width_cnt)
+{
+    lv_draw_sw_box_shadow_cache_reset_stats();
+    uint32_t us = draw_bench_shadow_cards(widths, width_cnt);
+
+    lv_draw_sw_box_shadow_cache_stats_t stats;
+    lv_draw_sw_box_shadow_cache_get_stats(&stats);
+    uint32_t lookups = stats.hits + stats.misses;
+    if(stats.max_size == 0) {
+        LV_LOG_USER("  %-14s %6u us/frame, cache disabled", name, (unsigned)us);
+    }
+    else {
+        LV_LOG_USER("  %-14s %6u us/frame, cache: %u%% hit rate, %u / %u bytes used", name, (unsigned)us,
+                    lookups ? (unsigned)((uint64_t)stats.hits * 100 / lookups) : 0,
+                    (unsigned)stats.size, (unsigned)stats.max_size);
+    }
+}
+
+static void radius_log_result(const char * name, uint32_t radius_cnt)
+{
+    lv_draw_sw_mask_circle_cache_reset_stats();
+    uint32_t us = draw_bench_radius_buttons(radius_cnt);
+
+    lv_draw_sw_mask_circle_cache_stats_t stats;
+    lv_draw_sw_mask_circle_cache_get_stats(&stats);
+    uint32_t lookups = stats.hits + stats.misses;
+    if(stats.max_size == 0) {
+        LV_LOG_USER("  %-14s %6u us/frame, cache disabled", name, (unsigned)us);
+    }
+    else {
+        LV_LOG_USER("  %-14s %6u us/frame, cache: %u%% hit rate, %u / %u bytes used", name, (unsigned)us,
+                    lookups ? (unsigned)((uint64_t)stats.hits * 100 / lookups) : 0,
+                    (unsigned)stats.size, (unsigned)stats.max_size);
+    }
+}
+
+static void style_log_result(const char * name, bool cache_en)
+{
+    draw_bench_style_result_t res;
+    draw_bench_style_buttons(cache_en, &res);
+
+    uint32_t reads = res.hits + res.misses;
+    if(reads == 0) {
+        LV_LOG_USER("  %-9s %6u us/frame, %5u ns/button to read the styles", name, (unsigned)res.frame_us,
+                    (unsigned)res.dsc_ns);
+    }
+    else {
+        LV_LOG_USER("  %-9s %6u us/frame, %5u ns/button to read the styles, %u%% hit rate", name,
+                    (unsigned)res.frame_us, (unsigned)res.dsc_ns, (unsigned)((uint64_t)res.hits * 100 / reads));
+    }
+
+    reads = res.toggle_hits + res.toggle_misses;
+    if(reads == 0) {
+        LV_LOG_USER("  %-9s %6u us/frame with a state change per frame", "", (unsigned)res.toggle_frame_us);
+    }
+    else {
+        LV_LOG_USER("  %-9s %6u us/frame with a state change per frame, %u%% hit rate", "",
+                    (unsigned)res.toggle_frame_us, (unsigned)((uint64_t)res.toggle_hits * 100 / reads));
+    }
+}
+
+static void timer_cb(lv_timer_t * timer)
+{
+    uint32_t * runs = lv_timer_get_user_data(timer);
+    (*runs)++;
+}
+
+static void anim_exec_cb(void * var, int32_t v)
+{
+    *(int32_t *)var = v;
+    anim_execs++;
+}
+
+#if LV_USE_OS
+static void mem_thread_cb(void * user_data)
+{
+    uint32_t * small_cnt = user_data;
+    /*`lv_rand()` isn't thread safe*/
+    uint32_t seed = *small_cnt * 0x9E3779B9U;
+    void * blocks[32] = {NULL};
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_MEM_OPS; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        uint32_t size;
+        if((seed & 0xF) == 0) {
+            size = 512 + (seed >> 8) % 1537;
+        }
+        else {
+            size = 8 + (seed >> 8) % 249;
+            cnt++;
+        }
+
+        uint32_t slot = i % 32;
+        lv_free(blocks[slot]);
+        blocks[slot] = lv_malloc(size);
+        if(blocks[slot]) *(uint8_t *)blocks[slot] = (uint8_t)i;
+    }
+
+    for(i = 0; i < 32; i++) lv_free(blocks[i]);
+    *small_cnt = cnt;
+}
+#endif
+
+#if LV_MEM_THREAD_CACHE
+static uint32_t mem_cache_hits(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    uint32_t hits = 0;
+    uint32_t c;
+    for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) hits += mon.classes[c].hits;
+    return hits;
+}
+#endif
+
+static void mem_log_result(const char * name, bool cache_en)
+{
+    uint32_t i;
+    for(i = 0; i < DRAW_BENCH_MEM_THREAD_COUNT_CNT; i++) {
+        draw_bench_mem_result_t res;
+        draw_bench_mem(mem_thread_counts[i], cache_en, &res);
+        LV_LOG_USER("  %s, %u threads: %5u ns/op, %3u%% cache hits", name, (unsigned)res.thread_cnt,
+                    (unsigned)res.op_ns, (unsigned)res.hit_pct);
+    }
+}
+
+/**
+ * Create the heap of a replay and the block table of the trace
+ * @param r             the replay to initialize
+ * @param allocator     the heap to use
+ * @param pool_size     size of the TLSF heap in bytes
+ * @param id_cnt        highest allocation id of the trace + 1
+ * @return              false if out of memory
+ */
+static bool replay_open(replay_t * r, draw_bench_allocator_t allocator, uint32_t pool_size, uint32_t id_cnt)
+{
+    lv_memzero(r, sizeof(*r));
+    r->allocator = allocator;
+    r->id_cnt = id_cnt;
+    r->blocks = calloc(id_cnt ? id_cnt : 1, sizeof(void *));
+    r->sizes = calloc(id_cnt ? id_cnt : 1, sizeof(uint32_t));
+    if(r->blocks == NULL || r->sizes == NULL) {
+        replay_close(r);
+        return false;
+    }
+
+    if(allocator != DRAW_BENCH_ALLOCATOR_TLSF) return true;
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    /*The first pool also stores the control structure of TLSF*/
+    size_t rest = pool_size;
+    size_t bytes = LV_MIN(rest, lv_tlsf_size() + lv_tlsf_block_size_max());
+    r->pool_mems[0] = malloc(bytes);
+    if(r->pool_mems[0] == NULL) {
+        replay_close(r);
+        return false;
+    }
+    r->tlsf = lv_tlsf_create_with_pool(r->pool_mems[0], bytes);
+    if(r->tlsf == NULL) {
+        replay_close(r);
+        return false;
+    }
+    r->pools[0] = lv_tlsf_get_pool(r->tlsf);
+    r->pool_cnt = 1;
+    rest -= bytes;
+
+    /*A small rest can't be a pool, it's dropped*/
+    while(rest >= 1024 && r->pool_cnt < REPLAY_MAX_POOL_CNT) {
+        bytes = LV_MIN(rest, lv_tlsf_pool_overhead() + lv_tlsf_block_size_max());
+        void * mem = malloc(bytes);
+        lv_pool_t pool = mem ? lv_tlsf_add_pool(r->tlsf, mem, bytes) : NULL;
+        if(pool == NULL) {
+            free(mem);
+            replay_close(r);
+            return false;
+        }
+        r->pool_mems[r->pool_cnt] = mem;
+        r->pools[r->pool_cnt] = pool;
+        r->pool_cnt++;
+        rest -= bytes;
+    }
+    return true;
+#else
+    LV_UNUSED(pool_size);
+    replay_close(r);
+    return false;
+#endif
+}
+
+static void replay_close(replay_t * r)
+{
+    uint32_t id;
+    if(r->blocks) {
+        for(id = 0; id < r->id_cnt; id++) {
+            if(r->blocks[id]) replay_free(r, r->blocks[id]);
+        }
+    }
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if(r->tlsf) lv_tlsf_destroy(r->tlsf);
+    uint32_t i;
+    for(i = 0; i < r->pool_cnt; i++) free(r->pool_mems[i]);
+    if(r->pool_cnt == 0) free(r->pool_mems[0]);
+#endif
+
+    free(r->blocks);
+    free(r->sizes);
+    lv_memzero(r, sizeof(*r));
+}
+
+/**
+ * Apply the events of a trace to the heap of a replay
+ * @param r             an opened replay
+ * @param events        the events of the trace
+ * @param event_cnt     number of events
+ * @param res           store the failures, the peak and the fragmentation here, NULL to only replay
+ */
+static void replay_run(replay_t * r, const lv_mem_track_event_t * events, uint32_t event_cnt,
+                       draw_bench_mem_replay_result_t * res)
+{
+    uint32_t used = 0;
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        const lv_mem_track_event_t * e = &events[i];
+        bool failed = false;
+        if(e->op == LV_MEM_TRACK_OP_FREE) {
+            /*Blocks allocated before the trace started or which failed here are unknown*/
+            if(r->blocks[e->id]) {
+                replay_free(r, r->blocks[e->id]);
+                r->blocks[e->id] = NULL;
+                used -= r->sizes[e->id];
+            }
+        }
+        else if(e->id == 0) {
+            /*Failed in the trace too, nothing refers to it*/
+            void * p = replay_alloc(r, e->size);
+            if(p) replay_free(r, p);
+            else failed = true;
+        }
+        else if(r->blocks[e->id] == NULL) {
+            void * p = replay_alloc(r, e->size);
+            if(p) {
+                r->blocks[e->id] = p;
+                r->sizes[e->id] = e->size;
+                used += e->size;
+            }
+            else failed = true;
+        }
+        else {
+            void * p = replay_realloc(r, r->blocks[e->id], e->size);
+            if(p) {
+                r->blocks[e->id] = p;
+                used = used - r->sizes[e->id] + e->size;
+                r->sizes[e->id] = e->size;
+            }
+            else failed = true;
+        }
+
+        if(res == NULL) continue;
+
+        if(failed) {
+            if(res->fails == 0) {
+                res->first_fail = i;
+                res->first_fail_tag = e->tag;
+            }
+            res->fails++;
+        }
+        res->peak_used = LV_MAX(res->peak_used, used);
+        if(failed || i % DRAW_BENCH_MEM_REPLAY_FRAG_STEP == 0) {
+            res->max_frag_pct = LV_MAX(res->max_frag_pct, replay_frag_pct(r));
+        }
+    }
+}
+
+static void * replay_alloc(replay_t * r, size_t size)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if(r->allocator == DRAW_BENCH_ALLOCATOR_TLSF) return lv_tlsf_malloc(r->tlsf, size);
+#endif
+    return malloc(size);
+}
+
+static void * replay_realloc(replay_t * r, void * p, size_t size)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if(r->allocator == DRAW_BENCH_ALLOCATOR_TLSF) return lv_tlsf_realloc(r->tlsf, p, size);
+#endif
+    return realloc(p, size);
+}
+
+static void replay_free(replay_t * r, void * p)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if(r->allocator == DRAW_BENCH_ALLOCATOR_TLSF) {
+        lv_tlsf_free(r->tlsf, p);
+        return;
+    }
+#endif
+    free(p);
+}
+
+/**
+ * Get the fragmentation of a TLSF replay like `lv_mem_monitor()`
+ * @return      100 - the biggest free block in percentage of the free memory, 0 for the C library
+ */
+static uint32_t replay_frag_pct(replay_t * r)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if(r->allocator != DRAW_BENCH_ALLOCATOR_TLSF) return 0;
+
+    size_t free_sizes[2] = {0, 0};     /*Total and biggest*/
+    uint32_t i;
+    for(i = 0; i < r->pool_cnt; i++) lv_tlsf_walk_pool(r->pools[i], replay_frag_walker, free_sizes);
+    if(free_sizes[0] == 0) return 0;
+    return 100 - (uint32_t)((uint64_t)free_sizes[1] * 100 / free_sizes[0]);
+#else
+    LV_UNUSED(r);
+    return 0;
+#endif
+}
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+static void replay_frag_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(ptr);
+    size_t * free_sizes = user;
+    if(used) return;
+    free_sizes[0] += size;
+    free_sizes[1] = LV_MAX(free_sizes[1], size);
+}
+#endif
+
+static void replay_log_result(const char * name, const draw_bench_mem_replay_result_t * res)
+{
+    if(res->fails) {
+        LV_LOG_USER("  %s: %5u fails (first at event %u, %s), peak %7u bytes, max frag %3u%%, %4u ns/op", name,
+                    (unsigned)res->fails, (unsigned)res->first_fail,
+                    lv_mem_tag_get_name((lv_mem_tag_t)res->first_fail_tag),
+                    (unsigned)res->peak_used, (unsigned)res->max_frag_pct, (unsigned)res->op_ns);
+    }
+    else {
+        LV_LOG_USER("  %s: no fails, peak %7u bytes, max frag %3u%%, %4u ns/op", name,
+                    (unsigned)res->peak_used, (unsigned)res->max_frag_pct, (unsigned)res->op_ns);
+    }
+}
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+static void heaps_log_result(const draw_bench_heaps_result_t * res)
+{
+    LV_LOG_USER("  fast %3u KB, bulk %4u KB: small %3u%% in fast (%5u fails), buffers %3u%% in bulk (%4u fails), "
+                "peak fast %6u bulk %7u bytes, %4u ns/step",
+                (unsigned)(res->fast_size / 1024), (unsigned)(res->bulk_size / 1024),
+                (unsigned)res->small_fast_pct, (unsigned)res->small_fails,
+                (unsigned)res->buf_bulk_pct, (unsigned)res->buf_fails,
+                (unsigned)res->fast_peak, (unsigned)res->bulk_peak, (unsigned)res->op_ns);
+}
+
+static uint32_t heaps_expect(bool ok, const char * rule)
+{
+    if(!ok) LV_LOG_USER("  violated: %s", rule);
+    return ok ? 0 : 1;
+}
+
+/**
+ * Allocate blocks for a heap until it's full: their size is halved each time the heap can't hold one.
+ * The blocks placed in the other heap are freed at once.
+ * @param heap      the heap to fill
+ * @param blocks    store the blocks here, `HEAPS_FILL_CNT` at most
+ * @return          number of blocks
+ */
+static uint32_t heaps_fill(lv_mem_heap_t heap, void ** blocks)
+{
+    lv_mem_heap_monitor_t mon;
+    lv_mem_heap_monitor(heap, &mon);
+
+    uint32_t cnt = 0;
+    size_t size = LV_MAX(mon.total_size / 8, HEAPS_FILL_MIN);
+    while(size >= HEAPS_FILL_MIN && cnt < HEAPS_FILL_CNT) {
+        void * p = lv_malloc_heap(size, heap);
+        if(p && lv_mem_get_heap(p) == heap) {
+            blocks[cnt] = p;
+            cnt++;
+        }
+        else {
+            lv_free(p);
+            size /= 2;
+        }
+    }
+
+    return cnt;
+}
+
+static void heaps_free(void ** blocks, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) lv_free(blocks[i]);
+}
+
+static void heaps_pattern_set(uint8_t * p, size_t size)
+{
+    size_t i;
+    for(i = 0; i < size; i++) p[i] = (uint8_t)(i * 7 + 3);
+}
+
+static bool heaps_pattern_check(const uint8_t * p, size_t size)
+{
+    size_t i;
+    for(i = 0; i < size; i++) {
+        if(p[i] != (uint8_t)(i * 7 + 3)) return false;
+    }
+    return true;
+}
+#endif
+
+static lv_result_t image_decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                      lv_image_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    if(dsc->src_type != LV_IMAGE_SRC_VARIABLE) return LV_RESULT_INVALID;
+    if(image_src_index(dsc->src) < 0) return LV_RESULT_INVALID;
+
+    *header = ((const lv_image_dsc_t *)dsc->src)->header;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t image_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    uint32_t t_start = lv_tick_get();
+    int32_t idx = image_src_index(dsc->src);
+    const lv_image_header_t * header = &image_srcs[idx].header;
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create(header->w, header->h, header->cf, header->stride);
+    if(decoded == NULL) return LV_RESULT_INVALID;
+
+    /*A pattern of its own for each image*/
+    int32_t x, y;
+    for(y = 0; y < header->h; y++) {
+        uint8_t * row = lv_draw_buf_goto_xy(decoded, 0, y);
+        for(x = 0; x < header->w; x++) {
+            lv_color_t c = lv_color_make((uint8_t)(x * 2 + idx * 10), (uint8_t)(y * 2), (uint8_t)(idx * 40));
+            if(header->cf == LV_COLOR_FORMAT_RGB565) {
+                ((uint16_t *)row)[x] = lv_color_to_u16(c);
+            }
+            else {
+                ((uint32_t *)row)[x] = lv_color_to_u32(c);
+            }
+        }
+    }
+
+    /*The odd images stand for PNG or JPEG files*/
+    if(idx & 1) {
+        while(lv_tick_elaps(t_start) < DRAW_BENCH_IMAGE_CACHE_SLOW_MS) {}
+    }
+    image_decode_ms += lv_tick_elaps(t_start);
+
+    dsc->decoded = decoded;
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if(entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        dsc->decoded = NULL;
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+
+    return LV_RESULT_OK;
+}
+
+static void image_decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+}
+
+static int32_t image_src_index(const void * src)
+{
+    const lv_image_dsc_t * img = src;
+    if(img < &image_srcs[0] || img >= &image_srcs[DRAW_BENCH_IMAGE_CACHE_SRC_CNT]) return -1;
+    return (int32_t)(img - image_srcs);
+}
+
+static void image_cache_log_result(const char * name, const draw_bench_image_cache_result_t * res)
+{
+    LV_LOG_USER("  %s %7u bytes: %3u%% hit rate, %5u evictions, %5u ms decoding, %6u us/frame", name,
+                (unsigned)res->budget, (unsigned)res->hit_pct, (unsigned)res->evictions,
+                (unsigned)res->decode_ms, (unsigned)res->frame_us);
+}
+
+#if LV_USE_LODEPNG
+/**
+ * Encode the images of the gallery: different gradients with noise, so that they are not too easy to decode
+ */
+static bool gallery_create_pngs(void)
+{
+    uint8_t * px = lv_malloc(GALLERY_W * GALLERY_H * 4);
+    LV_ASSERT_MALLOC(px);
+    if(px == NULL) return false;
+
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < GALLERY_COLS * DRAW_BENCH_IMAGE_ASYNC_ROWS; i++) {
+        uint8_t * p = px;
+        int32_t x, y;
+        for(y = 0; y < GALLERY_H; y++) {
+            for(x = 0; x < GALLERY_W; x++) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                p[0] = (uint8_t)(x * 255 / GALLERY_W + i * 37 + (seed & 0x1f));
+                p[1] = (uint8_t)(y * 255 / GALLERY_H + i * 91 + ((seed >> 8) & 0x1f));
+                p[2] = (uint8_t)((x + y) * i + ((seed >> 16) & 0x1f));
+                p[3] = 0xff;
+                p += 4;
+            }
+        }
+
+        unsigned char * png = NULL;
+        size_t png_size = 0;
+        if(lodepng_encode32(&png, &png_size, px, GALLERY_W, GALLERY_H) != 0) {
+            lv_free(png);
+            lv_free(px);
+            gallery_free_pngs();
+            return false;
+        }
+
+        /*Recognized by the PNG decoder from its data*/
+        lv_memzero(&gallery_pngs[i], sizeof(gallery_pngs[i]));
+        gallery_pngs[i].header.magic = LV_IMAGE_HEADER_MAGIC;
+        gallery_pngs[i].header.cf = LV_COLOR_FORMAT_RAW_ALPHA;
+        gallery_pngs[i].header.w = GALLERY_W;
+        gallery_pngs[i].header.h = GALLERY_H;
+        gallery_pngs[i].data = png;
+        gallery_pngs[i].data_size = (uint32_t)png_size;
+    }
+
+    lv_free(px);
+    return true;
+}
+
+static void gallery_free_pngs(void)
+{
+    uint32_t i;
+    for(i = 0; i < GALLERY_COLS * DRAW_BENCH_IMAGE_ASYNC_ROWS; i++) {
+        lv_free((void *)gallery_pngs[i].data);
+        gallery_pngs[i].data = NULL;
+    }
+}
+
+static int frame_ms_cmp(const void * a, const void * b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return va < vb ? -1 : va > vb;
+}
+
+static void image_async_log_result(const char * name, const draw_bench_image_async_result_t * res)
+{
+    LV_LOG_USER("  %s: %4u frames, p50 %3u ms, p90 %3u ms, p99 %3u ms, max %3u ms", name,
+                (unsigned)res->frames, (unsigned)res->p50_ms, (unsigned)res->p90_ms, (unsigned)res->p99_ms,
+                (unsigned)res->max_ms);
+}
+#endif
+
+static void anim_init(lv_anim_t * a, int32_t * var)
+{
+    lv_anim_init(a);
+    lv_anim_set_var(a, var);
+    lv_anim_set_exec_cb(a, anim_exec_cb);
+    lv_anim_set_values(a, 0, 1000);
+    lv_anim_set_duration(a, lv_rand(200, 2000));
+    lv_anim_set_playback_duration(a, lv_rand(200, 2000));
+    lv_anim_set_repeat_count(a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_path_cb(a, anim_paths[lv_rand(0, sizeof(anim_paths) / sizeof(anim_paths[0]) - 1)]);
+    lv_anim_set_bezier3_param(a, LV_BEZIER_VAL_FLOAT(0.25), LV_BEZIER_VAL_FLOAT(0.1),
+                              LV_BEZIER_VAL_FLOAT(0.25), LV_BEZIER_VAL_FLOAT(1));
+}
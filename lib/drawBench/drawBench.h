@@ -0,0 +1,508 @@
+#ifndef DRAW_BENCH_H
+#define DRAW_BENCH_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Task counts used by `draw_bench_dispatch_log` */
+#define DRAW_BENCH_TASK_COUNTS {100, 1000, 5000}
+#define DRAW_BENCH_TASK_COUNT_CNT 3
+
+/** Minimum measuring time of one task count in ms, the rounds are repeated until reaching it */
+#define DRAW_BENCH_MIN_TIME 500
+
+/** Number of refreshed frames of the invalidation workloads */
+#define DRAW_BENCH_INV_FRAMES 60
+
+/** Measuring time of one blend case (format, operation and kernels) in ms */
+#define DRAW_BENCH_BLEND_TIME 100
+
+/** Random blend cases compared with the C code by `draw_bench_blend_log` */
+#define DRAW_BENCH_BLEND_CHECK_CNT 20000
+
+/** Measuring time of the text layout of one font in ms */
+#define DRAW_BENCH_TEXT_TIME 200
+
+/** Length of the text measured by `draw_bench_text_layout` in bytes */
+#define DRAW_BENCH_TEXT_LEN 4000
+
+/** Measuring time of one shadow workload in ms */
+#define DRAW_BENCH_SHADOW_TIME 500
+
+/** Measuring time of one rounded button workload in ms */
+#define DRAW_BENCH_RADIUS_TIME 500
+
+/** Measuring time of the redraw and of the style reads of the styled buttons in ms */
+#define DRAW_BENCH_STYLE_TIME 500
+
+/** Measuring time of the property lookups of one style size in ms */
+#define DRAW_BENCH_PROPS_TIME 200
+
+/** Style sizes (number of properties) used by `draw_bench_style_props_log` */
+#define DRAW_BENCH_PROP_COUNTS {2, 4, 8, 16, 24, 32, 48}
+#define DRAW_BENCH_PROP_COUNT_CNT 7
+
+/** Timer counts used by `draw_bench_timer_log` */
+#define DRAW_BENCH_TIMER_COUNTS {10, 100, 1000}
+#define DRAW_BENCH_TIMER_COUNT_CNT 3
+
+/** Measuring time of the timer handler with one timer count in ms */
+#define DRAW_BENCH_TIMER_TIME 300
+
+/** Animation counts used by `draw_bench_anim_log` */
+#define DRAW_BENCH_ANIM_COUNTS {50, 500}
+#define DRAW_BENCH_ANIM_COUNT_CNT 2
+
+/** Measuring time of the animations with one animation count in ms */
+#define DRAW_BENCH_ANIM_TIME 300
+
+/** Thread counts used by `draw_bench_mem_log` */
+#define DRAW_BENCH_MEM_THREAD_COUNTS {1, 2, 4}
+#define DRAW_BENCH_MEM_THREAD_COUNT_CNT 3
+
+/** Allocations (and frees) done by each thread of `draw_bench_mem` */
+#define DRAW_BENCH_MEM_OPS 200000
+
+/** Heap sizes in KB an allocation trace is replayed with by `draw_bench_mem_replay_log` */
+#define DRAW_BENCH_MEM_REPLAY_POOL_SIZES {64, 96, 128, 192, 256}
+#define DRAW_BENCH_MEM_REPLAY_POOL_SIZE_CNT 5
+
+/** Events replayed between two measures of the fragmentation */
+#define DRAW_BENCH_MEM_REPLAY_FRAG_STEP 64
+
+/** Minimum measuring time of a replay in ms, the trace is replayed until reaching it */
+#define DRAW_BENCH_MEM_REPLAY_TIME 200
+
+/** Sizes in KB the bulk heap is grown to by `draw_bench_heaps_log`, 0: only the fast heap */
+#define DRAW_BENCH_HEAPS_BULK_SIZES {0, 256, 1024}
+#define DRAW_BENCH_HEAPS_BULK_SIZE_CNT 3
+
+/** Steps of `draw_bench_heaps`, every 8th replaces a draw buffer, the others a small block */
+#define DRAW_BENCH_HEAPS_OPS 200000
+
+/** Image cache budgets used by `draw_bench_image_cache_log`, in percent of the decoded size of all the images */
+#define DRAW_BENCH_IMAGE_CACHE_BUDGETS {25, 50, 100}
+#define DRAW_BENCH_IMAGE_CACHE_BUDGET_CNT 3
+
+/** Images the grid of `draw_bench_image_cache` picks from, the odd ones are slow to decode */
+#define DRAW_BENCH_IMAGE_CACHE_SRC_CNT 24
+
+/** Decode time of a slow image in ms, like a small PNG or JPEG on the target */
+#define DRAW_BENCH_IMAGE_CACHE_SLOW_MS 5
+
+/** Frames redrawn by `draw_bench_image_cache`, the images of the grid change in every frame */
+#define DRAW_BENCH_IMAGE_CACHE_FRAMES 200
+
+/** Rows of the gallery of `draw_bench_image_async`, 3 different PNG images of 150x100 per row */
+#define DRAW_BENCH_IMAGE_ASYNC_ROWS 24
+
+/** Pixels scrolled per frame by `draw_bench_image_async`, down to the end of the gallery and back */
+#define DRAW_BENCH_IMAGE_ASYNC_STEP 12
+
+/** Period of the frames of `draw_bench_image_async` in ms, the decoder thread runs in the idle time */
+#define DRAW_BENCH_IMAGE_ASYNC_PERIOD 16
+
+/** Image cache used by `draw_bench_image_async_log` in bytes, as on the target: about half of the decoded gallery */
+#define DRAW_BENCH_IMAGE_ASYNC_CACHE_SIZE (2 * 1024 * 1024)
+
+/**
+ * Blend operations of the SW renderer. Bit 0: opacity, bit 1: mask, bit 2: image instead of a color.
+ */
+typedef enum {
+    DRAW_BENCH_BLEND_FILL,
+    DRAW_BENCH_BLEND_FILL_OPA,
+    DRAW_BENCH_BLEND_FILL_MASK,
+    DRAW_BENCH_BLEND_FILL_MASK_OPA,
+    DRAW_BENCH_BLEND_IMAGE,
+    DRAW_BENCH_BLEND_IMAGE_OPA,
+    DRAW_BENCH_BLEND_IMAGE_MASK,
+    DRAW_BENCH_BLEND_IMAGE_MASK_OPA,
+    DRAW_BENCH_BLEND_OP_CNT,
+} draw_bench_blend_op_t;
+
+typedef struct {
+    uint32_t task_cnt;
+    uint32_t rounds;
+    uint32_t add_ns;        /**< Time to add (and finalize) a task, per task */
+    uint32_t dispatch_ns;   /**< Time to dispatch, draw and remove a task, per task */
+    uint32_t heap_allocs;   /**< Heap allocations of the draw task pool after the first round, 0 in steady state */
+} draw_bench_result_t;
+
+typedef struct {
+    uint32_t frame_us;      /**< Time to redraw the screen */
+    uint32_t dsc_ns;        /**< Time to fill the rectangle and label descriptors of a button from its styles */
+    uint32_t hits;          /**< Reads answered by the resolved style cache */
+    uint32_t misses;        /**< Reads resolved from the styles and stored in the cache */
+    uint32_t toggle_frame_us;   /**< Time to redraw the screen when a button is checked or unchecked before each frame */
+    uint32_t toggle_hits;       /**< Reads answered by the cache while toggling */
+    uint32_t toggle_misses;     /**< Reads resolved from the styles while toggling */
+} draw_bench_style_result_t;
+
+typedef struct {
+    uint32_t timer_cnt;
+    uint32_t handler_ns;        /**< Time of an `lv_timer_handler()` call, including the callbacks */
+    uint32_t runs;              /**< Timer callbacks called while measuring */
+    uint32_t create_delete_ns;  /**< Time to create and delete a timer among the others */
+} draw_bench_timer_result_t;
+
+typedef struct {
+    uint32_t anim_cnt;
+    uint32_t refr_ns;           /**< Time of an `lv_anim_refr_now()` call, including the exec callbacks */
+    uint32_t execs;             /**< Values applied while measuring */
+    uint32_t restart_ns;        /**< Time to start an animation replacing a running one of the same variable */
+} draw_bench_anim_result_t;
+
+typedef struct {
+    uint32_t thread_cnt;
+    uint32_t op_ns;             /**< Wall time of an allocation and a free divided by the operations of all the threads */
+    uint32_t hit_pct;           /**< Small allocations served by the thread caches without locking the heap */
+} draw_bench_mem_result_t;
+
+typedef enum {
+    DRAW_BENCH_ALLOCATOR_TLSF,  /**< TLSF pools like the builtin heap, needs `LV_STDLIB_BUILTIN` */
+    DRAW_BENCH_ALLOCATOR_CLIB,  /**< `malloc()`/`free()` of the C library, without size limit */
+} draw_bench_allocator_t;
+
+typedef struct {
+    uint32_t pool_size;         /**< Heap size in bytes, 0 for the C library */
+    uint32_t fails;             /**< Allocations and reallocations which failed */
+    uint32_t first_fail;        /**< Index of the first failed event, UINT32_MAX if none */
+    uint8_t first_fail_tag;     /**< `lv_mem_tag_t` of the first failed event */
+    uint32_t peak_used;         /**< Most requested bytes in use at once */
+    uint32_t max_frag_pct;      /**< Highest fragmentation seen (as `frag_pct` of `lv_mem_monitor_t`), TLSF only */
+    uint32_t op_ns;             /**< Time of an event */
+} draw_bench_mem_replay_result_t;
+
+typedef struct {
+    uint32_t fast_size;         /**< Bytes of the fast heap */
+    uint32_t bulk_size;         /**< Bytes of the bulk heap, 0 if it has no pool */
+    uint32_t small_fast_pct;    /**< Small blocks placed in the fast heap */
+    uint32_t small_fails;       /**< Small blocks which couldn't be allocated */
+    uint32_t buf_bulk_pct;      /**< Draw buffers placed in the bulk heap */
+    uint32_t buf_fails;         /**< Draw buffers which couldn't be allocated */
+    uint32_t fast_peak;         /**< Most bytes used in the fast heap */
+    uint32_t bulk_peak;         /**< Most bytes used in the bulk heap */
+    uint32_t op_ns;             /**< Time of a step */
+} draw_bench_heaps_result_t;
+
+typedef struct {
+    uint32_t budget;            /**< Size of the image cache in bytes */
+    uint32_t hit_pct;           /**< Image opens answered by the cache */
+    uint32_t evictions;         /**< Decoded images dropped to make room for others */
+    uint32_t decode_ms;         /**< Time spent decoding the missed images */
+    uint32_t frame_us;          /**< Time to redraw the grid, including the decodes */
+} draw_bench_image_cache_result_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t p50_ms;            /**< Median time of a frame: timers, scroll and redraw */
+    uint32_t p90_ms;
+    uint32_t p99_ms;
+    uint32_t max_ms;
+    uint32_t late_frames;       /**< Frames drawn while images were being decoded, i.e. with placeholders */
+    uint32_t decoded;           /**< Images decoded by the thread, 0 when the images are decoded while drawn */
+    uint32_t merged;            /**< Requests of an image already queued */
+    uint32_t canceled;          /**< Queued images scrolled out before their decoding */
+} draw_bench_image_async_result_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t area_cnt;      /**< Areas refreshed after joining */
+    uint64_t dirty_px;      /**< Pixels really invalidated (union of the invalidated areas) */
+    uint64_t rendered_px;   /**< Pixels of the refreshed areas */
+} draw_bench_inv_result_t;
+
+/**
+ * Measure the overhead of the draw task queue: add `task_cnt` small, scattered fill tasks
+ * to an off-screen layer, then dispatch them to the draw units until the layer is empty.
+ * The tasks are tiny so the time is dominated by the queue handling, not by rendering.
+ * @param task_cnt  number of draw tasks in one round
+ * @param res       store the result here
+ */
+void draw_bench_dispatch(uint32_t task_cnt, draw_bench_result_t * res);
+
+/**
+ * Run `draw_bench_dispatch` with `DRAW_BENCH_TASK_COUNTS` and print the results with LV_LOG_USER
+ */
+void draw_bench_dispatch_log(void);
+
+/**
+ * Scroll a list on the left half of the screen while a counter label and a bar change on the right,
+ * and count the invalidated and the really rendered pixels.
+ * Creates its widgets on the active screen and deletes them at the end.
+ * @param frames    number of frames to refresh
+ * @param res       store the result here
+ */
+void draw_bench_inv_scroll(uint32_t frames, draw_bench_inv_result_t * res);
+
+/**
+ * Update the text of many labels of a grid in every frame (more than `LV_INV_BUF_SIZE` areas),
+ * and count the invalidated and the really rendered pixels.
+ * Creates its widgets on the active screen and deletes them at the end.
+ * @param frames    number of frames to refresh
+ * @param res       store the result here
+ */
+void draw_bench_inv_labels(uint32_t frames, draw_bench_inv_result_t * res);
+
+/**
+ * Run the invalidation workloads and print the results with LV_LOG_USER
+ */
+void draw_bench_inv_log(void);
+
+/**
+ * Compare the SIMD blend kernels (`LV_DRAW_SW_ASM_SSE2/AVX2`) with the C code of LVGL on random cases:
+ * every destination format, operation and image format, odd sizes, unaligned buffers and the special opacity values.
+ * The image formats without kernels (e.g. 3 byte RGB888) are included to check that the C code still blends them.
+ * The whole buffers are compared so writing out of the area is detected too.
+ * @param case_cnt  number of random cases
+ * @return          number of cases where a kernel's result differs from the C code (0 without SIMD kernels)
+ */
+uint32_t draw_bench_blend_check(uint32_t case_cnt);
+
+/**
+ * Measure the throughput of a blend operation with the blend code currently in use
+ * @param cf        destination color format: ARGB8888, XRGB8888, RGB888 or RGB565
+ * @param op        the operation
+ * @param src_cf    color format of the image of the image operations
+ * @param w         width of the area
+ * @param h         height of the area
+ * @return          blended pixels per microsecond (Mpx/s)
+ */
+uint32_t draw_bench_blend(lv_color_format_t cf, draw_bench_blend_op_t op, lv_color_format_t src_cf, int32_t w,
+                          int32_t h);
+
+/**
+ * Run `draw_bench_blend_check`, then `draw_bench_blend` on a screen sized area
+ * for every format, operation and image format with the C code and every available SIMD kernel set.
+ * Print the results with LV_LOG_USER.
+ */
+void draw_bench_blend_log(void);
+
+/**
+ * Log the counters of the glyph cache of the fmt_txt fonts (`LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE`).
+ * Called at the end of the benchmark, e.g. after the `multiple_labels` and `screen_sized_text` scenes.
+ */
+void draw_bench_glyph_cache_log(void);
+
+/**
+ * Log the counters of the gradient cache of the software renderer (`LV_DRAW_SW_GRADIENT_CACHE_SIZE`).
+ * Called at the end of the benchmark, e.g. after the `widgets_demo` scene (the default theme and the demo use gradients).
+ */
+void draw_bench_gradient_cache_log(void);
+
+/**
+ * Measure the label layout: `lv_text_get_size` of a long ASCII and Latin-1 text wrapped to `max_width`.
+ * It's dominated by the glyph id and kerning lookups of the font.
+ * @param font          the font to use
+ * @param max_width     wrap the text to this width
+ * @return              nanoseconds per character
+ */
+uint32_t draw_bench_text_layout(const lv_font_t * font, int32_t max_width);
+
+/**
+ * Run `draw_bench_text_layout` with the enabled built-in fonts on the display's width
+ * and print the results with LV_LOG_USER.
+ */
+void draw_bench_text_layout_log(void);
+
+/**
+ * Redraw a grid of cards with rounded corners and box shadows.
+ * The cards take the shadow widths from `widths` in turns so that neighbour cards need different corners.
+ * Creates its widgets on the active screen and deletes them at the end.
+ * @param widths        shadow widths
+ * @param width_cnt     number of elements in `widths`
+ * @return              microseconds per frame
+ */
+uint32_t draw_bench_shadow_cards(const int32_t widths[], uint32_t width_cnt);
+
+/**
+ * Run `draw_bench_shadow_cards` with one and with mixed shadow widths
+ * and print the results and the counters of the shadow corner cache with LV_LOG_USER.
+ */
+void draw_bench_shadow_log(void);
+
+/**
+ * Redraw a grid of small buttons with rounded corners and borders.
+ * Each button is a fill and a border draw task, so the draw units look up the radius masks in parallel.
+ * Creates its widgets on the active screen and deletes them at the end.
+ * @param radius_cnt    number of different radii, 1 to use the same radius everywhere
+ * @return              microseconds per frame
+ */
+uint32_t draw_bench_radius_buttons(uint32_t radius_cnt);
+
+/**
+ * Run `draw_bench_radius_buttons` with one and with mixed radii
+ * and print the results and the counters of the circle cache with LV_LOG_USER.
+ * Build with more draw units (e.g. LV_DRAW_SW_DRAW_UNIT_CNT=4) to measure the contention on the cache.
+ */
+void draw_bench_radius_log(void);
+
+/**
+ * Redraw a grid of themed buttons with labels, several shared styles and mixed states,
+ * and measure how long it takes to fill their draw descriptors from the styles.
+ * Then redraw it again while checking or unchecking one button before each frame.
+ * Creates its widgets on the active screen and deletes them at the end.
+ * @param cache_en      true: use the resolved style cache (`LV_OBJ_STYLE_RESOLVED_CACHE`)
+ * @param res           store the result here
+ */
+void draw_bench_style_buttons(bool cache_en, draw_bench_style_result_t * res);
+
+/**
+ * Run `draw_bench_style_buttons` with and without the resolved style cache
+ * and print the results with LV_LOG_USER.
+ */
+void draw_bench_style_log(void);
+
+/**
+ * Measure `lv_style_get_prop_inlined` with random built-in property IDs (found or not) in a style.
+ * @param prop_cnt      number of properties in the style
+ * @param const_style   true: use a constant style (`LV_STYLE_CONST_INIT`, always scanned);
+ *                      false: a normal style (indexed from `LV_STYLE_PROP_INDEX_MIN` properties)
+ * @return              lookups per millisecond
+ */
+uint32_t draw_bench_style_props(uint32_t prop_cnt, bool const_style);
+
+/**
+ * Run `draw_bench_style_props` with several style sizes, normal and constant styles,
+ * and print the results with LV_LOG_USER.
+ */
+void draw_bench_style_props_log(void);
+
+/**
+ * Measure `lv_timer_handler()` with many timers of random periods (5..500 ms) and empty callbacks,
+ * and the creation and deletion of a timer among them. The display's refresh timer is paused meanwhile.
+ * @param timer_cnt     number of timers to create
+ * @param res           store the result here
+ */
+void draw_bench_timer(uint32_t timer_cnt, draw_bench_timer_result_t * res);
+
+/**
+ * Run `draw_bench_timer` with the timer counts of `DRAW_BENCH_TIMER_COUNTS` and print the results with LV_LOG_USER.
+ */
+void draw_bench_timer_log(void);
+
+/**
+ * Measure `lv_anim_refr_now()` with many infinite animations of integer variables using the built-in paths
+ * and random durations (200..2000 ms), and the restart of an animation among them.
+ * @param anim_cnt      number of animations to start
+ * @param res           store the result here
+ */
+void draw_bench_anim(uint32_t anim_cnt, draw_bench_anim_result_t * res);
+
+/**
+ * Run `draw_bench_anim` with the animation counts of `DRAW_BENCH_ANIM_COUNTS` and print the results with LV_LOG_USER.
+ */
+void draw_bench_anim_log(void);
+
+/**
+ * Measure `lv_malloc()`/`lv_free()` from several threads at once. Each thread keeps 32 blocks
+ * of random sizes (mostly 8..256 bytes, sometimes 512..2048 bytes) and replaces the oldest one in every step.
+ * Needs an OS (`LV_USE_OS`).
+ * @param thread_cnt    number of threads allocating at once
+ * @param cache_en      enable the thread caches of the builtin heap (`LV_MEM_THREAD_CACHE_SIZE`)
+ * @param res           store the result here
+ */
+void draw_bench_mem(uint32_t thread_cnt, bool cache_en, draw_bench_mem_result_t * res);
+
+/**
+ * Run `draw_bench_mem` with the thread counts of `DRAW_BENCH_MEM_THREAD_COUNTS`, with and without the thread caches,
+ * and print the results with LV_LOG_USER.
+ */
+void draw_bench_mem_log(void);
+
+/**
+ * Replay an allocation trace (see `lv_mem_track_set_trace_cb()`) with an other heap.
+ * The heaps and the bookkeeping are allocated with the C library, so they can be larger than the LVGL heap.
+ * TLSF pools larger than `lv_tlsf_block_size_max()` are split, as with `LV_MEM_POOL_EXPAND_SIZE`.
+ * @param events        the events of the trace
+ * @param event_cnt     number of events
+ * @param allocator     the heap to replay the trace with
+ * @param pool_size     size of the TLSF heap in bytes (ignored for the C library)
+ * @param res           store the result here
+ * @return              LV_RESULT_INVALID if the heap couldn't be created
+ */
+lv_result_t draw_bench_mem_replay(const lv_mem_track_event_t * events, uint32_t event_cnt,
+                                  draw_bench_allocator_t allocator, uint32_t pool_size,
+                                  draw_bench_mem_replay_result_t * res);
+
+/**
+ * Run `draw_bench_mem_replay` with TLSF heaps of `DRAW_BENCH_MEM_REPLAY_POOL_SIZES` and with the C library,
+ * and print the results with LV_LOG_USER.
+ * @param events        the events of the trace
+ * @param event_cnt     number of events
+ */
+void draw_bench_mem_replay_log(const lv_mem_track_event_t * events, uint32_t event_cnt);
+
+/**
+ * Allocate small blocks (16..256 bytes, 128 live) with `lv_malloc()` and draw buffers (32x32..128x128 ARGB8888,
+ * 8 live) with the default draw buffer handlers, and check in which heap they are placed.
+ * Needs the builtin heap.
+ * @param res           store the result here
+ */
+void draw_bench_heaps(draw_bench_heaps_result_t * res);
+
+/**
+ * Check the placement rules of the heaps: the small blocks in the fast heap and the draw buffers in the bulk heap
+ * while they have room, the fallback to the other heap when one is full but a quarter of the fast heap kept free
+ * for the small blocks, and `lv_realloc()` moving a block to the other heap with its data.
+ * Each violated rule is printed with LV_LOG_USER. Needs the builtin heap.
+ * @return          number of violated rules (0 without the builtin heap)
+ */
+uint32_t draw_bench_heaps_check(void);
+
+/**
+ * Run `draw_bench_heaps` and `draw_bench_heaps_check` with the bulk heap grown to each size of
+ * `DRAW_BENCH_HEAPS_BULK_SIZES`, to simulate a small internal RAM and a large external one, and print the results
+ * with LV_LOG_USER. The pools are allocated with the C library and stay in the bulk heap.
+ * Needs `LV_MEM_BULK_SIZE` >= 768 KB.
+ * @return          number of violated placement rules
+ */
+uint32_t draw_bench_heaps_log(void);
+
+/**
+ * Redraw a grid of 100x100 images like the `multiple_rgb_images` and `multiple_argb_images` scenes, with new images
+ * picked in every frame among `DRAW_BENCH_IMAGE_CACHE_SRC_CNT` (a few of them much more often than the others).
+ * The images are decoded by a decoder of the benchmark into the image cache, the odd ones take
+ * `DRAW_BENCH_IMAGE_CACHE_SLOW_MS` to decode. The scenes' own images are used directly from the flash, never cached.
+ * Creates its widgets on the active screen and deletes them at the end. The image cache is emptied.
+ * @param cf            color format of the images: RGB565 or ARGB8888
+ * @param cache_class   eviction policy of the image cache, e.g. `lv_cache_class_lru_rb_size`
+ * @param budget        size of the image cache in bytes
+ * @param res           store the result here
+ */
+void draw_bench_image_cache(lv_color_format_t cf, const lv_cache_class_t * cache_class, uint32_t budget,
+                            draw_bench_image_cache_result_t * res);
+
+/**
+ * Run `draw_bench_image_cache` with the RGB565 and ARGB8888 images, the budgets of `DRAW_BENCH_IMAGE_CACHE_BUDGETS`,
+ * the LRU and the GreedyDual-Size policies and print the results with LV_LOG_USER.
+ * The class and the size of the image cache are restored at the end.
+ */
+void draw_bench_image_cache_log(void);
+
+/**
+ * Scroll a gallery of `DRAW_BENCH_IMAGE_ASYNC_ROWS` rows of PNG images (encoded at the start) down and back up
+ * by `DRAW_BENCH_IMAGE_ASYNC_STEP` pixels per frame, one frame every `DRAW_BENCH_IMAGE_ASYNC_PERIOD` ms,
+ * and measure the time of each frame. Needs `LV_USE_LODEPNG`.
+ * Creates its widgets on the active screen and deletes them at the end. The image cache is emptied.
+ * @param async         true: decode the images in the thread of the asynchronous decoder and draw a placeholder
+ *                      meanwhile (needs `LV_USE_IMAGE_DECODER_ASYNC`); false: decode them while they are drawn
+ * @param res           store the result here
+ */
+void draw_bench_image_async(bool async, draw_bench_image_async_result_t * res);
+
+/**
+ * Run `draw_bench_image_async` with the images decoded while drawn and in the thread, with an image cache of
+ * `DRAW_BENCH_IMAGE_ASYNC_CACHE_SIZE`, and print the frame time percentiles with LV_LOG_USER.
+ * The size of the image cache is restored at the end.
+ */
+void draw_bench_image_async_log(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*DRAW_BENCH_H*/
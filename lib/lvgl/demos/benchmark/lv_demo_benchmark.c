@@ -52,6 +52,9 @@ typedef struct {
  **********************/
 
 static void load_scene(uint32_t scene);
+static bool scene_name_match(const char * name, const char * token, uint32_t token_len);
+static bool scene_enabled(uint32_t scene);
+static uint32_t next_enabled_scene(uint32_t scene);
 static void next_scene_timer_cb(lv_timer_t * timer);
 
 #if LV_USE_PERF_MONITOR
@@ -423,6 +426,8 @@ static scene_dsc_t scenes[] = {
 
 static uint32_t scene_act;
 static uint32_t rnd_act;
+static const char * scene_filter;
+static void (*benchmark_end_cb)(void);
 
 /**********************
  *      MACROS
@@ -432,9 +437,19 @@ static uint32_t rnd_act;
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_demo_benchmark_set_scenes(const char * names)
+{
+    scene_filter = names;
+}
+
+void lv_demo_benchmark_set_end_cb(void (*end_cb)(void))
+{
+    benchmark_end_cb = end_cb;
+}
+
 void lv_demo_benchmark(void)
 {
-    scene_act = 0;
+    scene_act = next_enabled_scene(0);
 
     lv_obj_t * scr = lv_screen_active();
     lv_obj_remove_style_all(scr);
@@ -453,7 +468,14 @@ void lv_demo_benchmark(void)
 
     load_scene(scene_act);
 
-    lv_timer_create(next_scene_timer_cb, scenes[0].scene_time, NULL);
+    if(scenes[scene_act].scene_time == 0) {
+        LV_LOG_WARN("no scene matches the filter");
+        summary_create();
+        if(benchmark_end_cb) benchmark_end_cb();
+        return;
+    }
+
+    lv_timer_create(next_scene_timer_cb, scenes[scene_act].scene_time, NULL);
 
 #if LV_USE_PERF_MONITOR
     lv_display_t * disp = lv_display_get_default();
@@ -493,16 +515,56 @@ static void load_scene(uint32_t scene)
     if(scenes[scene].create_cb) scenes[scene].create_cb();
 }
 
+static bool scene_name_match(const char * name, const char * token, uint32_t token_len)
+{
+    uint32_t i;
+    for(i = 0; i < token_len; i++) {
+        char a = name[i];
+        char b = token[i] == '_' ? ' ' : token[i];
+        if(a == '\0') return false;
+        if(a >= 'A' && a <= 'Z') a += 'a' - 'A';
+        if(b >= 'A' && b <= 'Z') b += 'a' - 'A';
+        if(a != b) return false;
+    }
+
+    return name[token_len] == '\0';
+}
+
+static bool scene_enabled(uint32_t scene)
+{
+    if(scene_filter == NULL || scene_filter[0] == '\0') return true;
+
+    const char * token = scene_filter;
+    while(*token) {
+        const char * end = token;
+        while(*end && *end != ',') end++;
+        if(scene_name_match(scenes[scene].name, token, (uint32_t)(end - token))) return true;
+        token = *end ? end + 1 : end;
+    }
+
+    return false;
+}
+
+/**
+ * Get the first scene from `scene` allowed by the filter, or the closing empty scene
+ */
+static uint32_t next_enabled_scene(uint32_t scene)
+{
+    while(scenes[scene].create_cb && !scene_enabled(scene)) scene++;
+    return scene;
+}
+
 static void next_scene_timer_cb(lv_timer_t * timer)
 {
     LV_UNUSED(timer);
 
-    scene_act++;
+    scene_act = next_enabled_scene(scene_act + 1);
 
     load_scene(scene_act);
     if(scenes[scene_act].scene_time == 0) {
         lv_timer_delete(timer);
         summary_create();
+        if(benchmark_end_cb) benchmark_end_cb();
     }
     else {
         lv_timer_set_period(timer, scenes[scene_act].scene_time);
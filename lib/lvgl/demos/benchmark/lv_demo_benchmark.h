@@ -50,6 +50,20 @@ extern "C" {
  */
 void lv_demo_benchmark(void);
 
+/**
+ * Run only some of the scenes. Call it before `lv_demo_benchmark()`.
+ * @param names     comma separated list of scene names, case insensitive and `_` matches a space
+ *                  (e.g. "moving_wallpaper,screen_sized_text"). NULL or "" runs all scenes.
+ *                  Only the pointer is saved, the string has to remain valid.
+ */
+void lv_demo_benchmark_set_scenes(const char * names);
+
+/**
+ * Set a callback to call when the summary was created (e.g. to exit from a scripted run)
+ * @param end_cb    the callback or NULL
+ */
+void lv_demo_benchmark_set_end_cb(void (*end_cb)(void));
+
 /**********************
  *      MACROS
  **********************/
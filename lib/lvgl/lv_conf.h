@@ -65,6 +65,22 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Bytes of small freed blocks (<= 256 bytes) each thread keeps to allocate them without locking the heap.
+     *Only with `LV_USE_OS == LV_OS_PTHREAD`. 0: disable*/
+    #define LV_MEM_THREAD_CACHE_SIZE 0
+
+    /*Number of `lv_malloc()` blocks whose tag (subsystem), size and age are recorded to analyze the fragmentation
+     *and to trace the allocations (see `lv_mem_track_dump()`). At most 7/8 of them are used. 0: disable*/
+    #define LV_MEM_TRACK_BLOCK_CNT 0
+
+    /*Size of the bulk heap in bytes, e.g. in external SDRAM, used for the draw buffers and the decoded images
+     *while the small blocks stay in the `LV_MEM_SIZE` heap (see `lv_malloc_heap()`). 0: only one heap*/
+    #define LV_MEM_BULK_SIZE (8 * 1024 * 1024U)
+
+    /*Address of the bulk heap. 0: add its pools (up to `LV_MEM_BULK_SIZE` bytes each) with
+     *`lv_mem_add_heap_pool(LV_MEM_HEAP_BULK, ...)`, e.g. once the external RAM is initialized*/
+    #define LV_MEM_BULK_ADR 0
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -158,6 +174,12 @@
      * > 1 means multiple threads will render the screen in parallel */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /* Split draw tasks covering at least this many pixels into horizontal bands
+     * and render the bands in parallel on the idle draw units.
+     * Only fills, images and layers are split. 0: disable.
+     * Has effect only if LV_DRAW_SW_DRAW_UNIT_CNT > 1 */
+    #define LV_DRAW_SW_SPLIT_MIN_AREA   0
+
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -169,18 +191,19 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
-
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        /*Size of the cache of the blurred shadow corners [bytes].
+        *A corner costs `(shadow_width + radius)^2` bytes, the least recently used ones are dropped.
+        *0: blur the corners for every draw task*/
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE (8 * 1024U)
+
+        /*Size of the cache of the anti-aliased circle corners used by the radius masks [bytes].
+        *A corner costs about `radius * 6` bytes, it's shared by all the draw units without locking.
+        *0: calculate the corners for every mask*/
+        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024U)
     #endif
 
+    /* LV_DRAW_SW_ASM_SSE2 and LV_DRAW_SW_ASM_AVX2 are for x86 and x86-64.
+     * With AVX2 the kernels are selected at runtime with CPUID and SSE2 is used on older CPUs */
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -189,6 +212,11 @@
 
     /* Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
+
+    /* Size of the cache of the gradient color and opacity maps [bytes].
+     * A map costs about 4 bytes per pixel of the gradient's width (or height if vertical).
+     * 0: recalculate the maps for every draw task */
+    #define LV_DRAW_SW_GRADIENT_CACHE_SIZE  (4 * 1024U)
 #endif
 
 /* Use NXP's VG-Lite GPU on iMX RTxxx platforms. */
@@ -361,13 +389,19 @@
 
 /*Default cache size in bytes.
  *Used by image decoders such as `lv_lodepng` to keep the decoded image in the memory.
- *If size is not set to 0, the decoder will fail to decode when the cache is full.
+ *The image with the lowest decode time per byte is evicted first (see `lv_image_cache_set_class()`).
+ *The decoder fails only if the cache is full of images in use or pinned with `lv_image_cache_pin()`.
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
-#define LV_CACHE_DEF_SIZE       0
+#define LV_CACHE_DEF_SIZE       (2 * 1024 * 1024U)
 
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 16
+
+/*1: decode the images of the `lv_image` widgets in a thread. A placeholder is drawn until they are in the image cache
+ *(see `lv_image_set_placeholder()`). Needs `LV_USE_OS` and the image cache.
+ *The images drawn directly from the memory (uncompressed C arrays) are not affected.*/
+#define LV_USE_IMAGE_DECODER_ASYNC 0
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -380,6 +414,17 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Cache the resolved style property values of each lv_obj_t per part and state.
+ * Set the number of cached values per object (power of 2, e.g. 32), 0 to disable.
+ * Costs 8 bytes per value on 32-bit targets (16 on 64-bit), allocated when the object's style is first read.
+ * Styles shared by several objects need `lv_obj_report_style_change()` after a change. */
+#define LV_OBJ_STYLE_RESOLVED_CACHE 0
+
+/* Index the properties of the non-constant styles having at least this many properties
+ * in a small hash table so that they are found without scanning all of them.
+ * Costs 16..256 bytes per such style. 0: always scan the properties */
+#define LV_STYLE_PROP_INDEX_MIN 8
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -529,6 +574,16 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the cache of ready-to-blend (A8) glyphs of `lv_font_fmt_txt` fonts in bytes.
+ *Saves expanding (1, 2, 4 bpp) or decompressing the same glyphs on every redraw.
+ *0: no cache, the glyphs are decoded every time they are drawn*/
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE (8 * 1024U)
+
+/*1: Look up the glyph ids of ASCII and Latin-1 in a table and the kerning pairs in a hash table.
+ *The tables are built on the first use of an `lv_font_fmt_txt` font (~530 bytes + ~10 bytes per kerning pair)
+ *and make measuring and wrapping long texts cheaper.*/
+#define LV_FONT_FMT_TXT_ACCEL 1
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
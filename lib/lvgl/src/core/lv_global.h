@@ -31,7 +31,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0 || LV_FONT_FMT_TXT_ACCEL
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -44,9 +44,11 @@ extern "C" {
 #include "../misc/lv_anim_private.h"
 #include "../tick/lv_tick_private.h"
 #include "../draw/lv_draw_buf_private.h"
+#include "../draw/lv_image_decoder_private.h"
 #include "../draw/lv_draw_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
+#include "../draw/sw/lv_draw_sw_gradient_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../layouts/lv_layout_private.h"
@@ -89,6 +91,13 @@ typedef struct lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    uint32_t style_resolved_gen;        /**< Incremented on every style change to invalidate the resolved values*/
+    uint32_t style_resolved_cnt;        /**< Number of objects with a resolved value cache*/
+    uint32_t style_resolved_hits;
+    uint32_t style_resolved_misses;
+    bool style_resolved_disabled;
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -120,13 +129,19 @@ typedef struct lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_t img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
 #endif
-#if LV_DRAW_SW_COMPLEX
-    lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    lv_draw_sw_mask_circle_cache_t sw_circle_cache;
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    lv_draw_sw_gradient_cache_t sw_grad_cache;
 #endif
 
 #if LV_USE_LOG
@@ -189,6 +204,14 @@ typedef struct lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    lv_font_fmt_txt_glyph_cache_t font_glyph_cache;
+#endif
+
+#if LV_FONT_FMT_TXT_ACCEL
+    lv_font_fmt_txt_accel_list_t font_fmt_txt_accel;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
@@ -379,7 +379,9 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     if(obj->spec_attr == NULL) {
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_OBJ);
         obj->spec_attr = lv_malloc_zeroed(sizeof(lv_obj_spec_attr_t));
+        LV_MEM_TAG_POP();
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -529,6 +531,8 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+    lv_obj_style_free_resolved(obj);
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_free(obj->spec_attr->children);
@@ -908,8 +912,12 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     lv_obj_invalidate(obj);
 
     obj->state = new_state;
+    /*The children might inherit other values now*/
+    lv_obj_style_invalidate_resolved_obj(obj);
     lv_obj_update_layer_type(obj);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
+    LV_MEM_TAG_POP();
     uint32_t tsi = 0;
     uint32_t i;
     for(i = 0; i < obj->style_cnt && tsi < STYLE_TRANSITION_MAX; i++) {
@@ -48,7 +48,9 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_OBJ);
     lv_obj_t * obj = lv_malloc_zeroed(s);
+    LV_MEM_TAG_POP();
     if(obj == NULL) return NULL;
     obj->class_p = class_p;
     obj->parent = parent;
@@ -67,7 +69,9 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             disp->screen_cnt = 0;
         }
 
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_OBJ);
         lv_obj_t ** screens = lv_realloc(disp->screens, sizeof(lv_obj_t *) * (disp->screen_cnt + 1));
+        LV_MEM_TAG_POP();
         LV_ASSERT_MALLOC(screens);
         if(screens == NULL) {
             lv_free(obj);
@@ -93,8 +97,10 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         }
 
         parent->spec_attr->child_cnt++;
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_OBJ);
         parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
                                                  sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
+        LV_MEM_TAG_POP();
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
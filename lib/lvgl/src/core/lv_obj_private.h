@@ -54,6 +54,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_cache_t * style_resolved_cache; /**< Allocated on the first style read*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
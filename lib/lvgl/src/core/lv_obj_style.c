@@ -24,6 +24,17 @@
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    #if LV_OBJ_STYLE_RESOLVED_CACHE & (LV_OBJ_STYLE_RESOLVED_CACHE - 1)
+        #error "LV_OBJ_STYLE_RESOLVED_CACHE must be a power of 2"
+    #endif
+    #define resolved_gen LV_GLOBAL_DEFAULT()->style_resolved_gen
+    #define resolved_cnt LV_GLOBAL_DEFAULT()->style_resolved_cnt
+    #define resolved_hits LV_GLOBAL_DEFAULT()->style_resolved_hits
+    #define resolved_misses LV_GLOBAL_DEFAULT()->style_resolved_misses
+    #define resolved_disabled LV_GLOBAL_DEFAULT()->style_resolved_disabled
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -68,6 +79,9 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    static lv_obj_style_resolved_t * get_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -123,7 +137,9 @@ void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selecto
     /*Allocate space for the new style and shift the rest of the style to the end*/
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    LV_MEM_TAG_POP();
     LV_ASSERT_MALLOC(obj->styles);
 
     uint32_t j;
@@ -240,7 +256,9 @@ void lv_obj_remove_style(lv_obj_t * obj, const lv_style_t * style, lv_style_sele
         }
 
         obj->style_cnt--;
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
         obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+        LV_MEM_TAG_POP();
 
         deleted = true;
         /*The style from the current `i` index is removed, so `i` points to the next style.
@@ -260,6 +278,8 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    lv_obj_style_invalidate_resolved();
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -276,6 +296,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Even if not refreshed, the cached values are wrong from now*/
+    lv_obj_style_invalidate_resolved_obj(obj);
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -323,18 +346,105 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+void lv_obj_style_enable_resolved_cache(bool en)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    resolved_disabled = !en;
+    lv_obj_style_invalidate_resolved();
+#else
+    LV_UNUSED(en);
+#endif
+}
+
+void lv_obj_style_get_resolved_stats(lv_obj_style_resolved_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_obj_style_resolved_stats_t));
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    stats->hits = resolved_hits;
+    stats->misses = resolved_misses;
+    stats->size = resolved_cnt * sizeof(lv_obj_style_resolved_cache_t);
+#endif
+}
+
+void lv_obj_style_reset_resolved_stats(void)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    resolved_hits = 0;
+    resolved_misses = 0;
+#endif
+}
+
+void lv_obj_style_invalidate_resolved(void)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    resolved_gen++;
+#endif
+}
+
+void lv_obj_style_invalidate_resolved_obj(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*An outdated cache is dropped anyway on the next global invalidation*/
+    lv_obj_style_resolved_cache_t * cache = obj->style_resolved_cache;
+    if(cache && cache->gen == resolved_gen) {
+        lv_memzero(cache->values, sizeof(cache->values));
+    }
+
+    /*The children can inherit the changed values*/
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_invalidate_resolved_obj(obj->spec_attr->children[i]);
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+void lv_obj_style_free_resolved(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    if(obj->style_resolved_cache == NULL) return;
+
+    lv_free(obj->style_resolved_cache);
+    obj->style_resolved_cache = NULL;
+    resolved_cnt--;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     LV_ASSERT_NULL(obj)
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_t * resolved = get_resolved(obj, part, prop);
+    if(resolved && resolved->prop == prop && resolved->part == part >> 16 && resolved->state == obj->state) {
+        resolved_hits++;
+        return resolved->value;
+    }
+#endif
+
     lv_style_selector_t selector = part | obj->state;
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    if(resolved) {
+        resolved_misses++;
+        resolved->value = value_act;
+        resolved->state = obj->state;
+        resolved->prop = prop;
+        resolved->part = part >> 16;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -641,7 +751,9 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
 
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    LV_MEM_TAG_POP();
     LV_ASSERT_MALLOC(obj->styles);
 
     for(i = obj->style_cnt - 1; i > 0 ; i--) {
@@ -652,7 +764,9 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     }
 
     lv_memzero(&obj->styles[i], sizeof(lv_obj_style_t));
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     obj->styles[i].style = lv_malloc(sizeof(lv_style_t));
+    LV_MEM_TAG_POP();
     lv_style_init((lv_style_t *)obj->styles[i].style);
 
     obj->styles[i].is_local = 1;
@@ -679,14 +793,18 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    LV_MEM_TAG_POP();
 
     for(i = obj->style_cnt - 1; i > 0 ; i--) {
         obj->styles[i] = obj->styles[i - 1];
     }
 
     lv_memzero(&obj->styles[0], sizeof(lv_obj_style_t));
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
     obj->styles[0].style = lv_malloc(sizeof(lv_style_t));
+    LV_MEM_TAG_POP();
     lv_style_init((lv_style_t *)obj->styles[0].style);
 
     obj->styles[0].is_trans = 1;
@@ -825,6 +943,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
             lv_ll_remove(style_trans_ll_p, tr);
             lv_free(tr);
             removed = true;
+            lv_obj_style_invalidate_resolved_obj(obj);
 
         }
         tr = tr_prev;
@@ -946,6 +1065,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                lv_obj_style_invalidate_resolved_obj(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1124,3 +1244,40 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * Get the slot of a property in the resolved value cache of an object.
+ * The cache is allocated on the first call and cleared if any style changed since its last use.
+ * @param obj       pointer to an object
+ * @param part      the part of the object
+ * @param prop      the property
+ * @return          the slot. It stores the value of this property only if `prop`, `part` and `state` match.
+ *                  NULL if the cache can't be used.
+ */
+static lv_obj_style_resolved_t * get_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    /*The transitions are skipped only temporarily, e.g. to compare states*/
+    if(resolved_disabled || obj->skip_trans) return NULL;
+
+    lv_obj_t * obj_mut = (lv_obj_t *)obj;
+    lv_obj_style_resolved_cache_t * cache = obj_mut->style_resolved_cache;
+    if(cache == NULL) {
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
+        cache = lv_malloc(sizeof(lv_obj_style_resolved_cache_t));
+        LV_MEM_TAG_POP();
+        if(cache == NULL) return NULL;
+        cache->gen = resolved_gen - 1;
+        obj_mut->style_resolved_cache = cache;
+        resolved_cnt++;
+    }
+
+    if(cache->gen != resolved_gen) {
+        lv_memzero(cache->values, sizeof(cache->values));
+        cache->gen = resolved_gen;
+    }
+
+    uint32_t i = ((uint32_t)prop + (part >> 16) * 37 + (uint32_t)obj->state * 11) & (LV_OBJ_STYLE_RESOLVED_CACHE - 1);
+    return &cache->values[i];
+}
+#endif
@@ -34,6 +34,13 @@ typedef enum {
 
 typedef uint32_t lv_style_selector_t;
 
+/** Counters of the resolved style value cache (see `LV_OBJ_STYLE_RESOLVED_CACHE`) */
+typedef struct {
+    uint32_t hits;      /**< Style reads served from the cache*/
+    uint32_t misses;    /**< Style reads which had to search the styles*/
+    uint32_t size;      /**< Bytes allocated for the caches of the objects*/
+} lv_obj_style_resolved_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -117,6 +124,24 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
  */
 void lv_obj_enable_style_refresh(bool en);
 
+/**
+ * Enable or disable the resolved style value cache (`LV_OBJ_STYLE_RESOLVED_CACHE`) at runtime,
+ * e.g. to compare the performance. It's enabled by default if `LV_OBJ_STYLE_RESOLVED_CACHE > 0`.
+ * @param en        true: use the cache; false: always search the styles
+ */
+void lv_obj_style_enable_resolved_cache(bool en);
+
+/**
+ * Get the counters of the resolved style value cache
+ * @param stats     store the counters here
+ */
+void lv_obj_style_get_resolved_stats(lv_obj_style_resolved_stats_t * stats);
+
+/**
+ * Clear the hit and miss counters of the resolved style value cache
+ */
+void lv_obj_style_reset_resolved_stats(void);
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -40,6 +40,21 @@ struct lv_obj_style_transition_dsc_t {
     void * user_data;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+typedef struct {
+    lv_style_value_t value;
+    lv_state_t state;
+    lv_style_prop_t prop;       /**< `LV_STYLE_PROP_INV` if empty*/
+    uint8_t part;               /**< The part shifted to 0..15*/
+} lv_obj_style_resolved_t;
+
+/** Resolved values of an object's style properties. Direct mapped by property, part and state.*/
+struct lv_obj_style_resolved_cache_t {
+    uint32_t gen;               /**< Valid only if equal to the global generation*/
+    lv_obj_style_resolved_t values[LV_OBJ_STYLE_RESOLVED_CACHE];
+};
+#endif
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -84,6 +99,25 @@ lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state
  */
 void lv_obj_update_layer_type(lv_obj_t * obj);
 
+/**
+ * Invalidate the resolved style values of all objects.
+ * Called internally when anything changes that can change a style value, e.g. a state or a parent.
+ */
+void lv_obj_style_invalidate_resolved(void);
+
+/**
+ * Invalidate the resolved style values of an object and its children.
+ * Used when only a part of the tree can change, e.g. the state of an object.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_invalidate_resolved_obj(lv_obj_t * obj);
+
+/**
+ * Free the resolved style values of an object. Called when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_free_resolved(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
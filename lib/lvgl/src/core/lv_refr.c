@@ -40,6 +40,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static void inv_area_merge_nearest(lv_display_t * disp, const lv_area_t * area_p);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
@@ -315,14 +316,26 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*Drop the saved areas covered by the new one*/
+    i = 0;
+    while(i < disp->inv_p) {
+        if(lv_area_is_in(&disp->inv_areas[i], &com_area, 0)) {
+            disp->inv_p--;
+            disp->inv_areas[i] = disp->inv_areas[disp->inv_p];
+        }
+        else {
+            i++;
+        }
+    }
+
+    /*Save the area. If there is no place for it, grow the nearest saved area to cover it*/
+    if(disp->inv_p >= LV_INV_BUF_SIZE) {
+        inv_area_merge_nearest(disp, &com_area);
+    }
+    else {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
@@ -436,7 +449,8 @@ refr_finish:
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas whose bounding box is cheaper to refresh than the two areas separately.
+ * Joining makes an area larger so it's repeated until there is nothing to join.
  */
 static void lv_refr_join_area(void)
 {
@@ -444,36 +458,62 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
-
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+    bool joined;
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                /*Join two area only if the joined area costs less than refreshing both.
+                 *Areas not touching each other can be joined only if LV_INV_AREA_COST > 0*/
+                if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
+                                                     lv_area_get_size(&disp_refr->inv_areas[join_from]) + LV_INV_AREA_COST)) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
         }
-    }
+    } while(joined);
     LV_PROFILER_END;
 }
 
+/**
+ * Add an area when the invalid area buffer is full: grow the saved area
+ * which needs the fewest extra pixels to cover it too.
+ * This way clusters of small areas become their bounding boxes instead of the whole screen.
+ * @param disp      pointer to a display whose `inv_areas` is full
+ * @param area_p    the area to add
+ */
+static void inv_area_merge_nearest(lv_display_t * disp, const lv_area_t * area_p)
+{
+    uint32_t best = 0;
+    uint32_t best_extra = UINT32_MAX;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t joined_area;
+        lv_area_join(&joined_area, &disp->inv_areas[i], area_p);
+        uint32_t extra = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+        if(extra < best_extra) {
+            best_extra = extra;
+            best = i;
+        }
+    }
+
+    lv_area_join(&disp->inv_areas[best], &disp->inv_areas[best], area_p);
+}
+
 /**
  * Refresh the sync areas
  */
@@ -29,6 +29,15 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_INV_AREA_COST
+/**
+ * Overhead of refreshing one more area (rendering pass and flush) expressed in pixels.
+ * Two invalid areas are refreshed as their bounding box if it has fewer pixels than the two areas
+ * plus this cost, so larger values trade some overdraw for fewer areas.
+ */
+#define LV_INV_AREA_COST 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
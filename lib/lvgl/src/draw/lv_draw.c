@@ -23,14 +23,34 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*Size of the grid used to find the draw tasks which might overlap. Each task has one bit for each bin in a uint64_t*/
+#define BIN_COL_CNT 8
+#define BIN_ROW_CNT 8
+
+/*Blocks allocated at once when a size class of the pool runs out*/
+#define POOL_CHUNK_BLOCK_CNT 16
+/*Class ID of blocks too large for the pool, they are allocated with `lv_malloc`*/
+#define POOL_CLASS_HEAP 0xFF
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Placed before each block of the pool*/
+typedef union pool_hdr_t {
+    union pool_hdr_t * next;    /*Next free block while in the free list, next chunk in a chunk's header*/
+    uint32_t class_id;          /*Size class while the block is used*/
+    uint64_t align;             /*Keep the blocks 8 bytes aligned*/
+} pool_hdr_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void bins_init(lv_layer_t * layer);
+static uint64_t get_bin_mask(const lv_layer_t * layer, const lv_area_t * area);
+static inline void task_taken(lv_layer_t * layer, lv_draw_task_t * t);
+static bool pool_add_chunk(uint32_t class_id);
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -74,6 +94,16 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+    pool_hdr_t * chunk = _draw_info.pool_chunk_head;
+    while(chunk) {
+        pool_hdr_t * chunk_next = chunk->next;
+        lv_free(chunk);
+        chunk = chunk_next;
+    }
+    _draw_info.pool_chunk_head = NULL;
+    lv_memzero(_draw_info.pool_free_head, sizeof(_draw_info.pool_free_head));
+    lv_memzero(&_draw_info.pool_stats, sizeof(_draw_info.pool_stats));
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -90,7 +120,8 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+    lv_draw_task_t * new_task = lv_draw_pool_alloc(sizeof(lv_draw_task_t));
+    lv_memzero(new_task, sizeof(lv_draw_task_t));
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -100,16 +131,21 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 #endif
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
+    /*The real area is known only in `lv_draw_finalize_task_creation`, until that assume that it covers everything*/
+    new_task->bin_mask = UINT64_MAX;
+    new_task->bin_overlap = 1;
+
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
+        layer->draw_task_seq = 0;
+        layer->draw_task_taken_seq = 0;
+        bins_init(layer);
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        layer->draw_task_tail->next = new_task;
     }
+    layer->draw_task_tail = new_task;
+    new_task->seq = ++layer->draw_task_seq;
 
     LV_PROFILER_END;
     return new_task;
@@ -144,6 +180,8 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             u = u->next;
         }
 
+        t->bin_mask = get_bin_mask(layer, &t->_real_area);
+
         lv_draw_dispatch();
     }
     else {
@@ -155,6 +193,8 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             if(u->evaluate_cb) u->evaluate_cb(u, t);
             u = u->next;
         }
+
+        t->bin_mask = get_bin_mask(layer, &t->_real_area);
     }
     LV_PROFILER_END;
 }
@@ -195,10 +235,16 @@ void lv_draw_dispatch(void)
 bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
-    /*Remove the finished tasks first*/
+    /*Remove the finished tasks first.
+     *Meanwhile collect the bins used by the remaining tasks to see which tasks might depend on older ones.
+     *Tasks newer than the last one handed to a draw unit can't be ready, and once all bins are used
+     *their `bin_overlap` can't change either, so the rest of the list can be skipped.*/
+    uint64_t bins_used = 0;
     lv_draw_task_t * t_prev = NULL;
     lv_draw_task_t * t = layer->draw_task_head;
     while(t) {
+        if(t->seq > layer->draw_task_taken_seq && bins_used == UINT64_MAX) break;
+
         lv_draw_task_t * t_next = t->next;
         if(t->state == LV_DRAW_TASK_STATE_READY) {
             if(t_prev) t_prev->next = t->next;      /*Remove it by assigning the next task to the previous*/
@@ -240,14 +286,17 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 draw_label_dsc->text = NULL;
             }
 
-            lv_free(t->draw_dsc);
-            lv_free(t);
+            lv_draw_pool_free(t->draw_dsc);
+            lv_draw_pool_free(t);
         }
         else {
+            t->bin_overlap = (t->bin_mask & bins_used) ? 1 : 0;
+            bins_used |= t->bin_mask;
             t_prev = t;
         }
         t = t_next;
     }
+    if(t == NULL) layer->draw_task_tail = t_prev;
 
     bool task_dispatched = false;
 
@@ -327,6 +376,7 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
                t->preferred_draw_unit_id != LV_DRAW_UNIT_NONE &&
                t->preferred_draw_unit_id != draw_unit_id) {
                 t->state = LV_DRAW_TASK_STATE_READY;
+                task_taken(layer, t);
             }
             /*Not queued yet, leave this layer while the first task will be queued*/
             else if(t->state != LV_DRAW_TASK_STATE_QUEUED) {
@@ -335,6 +385,7 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
             }
             /*It's a supported and queued task, process it*/
             else {
+                task_taken(layer, t);
                 break;
             }
             t = t->next;
@@ -360,10 +411,11 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 
     lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
     while(t) {
-        /*Find a queued and independent task*/
+        /*Find a queued and independent task. If no older task shares a bin with it, it's surely independent*/
         if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
            (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
+           (t->bin_overlap == 0 || is_independent(layer, t))) {
+            task_taken(layer, t);
             LV_PROFILER_END;
             return t;
         }
@@ -395,10 +447,77 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
     return cnt;
 }
 
+void * lv_draw_pool_alloc(size_t size)
+{
+    lv_draw_pool_stats_t * stats = &_draw_info.pool_stats;
+    pool_hdr_t * hdr;
+
+    uint32_t class_id = size == 0 ? 0 : (uint32_t)((size - 1) / LV_DRAW_POOL_CLASS_STEP);
+    if(class_id >= LV_DRAW_POOL_CLASS_CNT) {
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_DRAW);
+        hdr = lv_malloc(sizeof(pool_hdr_t) + size);
+        LV_MEM_TAG_POP();
+        LV_ASSERT_MALLOC(hdr);
+        if(hdr == NULL) return NULL;
+
+        stats->heap_alloc_cnt++;
+        hdr->class_id = POOL_CLASS_HEAP;
+        return hdr + 1;
+    }
+
+    if(_draw_info.pool_free_head[class_id] == NULL) {
+        if(!pool_add_chunk(class_id)) return NULL;
+    }
+
+    hdr = _draw_info.pool_free_head[class_id];
+    _draw_info.pool_free_head[class_id] = hdr->next;
+    hdr->class_id = class_id;
+
+    stats->pool_alloc_cnt++;
+    stats->used_cnt++;
+    return hdr + 1;
+}
+
+void lv_draw_pool_free(void * p)
+{
+    if(p == NULL) return;
+
+    lv_draw_pool_stats_t * stats = &_draw_info.pool_stats;
+    pool_hdr_t * hdr = (pool_hdr_t *)p - 1;
+    if(hdr->class_id == POOL_CLASS_HEAP) {
+        lv_free(hdr);
+        stats->heap_free_cnt++;
+        return;
+    }
+
+    uint32_t class_id = hdr->class_id;
+    hdr->next = _draw_info.pool_free_head[class_id];
+    _draw_info.pool_free_head[class_id] = hdr;
+
+    stats->pool_free_cnt++;
+    stats->used_cnt--;
+}
+
+void lv_draw_get_pool_stats(lv_draw_pool_stats_t * stats)
+{
+    *stats = _draw_info.pool_stats;
+}
+
+void lv_draw_reset_pool_stats(void)
+{
+    lv_draw_pool_stats_t * stats = &_draw_info.pool_stats;
+    stats->heap_alloc_cnt = 0;
+    stats->heap_free_cnt = 0;
+    stats->pool_alloc_cnt = 0;
+    stats->pool_free_cnt = 0;
+}
+
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
 {
     lv_display_t * disp = lv_refr_get_disp_refreshing();
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_DRAW);
     lv_layer_t * new_layer = lv_malloc_zeroed(sizeof(lv_layer_t));
+    LV_MEM_TAG_POP();
     LV_ASSERT_MALLOC(new_layer);
     if(new_layer == NULL) return NULL;
 
@@ -436,7 +555,9 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     int32_t h = lv_area_get_height(&layer->buf_area);
     uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer->color_format);
 
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_DRAW);
     layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+    LV_MEM_TAG_POP();
 
     if(layer->draw_buf == NULL) {
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
@@ -490,7 +611,7 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 
     /*If t_check is outside of the older tasks then it's independent*/
     while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
+        if((t->bin_mask & t_check->bin_mask) && t->state != LV_DRAW_TASK_STATE_READY) {
             lv_area_t a;
             if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
                 LV_PROFILER_END;
@@ -503,3 +624,81 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 
     return true;
 }
+
+/**
+ * Place the bin grid on the buffer of the layer.
+ * Called when the first task is added so it doesn't change while the layer has draw tasks.
+ * @param layer     pointer to a layer
+ */
+static void bins_init(lv_layer_t * layer)
+{
+    layer->bin_x0 = layer->buf_area.x1;
+    layer->bin_y0 = layer->buf_area.y1;
+    layer->bin_w = LV_MAX((lv_area_get_width(&layer->buf_area) + BIN_COL_CNT - 1) / BIN_COL_CNT, 1);
+    layer->bin_h = LV_MAX((lv_area_get_height(&layer->buf_area) + BIN_ROW_CNT - 1) / BIN_ROW_CNT, 1);
+}
+
+/**
+ * Get the bins covered by an area. Areas out of the buffer are clamped to the edge bins
+ * so overlapping areas always have at least one common bin.
+ * @param layer     pointer to a layer
+ * @param area      an area in absolute coordinates
+ * @return          one bit for each covered bin
+ */
+static uint64_t get_bin_mask(const lv_layer_t * layer, const lv_area_t * area)
+{
+    int32_t col1 = LV_CLAMP(0, (area->x1 - layer->bin_x0) / layer->bin_w, BIN_COL_CNT - 1);
+    int32_t col2 = LV_CLAMP(0, (area->x2 - layer->bin_x0) / layer->bin_w, BIN_COL_CNT - 1);
+    int32_t row1 = LV_CLAMP(0, (area->y1 - layer->bin_y0) / layer->bin_h, BIN_ROW_CNT - 1);
+    int32_t row2 = LV_CLAMP(0, (area->y2 - layer->bin_y0) / layer->bin_h, BIN_ROW_CNT - 1);
+
+    uint64_t row_mask = ((((uint64_t)1) << (col2 - col1 + 1)) - 1) << col1;
+    uint64_t mask = 0;
+    int32_t row;
+    for(row = row1; row <= row2; row++) {
+        mask |= row_mask << (row * BIN_COL_CNT);
+    }
+
+    return mask;
+}
+
+/**
+ * Remember that a draw unit got this task so it can become ready
+ * @param layer     the layer of the task
+ * @param t         the draw task handed to a draw unit
+ */
+static inline void task_taken(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(t->seq > layer->draw_task_taken_seq) layer->draw_task_taken_seq = t->seq;
+}
+
+/**
+ * Allocate a chunk of blocks for a size class and put them to its free list
+ * @param class_id  index of the size class
+ * @return          false: out of memory
+ */
+static bool pool_add_chunk(uint32_t class_id)
+{
+    size_t block_size = sizeof(pool_hdr_t) + (class_id + 1) * LV_DRAW_POOL_CLASS_STEP;
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_DRAW);
+    pool_hdr_t * chunk = lv_malloc(sizeof(pool_hdr_t) + POOL_CHUNK_BLOCK_CNT * block_size);
+    LV_MEM_TAG_POP();
+    LV_ASSERT_MALLOC(chunk);
+    if(chunk == NULL) return false;
+
+    chunk->next = _draw_info.pool_chunk_head;
+    _draw_info.pool_chunk_head = chunk;
+
+    uint8_t * block = (uint8_t *)(chunk + 1);
+    uint32_t i;
+    for(i = 0; i < POOL_CHUNK_BLOCK_CNT; i++) {
+        pool_hdr_t * hdr = (pool_hdr_t *)block;
+        hdr->next = _draw_info.pool_free_head[class_id];
+        _draw_info.pool_free_head[class_id] = hdr;
+        block += block_size;
+    }
+
+    _draw_info.pool_stats.heap_alloc_cnt++;
+    _draw_info.pool_stats.block_cnt += POOL_CHUNK_BLOCK_CNT;
+    return true;
+}
@@ -101,12 +101,38 @@ struct lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** Last draw task of the list to append new tasks without walking the list */
+    lv_draw_task_t * draw_task_tail;
+
+    /** Origin and size of a bin of the grid used to quickly find overlapping draw tasks.
+     *  Set from `buf_area` when the first draw task is added to an empty layer.*/
+    int32_t bin_x0;
+    int32_t bin_y0;
+    int32_t bin_w;
+    int32_t bin_h;
+
+    /** Sequence number of the last added draw task */
+    uint32_t draw_task_seq;
+
+    /** Highest sequence number handed out to a draw unit. Newer tasks can't be ready yet. */
+    uint32_t draw_task_taken_seq;
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
     void * user_data;
 };
 
+/** Counters of the draw task and draw descriptor pool */
+typedef struct {
+    uint32_t heap_alloc_cnt;    /**< Number of `lv_malloc` calls of the pool (new chunks and too large blocks) */
+    uint32_t heap_free_cnt;     /**< Number of `lv_free` calls of the pool */
+    uint32_t pool_alloc_cnt;    /**< Number of blocks taken from the pool */
+    uint32_t pool_free_cnt;     /**< Number of blocks given back to the pool */
+    uint32_t used_cnt;          /**< Blocks in use now */
+    uint32_t block_cnt;         /**< Blocks allocated in chunks, used or free */
+} lv_draw_pool_stats_t;
+
 typedef struct {
     lv_obj_t * obj;
     lv_part_t part;
@@ -211,6 +237,18 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
  */
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check);
 
+/**
+ * Get the counters of the pool used for draw tasks and draw descriptors.
+ * Once the pool has grown to the largest frame `heap_alloc_cnt` and `heap_free_cnt` stop changing.
+ * @param stats     store the counters here
+ */
+void lv_draw_get_pool_stats(lv_draw_pool_stats_t * stats);
+
+/**
+ * Clear the alloc/free counters of the pool. `used_cnt` and `block_cnt` are kept.
+ */
+void lv_draw_reset_pool_stats(void);
+
 /**
  * Create a new layer on a parent layer
  * @param parent_layer      the parent layer to which the layer will be merged when it's rendered
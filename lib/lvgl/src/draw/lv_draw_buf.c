@@ -28,6 +28,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void * buf_malloc(size_t size, lv_color_format_t color_format);
+static void * font_buf_malloc(size_t size, lv_color_format_t color_format);
 static void buf_free(void * buf);
 static void * buf_align(void * buf, lv_color_format_t color_format);
 static void * draw_buf_malloc(const lv_draw_buf_handlers_t * handler, size_t size_bytes,
@@ -52,8 +53,11 @@ static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * f
 void lv_draw_buf_init_handlers(void)
 {
     lv_draw_buf_init_with_default_handlers(&default_handlers);
-    lv_draw_buf_init_with_default_handlers(&font_draw_buf_handlers);
     lv_draw_buf_init_with_default_handlers(&image_cache_draw_buf_handlers);
+
+    /*The glyph bitmaps are small and short lived, keep them in the fast heap*/
+    lv_draw_buf_handlers_init(&font_draw_buf_handlers, font_buf_malloc, buf_free, buf_align, NULL, NULL,
+                              width_to_stride);
 }
 
 void lv_draw_buf_init_with_default_handlers(lv_draw_buf_handlers_t * handlers)
@@ -599,6 +603,14 @@ static void * buf_malloc(size_t size_bytes, lv_color_format_t color_format)
     LV_UNUSED(color_format);
 
     /*Allocate larger memory to be sure it can be aligned as needed*/
+    size_bytes += LV_DRAW_BUF_ALIGN - 1;
+    return lv_malloc_heap(size_bytes, LV_MEM_HEAP_BULK);
+}
+
+static void * font_buf_malloc(size_t size_bytes, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+
     size_bytes += LV_DRAW_BUF_ALIGN - 1;
     return lv_malloc(size_bytes);
 }
@@ -24,6 +24,10 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Draw tasks and descriptors are pooled in size classes of this step, larger ones come from `lv_malloc`*/
+#define LV_DRAW_POOL_CLASS_STEP     32
+#define LV_DRAW_POOL_CLASS_CNT      8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -75,6 +79,28 @@ struct lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * Bins of the layer's grid covered by `_real_area`. One bit per bin.
+     */
+    uint64_t bin_mask;
+
+    /**
+     * 1: an older, not removed draw task covers a bin of this task too, so the areas need to be checked.
+     * 0: no older task can overlap this one.
+     * Updated when the finished tasks are removed in `lv_draw_dispatch_layer`.
+     */
+    uint8_t bin_overlap;
+
+    /**
+     * Increasing number in the order of adding the tasks to the layer
+     */
+    uint32_t seq;
+
+    /**
+     * Number of draw units still rendering a band of this task. 0: the task is not split.
+     */
+    volatile int split_cnt;
+
 };
 
 struct lv_draw_mask_t {
@@ -178,13 +204,35 @@ typedef struct {
     int dispatch_req;
 #endif
     lv_mutex_t circle_cache_mutex;
+    lv_mutex_t split_mutex;
     bool task_running;
+
+    /** Free blocks of each size class of the pool */
+    void * pool_free_head[LV_DRAW_POOL_CLASS_CNT];
+    /** Chunks allocated by the pool, freed only in `lv_draw_deinit` */
+    void * pool_chunk_head;
+    lv_draw_pool_stats_t pool_stats;
 } lv_draw_global_info_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Allocate a draw task or draw descriptor from the pool.
+ * Blocks are reused after `lv_draw_pool_free` so a steady stream of frames doesn't touch the heap.
+ * Only the LVGL thread should call it, same as the draw functions.
+ * @param size      size in bytes
+ * @return          pointer to the allocated memory (not zeroed) or NULL if out of memory
+ */
+void * lv_draw_pool_alloc(size_t size);
+
+/**
+ * Give back a block allocated with `lv_draw_pool_alloc`
+ * @param p         pointer to the block, NULL is ignored
+ */
+void lv_draw_pool_free(void * p);
+
 /**********************
  *      MACROS
  **********************/
@@ -20,6 +20,10 @@
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define img_decoder_async_p (&LV_GLOBAL_DEFAULT()->img_decoder_async)
+
+/*Period of the timer calling the `ready_cb`s while images are being decoded [ms]*/
+#define ASYNC_NOTIFY_PERIOD 10
 
 /**********************
  *      TYPEDEFS
@@ -40,6 +44,20 @@ static uint32_t img_width_to_stride(lv_image_header_t * header);
 static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
 
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
+static bool src_is_direct(const void * src, lv_image_src_t src_type);
+
+#if LV_IMAGE_DECODER_ASYNC
+static bool async_is_cached(const lv_image_decoder_async_req_t * req);
+static lv_image_decoder_async_req_t * async_find(const void * src, lv_image_src_t src_type);
+static bool async_add_waiter(lv_image_decoder_async_req_t * req, lv_image_decoder_async_cb_t ready_cb,
+                             void * user_data);
+static void async_queue(lv_image_decoder_async_req_t * req);
+static void async_remove(lv_image_decoder_async_req_t * req);
+static bool async_start(void);
+static void async_stop(void);
+static void async_thread_cb(void * user_data);
+static void async_notify_timer_cb(lv_timer_t * timer);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -70,6 +88,9 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_IMAGE_DECODER_ASYNC
+    async_stop();
+#endif
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
@@ -109,7 +130,9 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
     }
 
     /*Find the decoder that can open the image source, and get the header info in the same time.*/
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_IMAGE);
     dsc->decoder = image_decoder_get_info(dsc, &dsc->header);
+    LV_MEM_TAG_POP();
     if(dsc->decoder == NULL) return LV_RESULT_INVALID;
 
     /*Make a copy of args*/
@@ -126,7 +149,19 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
      * If decoder open failed, free the source and return error.
      * If decoder open succeed, add the image to cache if enabled.
      * */
+    uint32_t t_start = lv_tick_get();
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_IMAGE);
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
+    LV_MEM_TAG_POP();
+
+    /*A new cache entry: weigh it with its decode time in ms, +1 so that the fast decodes count too*/
+    if(res == LV_RESULT_OK && dsc->cache && dsc->cache_entry) {
+        lv_cache_set_entry_cost(dsc->cache, dsc->cache_entry, lv_tick_elaps(t_start) + 1, NULL);
+
+        /*The entry may have been added by an other thread meanwhile, then its image is used*/
+        lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(dsc->cache_entry);
+        dsc->decoded = cached_data->decoded;
+    }
 
     /* Flush the D-Cache if enabled and the image was successfully opened */
     if(dsc->args.flush_cache && res == LV_RESULT_OK && dsc->decoded != NULL) {
@@ -218,25 +253,169 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data)
 {
-    lv_cache_entry_t * cache_entry = lv_cache_add(img_cache_p, search_key, NULL);
-    if(cache_entry == NULL) {
-        return NULL;
+    /*The entry is complete when it's added: an other thread can find it right after*/
+    lv_image_cache_data_t cache_data = *search_key;
+    cache_data.decoded = decoded;
+    cache_data.user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
+    cache_data.decoder = decoder;
+    if(cache_data.src_type == LV_IMAGE_SRC_FILE) {
+        cache_data.src = lv_strdup(search_key->src);
+        if(cache_data.src == NULL) return NULL;
     }
 
-    lv_image_cache_data_t * cached_data;
-    cached_data = lv_cache_entry_get_data(cache_entry);
+    lv_cache_entry_t * cache_entry = lv_cache_add(img_cache_p, &cache_data, NULL);
+    lv_image_cache_data_t * cached_data = cache_entry ? lv_cache_entry_get_data(cache_entry) : NULL;
 
-    /*Set the cache entry to decoder data*/
-    cached_data->decoded = decoded;
-    if(cached_data->src_type == LV_IMAGE_SRC_FILE) {
-        cached_data->src = lv_strdup(cached_data->src);
+    if(cached_data == NULL) {
+        /*Not added: the caller keeps the decoded image*/
+        if(cache_data.src_type == LV_IMAGE_SRC_FILE) lv_free((void *)cache_data.src);
+    }
+    else if(cached_data->decoded != decoded) {
+        /*Already added by an other thread (e.g. an other draw unit decoded the same image).
+         *The decoded image is owned by the cache from now on: free it like an evicted entry.*/
+        img_cache_p->ops.free_cb(&cache_data, NULL);
     }
-    cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
-    cached_data->decoder = decoder;
 
     return cache_entry;
 }
 
+bool lv_image_decoder_is_decoded(const void * src)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_type == LV_IMAGE_SRC_UNKNOWN) return false;
+    if(src_is_direct(src, src_type)) return true;
+    if(!lv_image_cache_is_enabled()) return false;
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = src_type;
+    search_key.src = src;
+
+    return lv_cache_contains(img_cache_p, &search_key, NULL);
+}
+
+#if LV_IMAGE_DECODER_ASYNC
+lv_result_t lv_image_decoder_open_async(const void * src, lv_image_decoder_async_cb_t ready_cb, void * user_data)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(src == NULL || async->disabled || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_is_direct(src, src_type)) return LV_RESULT_OK;
+
+    /*The thread is created with the first image to decode*/
+    if(!async->started && !async_start()) return LV_RESULT_OK;
+
+    lv_result_t res = LV_RESULT_INVALID;
+    lv_mutex_lock(&async->lock);
+
+    lv_image_decoder_async_req_t * req = async_find(src, src_type);
+    if(req == NULL) {
+        req = lv_malloc_zeroed(sizeof(lv_image_decoder_async_req_t));
+        LV_ASSERT_MALLOC(req);
+        if(req == NULL) {
+            lv_mutex_unlock(&async->lock);
+            return LV_RESULT_OK;
+        }
+
+        req->src_type = src_type;
+        req->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+        if(req->src == NULL) {
+            lv_free(req);
+            lv_mutex_unlock(&async->lock);
+            return LV_RESULT_OK;
+        }
+
+        lv_image_decoder_async_req_t ** tail = &async->reqs;
+        while(*tail) tail = &(*tail)->next;
+        *tail = req;
+
+        req->state = LV_IMAGE_DECODER_ASYNC_DONE;
+        if(async_is_cached(req)) {
+            req->cached = true;
+            res = LV_RESULT_OK;
+        }
+        else {
+            async_queue(req);
+        }
+    }
+    else if(req->state == LV_IMAGE_DECODER_ASYNC_DONE) {
+        /*Drawn directly (not cached) or still in the cache*/
+        if(!req->cached || async_is_cached(req)) res = LV_RESULT_OK;
+        else async_queue(req);
+    }
+
+    if(async_add_waiter(req, ready_cb, user_data) && res != LV_RESULT_OK && req->waiter_cnt > 1) {
+        async->stats.merged++;
+    }
+
+    lv_mutex_unlock(&async->lock);
+    return res;
+}
+
+void lv_image_decoder_cancel_async(const void * src, void * user_data)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(!async->started || src == NULL) return;
+
+    lv_mutex_lock(&async->lock);
+
+    lv_image_decoder_async_req_t * req = async_find(src, lv_image_src_get_type(src));
+    if(req) {
+        uint32_t i = 0;
+        while(i < req->waiter_cnt) {
+            if(req->waiters[i].user_data == user_data) {
+                req->waiter_cnt--;
+                req->waiters[i] = req->waiters[req->waiter_cnt];
+            }
+            else {
+                i++;
+            }
+        }
+
+        /*A running decoding can't be stopped, the thread drops the request at the end*/
+        if(req->waiter_cnt == 0 && req->state != LV_IMAGE_DECODER_ASYNC_RUNNING) {
+            if(req->state == LV_IMAGE_DECODER_ASYNC_QUEUED) {
+                async->stats.canceled++;
+                async->stats.pending--;
+            }
+            async_remove(req);
+        }
+    }
+
+    lv_mutex_unlock(&async->lock);
+}
+
+void lv_image_decoder_enable_async(bool en)
+{
+    img_decoder_async_p->disabled = !en;
+}
+
+void lv_image_decoder_get_async_stats(lv_image_decoder_async_stats_t * stats)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(!async->started) {
+        *stats = async->stats;
+        return;
+    }
+
+    lv_mutex_lock(&async->lock);
+    *stats = async->stats;
+    lv_mutex_unlock(&async->lock);
+}
+
+void lv_image_decoder_reset_async_stats(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(async->started) lv_mutex_lock(&async->lock);
+
+    uint32_t pending = async->stats.pending;
+    lv_memzero(&async->stats, sizeof(async->stats));
+    async->stats.pending = pending;
+
+    if(async->started) lv_mutex_unlock(&async->lock);
+}
+#endif /*LV_IMAGE_DECODER_ASYNC*/
+
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded)
 {
     if(decoded == NULL) return NULL; /*No need to adjust*/
@@ -372,11 +551,13 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         search_key.header = *header;
         entry = lv_cache_add(img_header_cache_p, &search_key, NULL);
 
-        if(entry == NULL) {
+        /*Not added or already added by an other thread*/
+        if(entry == NULL || ((lv_image_header_cache_data_t *)lv_cache_entry_get_data(entry))->src != search_key.src) {
             if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
-            return NULL;
         }
 
+        if(entry == NULL) return NULL;
+
         lv_cache_release(img_header_cache_p, entry, NULL);
     }
 
@@ -413,3 +594,238 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 
     return LV_RESULT_INVALID;
 }
+
+/**
+ * Check whether an image is drawn directly from the memory by the bin decoder,
+ * i.e. it's a symbol or a C array which is neither compressed nor in an other format (PNG, JPEG...)
+ */
+static bool src_is_direct(const void * src, lv_image_src_t src_type)
+{
+    if(src_type == LV_IMAGE_SRC_FILE) return false;
+    if(src_type != LV_IMAGE_SRC_VARIABLE) return true;
+
+    const lv_image_header_t * header = &((const lv_image_dsc_t *)src)->header;
+    if(header->cf == LV_COLOR_FORMAT_RAW || header->cf == LV_COLOR_FORMAT_RAW_ALPHA) return false;
+    if(header->flags & LV_IMAGE_FLAGS_COMPRESSED) return false;
+
+    return true;
+}
+
+#if LV_IMAGE_DECODER_ASYNC
+static bool async_is_cached(const lv_image_decoder_async_req_t * req)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = req->src_type;
+    search_key.src = req->src;
+
+    return lv_cache_contains(img_cache_p, &search_key, NULL);
+}
+
+static lv_image_decoder_async_req_t * async_find(const void * src, lv_image_src_t src_type)
+{
+    lv_image_decoder_async_req_t * req;
+    for(req = img_decoder_async_p->reqs; req; req = req->next) {
+        if(req->src_type != src_type) continue;
+        if(src_type == LV_IMAGE_SRC_FILE ? lv_strcmp(req->src, src) == 0 : req->src == src) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a waiter to a request if it's not waiting yet
+ * @return  true: added; false: it was already waiting or out of memory
+ */
+static bool async_add_waiter(lv_image_decoder_async_req_t * req, lv_image_decoder_async_cb_t ready_cb,
+                             void * user_data)
+{
+    uint32_t i;
+    for(i = 0; i < req->waiter_cnt; i++) {
+        if(req->waiters[i].ready_cb == ready_cb && req->waiters[i].user_data == user_data) return false;
+    }
+
+    lv_image_decoder_async_waiter_t * waiters = lv_realloc(req->waiters,
+                                                           (req->waiter_cnt + 1) * sizeof(lv_image_decoder_async_waiter_t));
+    LV_ASSERT_MALLOC(waiters);
+    if(waiters == NULL) return false;
+
+    req->waiters = waiters;
+    req->waiters[req->waiter_cnt].ready_cb = ready_cb;
+    req->waiters[req->waiter_cnt].user_data = user_data;
+    req->waiters[req->waiter_cnt].notify = false;
+    req->waiter_cnt++;
+    return true;
+}
+
+/**
+ * Queue a request for the thread. Called with the lock held in the LVGL thread.
+ */
+static void async_queue(lv_image_decoder_async_req_t * req)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+
+    req->state = LV_IMAGE_DECODER_ASYNC_QUEUED;
+    req->cached = false;
+    async->stats.requests++;
+    async->stats.pending++;
+
+    lv_timer_resume(async->notify_timer);
+    lv_thread_sync_signal(&async->sync);
+}
+
+/**
+ * Unlink and free a request. Called with the lock held.
+ */
+static void async_remove(lv_image_decoder_async_req_t * req)
+{
+    lv_image_decoder_async_req_t ** prev = &img_decoder_async_p->reqs;
+    while(*prev != req) prev = &(*prev)->next;
+    *prev = req->next;
+
+    if(req->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)req->src);
+    lv_free(req->waiters);
+    lv_free(req);
+}
+
+static bool async_start(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+
+    async->notify_timer = lv_timer_create(async_notify_timer_cb, ASYNC_NOTIFY_PERIOD, NULL);
+    LV_ASSERT_MALLOC(async->notify_timer);
+    if(async->notify_timer == NULL) return false;
+    lv_timer_pause(async->notify_timer);
+
+    lv_mutex_init(&async->lock);
+    lv_thread_sync_init(&async->sync);
+    lv_thread_sync_init(&async->exit_sync);
+    async->exit = false;
+
+    /*Below the draw units: the decoding must not delay the rendering*/
+    if(lv_thread_init(&async->thread, LV_THREAD_PRIO_LOW, async_thread_cb, LV_DRAW_THREAD_STACK_SIZE,
+                      async) != LV_RESULT_OK) {
+        LV_LOG_WARN("couldn't create the thread, the images are decoded while they are drawn");
+        lv_thread_sync_delete(&async->exit_sync);
+        lv_thread_sync_delete(&async->sync);
+        lv_mutex_delete(&async->lock);
+        lv_timer_delete(async->notify_timer);
+        async->notify_timer = NULL;
+        async->disabled = true;
+        return false;
+    }
+
+    async->started = true;
+    return true;
+}
+
+static void async_stop(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(!async->started) return;
+
+    lv_mutex_lock(&async->lock);
+    async->exit = true;
+    lv_mutex_unlock(&async->lock);
+    lv_thread_sync_signal(&async->sync);
+
+    /*Wait until the running decoding is finished: on some OSes deleting a thread kills it*/
+    lv_thread_sync_wait(&async->exit_sync);
+    lv_thread_delete(&async->thread);
+
+    while(async->reqs) async_remove(async->reqs);
+
+    lv_thread_sync_delete(&async->exit_sync);
+    lv_thread_sync_delete(&async->sync);
+    lv_mutex_delete(&async->lock);
+    lv_timer_delete(async->notify_timer);
+    lv_memzero(async, sizeof(lv_image_decoder_async_t));
+}
+
+static void async_thread_cb(void * user_data)
+{
+    lv_image_decoder_async_t * async = user_data;
+
+    while(1) {
+        lv_mutex_lock(&async->lock);
+
+        lv_image_decoder_async_req_t * req = async->reqs;
+        while(req && req->state != LV_IMAGE_DECODER_ASYNC_QUEUED) req = req->next;
+
+        if(async->exit) {
+            lv_mutex_unlock(&async->lock);
+            lv_thread_sync_signal(&async->exit_sync);
+            break;
+        }
+
+        if(req == NULL) {
+            lv_mutex_unlock(&async->lock);
+            lv_thread_sync_wait(&async->sync);
+            continue;
+        }
+
+        /*The request isn't freed while it's running*/
+        req->state = LV_IMAGE_DECODER_ASYNC_RUNNING;
+        lv_mutex_unlock(&async->lock);
+
+        /*Decode it into the cache like the draw units do*/
+        lv_image_decoder_dsc_t dsc;
+        bool cached = false;
+        if(lv_image_decoder_open(&dsc, req->src, NULL) == LV_RESULT_OK) {
+            cached = dsc.cache_entry != NULL;
+            lv_image_decoder_close(&dsc);
+        }
+
+        lv_mutex_lock(&async->lock);
+        req->state = LV_IMAGE_DECODER_ASYNC_DONE;
+        req->cached = cached;
+        async->stats.decoded++;
+        async->stats.pending--;
+        if(req->waiter_cnt == 0) {
+            async_remove(req);
+        }
+        else {
+            uint32_t i;
+            for(i = 0; i < req->waiter_cnt; i++) req->waiters[i].notify = true;
+        }
+        lv_mutex_unlock(&async->lock);
+    }
+}
+
+static void async_notify_timer_cb(lv_timer_t * timer)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+
+    /*The callbacks are called without the lock one by one: they may delete widgets and so cancel other waiters*/
+    while(1) {
+        lv_mutex_lock(&async->lock);
+
+        lv_image_decoder_async_waiter_t * waiter = NULL;
+        const void * src = NULL;
+        lv_image_decoder_async_req_t * req;
+        for(req = async->reqs; req && waiter == NULL; req = req->next) {
+            uint32_t i;
+            for(i = 0; i < req->waiter_cnt; i++) {
+                if(req->waiters[i].notify) {
+                    waiter = &req->waiters[i];
+                    src = req->src;
+                    break;
+                }
+            }
+        }
+
+        if(waiter == NULL) {
+            /*Resumed when an image is queued*/
+            if(async->stats.pending == 0) lv_timer_pause(timer);
+            lv_mutex_unlock(&async->lock);
+            break;
+        }
+
+        waiter->notify = false;
+        lv_image_decoder_async_cb_t ready_cb = waiter->ready_cb;
+        void * user_data = waiter->user_data;
+        lv_mutex_unlock(&async->lock);
+
+        ready_cb(src, user_data);
+    }
+}
+#endif /*LV_IMAGE_DECODER_ASYNC*/
@@ -25,6 +25,13 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_USE_IMAGE_DECODER_ASYNC && LV_USE_OS != LV_OS_NONE
+/** The images of the `lv_image` widgets are decoded in a thread (see `LV_USE_IMAGE_DECODER_ASYNC`)*/
+#define LV_IMAGE_DECODER_ASYNC 1
+#else
+#define LV_IMAGE_DECODER_ASYNC 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -76,6 +83,24 @@ typedef lv_result_t (*lv_image_decoder_get_area_cb_t)(lv_image_decoder_t * decod
  */
 typedef void (*lv_image_decoder_close_f_t)(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 
+#if LV_IMAGE_DECODER_ASYNC
+/**
+ * Called in the LVGL thread when an image requested with `lv_image_decoder_open_async()` is decoded.
+ * It's called without lock: it may e.g. delete a widget and so cancel requests.
+ * @param src       the image source, a copy for the files which is freed when the request is canceled
+ * @param user_data the `user_data` of the request
+ */
+typedef void (*lv_image_decoder_async_cb_t)(const void * src, void * user_data);
+
+typedef struct {
+    uint32_t requests;      /**< Images queued for the decoder thread */
+    uint32_t merged;        /**< Requests of an image which was already queued or being decoded */
+    uint32_t canceled;      /**< Queued images dropped because nobody was waiting for them anymore */
+    uint32_t decoded;       /**< Images decoded by the thread */
+    uint32_t pending;       /**< Images queued or being decoded now */
+} lv_image_decoder_async_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -183,6 +208,54 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+/**
+ * Check whether an image can be opened without decoding it: it's drawn directly from the memory
+ * (a symbol or an uncompressed C array) or it's in the image cache. Doesn't count a cache hit or miss.
+ * @param src       the image source, as in `lv_image_decoder_open()`
+ * @return          true: opening it is cheap; false: a decoder needs to run
+ */
+bool lv_image_decoder_is_decoded(const void * src);
+
+#if LV_IMAGE_DECODER_ASYNC
+/**
+ * Check whether an image can be drawn without waiting for its decoder. If not, decode it into the image cache
+ * in the thread of the asynchronous decoder. The requests of the same image are merged.
+ * The request is kept until it's canceled: the image is decoded again if it's evicted from the cache.
+ * @param src       the image source, as in `lv_image_decoder_open()`
+ * @param ready_cb  called in the LVGL thread (from a timer) each time the image is decoded, e.g. to invalidate the widget
+ * @param user_data passed to `ready_cb`, identifies the request in `lv_image_decoder_cancel_async()`
+ * @return          LV_RESULT_OK: draw the image now, it's cached, used directly or it can't be decoded in advance;
+ *                  LV_RESULT_INVALID: it's being decoded, `ready_cb` will be called
+ */
+lv_result_t lv_image_decoder_open_async(const void * src, lv_image_decoder_async_cb_t ready_cb, void * user_data);
+
+/**
+ * Cancel the requests of `lv_image_decoder_open_async()` with a `user_data`.
+ * The image isn't decoded anymore if no other request waits for it, unless its decoding has already started.
+ * @param src       the image source
+ * @param user_data the `user_data` of the request
+ */
+void lv_image_decoder_cancel_async(const void * src, void * user_data);
+
+/**
+ * Enable or disable the asynchronous decoder. When disabled `lv_image_decoder_open_async()` returns LV_RESULT_OK
+ * and the images are decoded while they are drawn. It's enabled by default.
+ * @param en        true: enable; false: disable
+ */
+void lv_image_decoder_enable_async(bool en);
+
+/**
+ * Get the counters of the asynchronous decoder
+ * @param stats     store the counters here
+ */
+void lv_image_decoder_get_async_stats(lv_image_decoder_async_stats_t * stats);
+
+/**
+ * Reset the counters of the asynchronous decoder (except `pending`)
+ */
+void lv_image_decoder_reset_async_stats(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
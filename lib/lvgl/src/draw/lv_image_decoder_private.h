@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_image_decoder.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -115,6 +116,44 @@ struct lv_image_decoder_dsc_t {
 };
 
 
+#if LV_IMAGE_DECODER_ASYNC
+typedef enum {
+    LV_IMAGE_DECODER_ASYNC_QUEUED,
+    LV_IMAGE_DECODER_ASYNC_RUNNING,
+    LV_IMAGE_DECODER_ASYNC_DONE,
+} lv_image_decoder_async_state_t;
+
+typedef struct {
+    lv_image_decoder_async_cb_t ready_cb;
+    void * user_data;
+    bool notify;                                /**< Decoded but `ready_cb` isn't called yet*/
+} lv_image_decoder_async_waiter_t;
+
+/**An image requested with `lv_image_decoder_open_async()`*/
+typedef struct lv_image_decoder_async_req_t {
+    struct lv_image_decoder_async_req_t * next;
+    const void * src;                           /**< A copy of the file name for the files*/
+    lv_image_src_t src_type;
+    lv_image_decoder_async_state_t state;
+    bool cached;                                /**< The decoded image was added to the image cache*/
+    lv_image_decoder_async_waiter_t * waiters;
+    uint32_t waiter_cnt;
+} lv_image_decoder_async_req_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;                      /**< Signaled when an image is queued or to exit*/
+    lv_thread_sync_t exit_sync;                 /**< Signaled by the thread when it exits*/
+    lv_mutex_t lock;                            /**< Protects the requests and the counters*/
+    lv_timer_t * notify_timer;                  /**< Calls the `ready_cb`s in the LVGL thread*/
+    lv_image_decoder_async_req_t * reqs;        /**< In request order*/
+    lv_image_decoder_async_stats_t stats;
+    bool started;
+    bool disabled;
+    bool exit;
+} lv_image_decoder_async_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
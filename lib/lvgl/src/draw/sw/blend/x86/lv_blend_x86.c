@@ -0,0 +1,526 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+#if LV_USE_DRAW_SW && LV_BLEND_X86_SUPPORTED
+
+#include "../../../../misc/lv_color.h"
+#include <string.h>
+#include <immintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The AVX2 kernels need the `target` attribute to be compiled without -mavx2 for the whole project*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2 && defined(__GNUC__)
+    #define BLEND_X86_AVX2  1
+#else
+    #define BLEND_X86_AVX2  0
+#endif
+
+/*Packed R, G, B fields of an RGB565 pixel with space to multiply them at once (see `lv_color_16_16_mix`)*/
+#define RGB565_FIELDS   0x7E0F81F
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A blend operation independent of the destination format.
+ * The kernels compute the alpha of each pixel exactly as the C code does for the same case.
+ */
+typedef struct {
+    uint8_t * dest;
+    int32_t dest_stride;
+    int32_t w;
+    int32_t h;
+    const uint8_t * src;        /**< ARGB8888 or XRGB8888 image (RGB565 for `blend16`), NULL: use `color`*/
+    int32_t src_stride;
+    bool src_opaque;            /**< The image has no alpha: it's computed from `opa` and `mask` like for a fill*/
+    uint32_t color;             /**< Fill color in the destination's format (ARGB8888 or RGB565)*/
+    const lv_opa_t * mask;      /**< NULL: no mask*/
+    int32_t mask_stride;
+    lv_opa_t opa;               /**< Applied only if less than LV_OPA_MAX*/
+} blend_t;
+
+typedef struct {
+    void (*fill32)(const blend_t * b);
+    void (*fill24)(const blend_t * b);
+    void (*fill16)(const blend_t * b);
+    void (*blend32)(const blend_t * b, bool dest_argb);
+    void (*blend16)(const blend_t * b);
+    void (*image_blend16)(const blend_t * b);
+} kernels_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void fill_dsc_to_blend(blend_t * b, const lv_draw_sw_blend_fill_dsc_t * dsc);
+static void image_dsc_to_blend(blend_t * b, const lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**********************
+ *   SCALAR HELPERS
+ **********************/
+
+/*The scalar versions of the kernels, used for the last pixels of the rows
+ *and for the ARGB8888 pixels when both colors are semi-transparent*/
+
+static inline uint32_t px_alpha(const blend_t * b, uint32_t src_a, const lv_opa_t * mask_row, int32_t x)
+{
+    if(b->src == NULL || b->src_opaque) {
+        /*The fills without mask and opacity don't get here, the opaque images are converted*/
+        if(mask_row == NULL) return b->opa >= LV_OPA_MAX ? 255 : b->opa;
+        if(b->opa >= LV_OPA_MAX) return mask_row[x];
+        return LV_OPA_MIX2(mask_row[x], b->opa);
+    }
+
+    if(mask_row == NULL) return b->opa >= LV_OPA_MAX ? src_a : (uint32_t)LV_OPA_MIX2(src_a, b->opa);
+    if(b->opa >= LV_OPA_MAX) return LV_OPA_MIX2(src_a, mask_row[x]);
+    return LV_OPA_MIX3(src_a, b->opa, mask_row[x]);
+}
+
+static inline uint32_t px_mix_rgb(uint32_t fg, uint32_t bg, uint32_t a)
+{
+    uint32_t a_inv = 255 - a;
+    uint32_t res = 0;
+    uint32_t shift;
+    for(shift = 0; shift < 24; shift += 8) {
+        uint32_t c = (((fg >> shift) & 0xFF) * a + ((bg >> shift) & 0xFF) * a_inv) >> 8;
+        res |= c << shift;
+    }
+    return res;
+}
+
+/*Same as `lv_color_32_32_mix` of lv_draw_sw_blend_to_argb8888.c with `a` as the alpha of `fg`*/
+static inline uint32_t px_argb8888(uint32_t fg, uint32_t a, uint32_t bg)
+{
+    uint32_t bg_a = bg >> 24;
+    if(a >= LV_OPA_MAX || bg_a <= LV_OPA_MIN) return (fg & 0xFFFFFF) | (a << 24);
+    if(a <= LV_OPA_MIN) return bg;
+    if(bg_a == 255) return px_mix_rgb(fg, bg, a) | 0xFF000000;
+
+    uint32_t res_a = 255 - LV_OPA_MIX2(255 - a, 255 - bg_a);
+    uint32_t ratio = (a * 255) / res_a;
+    uint32_t rgb;
+    if(ratio >= LV_OPA_MAX) rgb = fg & 0xFFFFFF;
+    else if(ratio <= LV_OPA_MIN) rgb = bg & 0xFFFFFF;
+    else rgb = px_mix_rgb(fg, bg, ratio);
+    return rgb | (res_a << 24);
+}
+
+/*Same as `lv_color_24_24_mix` of lv_draw_sw_blend_to_rgb888.c, the 4th byte is kept*/
+static inline uint32_t px_xrgb8888(uint32_t fg, uint32_t a, uint32_t bg)
+{
+    if(a == 0) return bg;
+    if(a >= LV_OPA_MAX) return (fg & 0xFFFFFF) | (bg & 0xFF000000);
+    return px_mix_rgb(fg, bg, a) | (bg & 0xFF000000);
+}
+
+/*Same as `lv_color_24_16_mix` of lv_draw_sw_blend_to_rgb565.c*/
+static inline uint16_t px_argb8888_to_rgb565(uint32_t fg, uint16_t bg, uint32_t a)
+{
+    uint32_t r = (fg >> 16) & 0xFF;
+    uint32_t g = (fg >> 8) & 0xFF;
+    uint32_t b = fg & 0xFF;
+    if(a == 0) return bg;
+    if(a == 255) return (uint16_t)(((r & 0xF8) << 8) + ((g & 0xFC) << 3) + ((b & 0xF8) >> 3));
+
+    uint32_t a_inv = 255 - a;
+    return (uint16_t)(((((r >> 3) * a + ((bg >> 11) & 0x1F) * a_inv) << 3) & 0xF800) +
+                      ((((g >> 2) * a + ((bg >> 5) & 0x3F) * a_inv) >> 3) & 0x07E0) +
+                      (((b >> 3) * a + (bg & 0x1F) * a_inv) >> 8));
+}
+
+static inline uint32_t load_u32(const void * p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*********************
+ *   SSE2 KERNELS
+ *********************/
+
+#define KERNEL(name)        name##_sse2
+#define KERNEL_ATTR         static
+#define VEC_BYTES           16
+#define VEC_ALL             0xFFFF
+#define vec_t               __m128i
+#define v_zero()            _mm_setzero_si128()
+#define v_set1_32(x)        _mm_set1_epi32((int32_t)(x))
+#define v_set1_16(x)        _mm_set1_epi16((int16_t)(x))
+#define v_load(p)           _mm_loadu_si128((const __m128i *)(p))
+#define v_store(p, v)       _mm_storeu_si128((__m128i *)(p), v)
+#define v_and               _mm_and_si128
+#define v_or                _mm_or_si128
+#define v_andnot            _mm_andnot_si128
+#define v_add16             _mm_add_epi16
+#define v_sub16             _mm_sub_epi16
+#define v_add32             _mm_add_epi32
+#define v_sub32             _mm_sub_epi32
+#define v_mullo16           _mm_mullo_epi16
+#define v_mulhi16           _mm_mulhi_epu16
+#define v_srli16            _mm_srli_epi16
+#define v_slli16            _mm_slli_epi16
+#define v_srli32            _mm_srli_epi32
+#define v_slli32            _mm_slli_epi32
+#define v_srai32            _mm_srai_epi32
+#define v_cmpeq16           _mm_cmpeq_epi16
+#define v_cmpeq32           _mm_cmpeq_epi32
+#define v_cmpgt32           _mm_cmpgt_epi32
+#define v_unpacklo8         _mm_unpacklo_epi8
+#define v_unpackhi8         _mm_unpackhi_epi8
+#define v_unpacklo16        _mm_unpacklo_epi16
+#define v_unpackhi16        _mm_unpackhi_epi16
+#define v_packus16          _mm_packus_epi16
+#define v_packs32           _mm_packs_epi32
+#define v_movemask8         _mm_movemask_epi8
+#define v_pack_order(v)     (v)
+
+/*4 opacity values to the 32 bit lanes*/
+static inline __m128i v_load_opa32_sse2(const lv_opa_t * p)
+{
+    __m128i m = _mm_cvtsi32_si128((int32_t)load_u32(p));
+    m = _mm_unpacklo_epi8(m, _mm_setzero_si128());
+    return _mm_unpacklo_epi16(m, _mm_setzero_si128());
+}
+
+/*8 opacity values to the 16 bit lanes*/
+static inline __m128i v_load_opa16_sse2(const lv_opa_t * p)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+}
+
+#define v_load_opa32        v_load_opa32_sse2
+#define v_load_opa16        v_load_opa16_sse2
+
+#include "lv_blend_x86_kernels.h"
+
+#undef KERNEL
+#undef KERNEL_ATTR
+#undef VEC_BYTES
+#undef VEC_ALL
+#undef vec_t
+#undef v_zero
+#undef v_set1_32
+#undef v_set1_16
+#undef v_load
+#undef v_store
+#undef v_and
+#undef v_or
+#undef v_andnot
+#undef v_add16
+#undef v_sub16
+#undef v_add32
+#undef v_sub32
+#undef v_mullo16
+#undef v_mulhi16
+#undef v_srli16
+#undef v_slli16
+#undef v_srli32
+#undef v_slli32
+#undef v_srai32
+#undef v_cmpeq16
+#undef v_cmpeq32
+#undef v_cmpgt32
+#undef v_unpacklo8
+#undef v_unpackhi8
+#undef v_unpacklo16
+#undef v_unpackhi16
+#undef v_packus16
+#undef v_packs32
+#undef v_movemask8
+#undef v_pack_order
+#undef v_load_opa32
+#undef v_load_opa16
+
+/*********************
+ *   AVX2 KERNELS
+ *********************/
+
+#if BLEND_X86_AVX2
+
+#define KERNEL(name)        name##_avx2
+#define KERNEL_ATTR         static __attribute__((target("avx2")))
+#define VEC_BYTES           32
+#define VEC_ALL             ((int32_t)0xFFFFFFFF)
+#define vec_t               __m256i
+#define v_zero()            _mm256_setzero_si256()
+#define v_set1_32(x)        _mm256_set1_epi32((int32_t)(x))
+#define v_set1_16(x)        _mm256_set1_epi16((int16_t)(x))
+#define v_load(p)           _mm256_loadu_si256((const __m256i *)(p))
+#define v_store(p, v)       _mm256_storeu_si256((__m256i *)(p), v)
+#define v_and               _mm256_and_si256
+#define v_or                _mm256_or_si256
+#define v_andnot            _mm256_andnot_si256
+#define v_add16             _mm256_add_epi16
+#define v_sub16             _mm256_sub_epi16
+#define v_add32             _mm256_add_epi32
+#define v_sub32             _mm256_sub_epi32
+#define v_mullo16           _mm256_mullo_epi16
+#define v_mulhi16           _mm256_mulhi_epu16
+#define v_srli16            _mm256_srli_epi16
+#define v_slli16            _mm256_slli_epi16
+#define v_srli32            _mm256_srli_epi32
+#define v_slli32            _mm256_slli_epi32
+#define v_srai32            _mm256_srai_epi32
+#define v_cmpeq16           _mm256_cmpeq_epi16
+#define v_cmpeq32           _mm256_cmpeq_epi32
+#define v_cmpgt32           _mm256_cmpgt_epi32
+#define v_unpacklo8         _mm256_unpacklo_epi8
+#define v_unpackhi8         _mm256_unpackhi_epi8
+#define v_unpacklo16        _mm256_unpacklo_epi16
+#define v_unpackhi16        _mm256_unpackhi_epi16
+#define v_packus16          _mm256_packus_epi16
+#define v_packs32           _mm256_packs_epi32
+#define v_movemask8         _mm256_movemask_epi8
+/*Packing two registers works per 128 bit lane, so the 64 bit quarters need to be reordered*/
+#define v_pack_order(v)     _mm256_permute4x64_epi64(v, 0xD8)
+
+static inline __attribute__((target("avx2"))) __m256i v_load_opa32_avx2(const lv_opa_t * p)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)p));
+}
+
+static inline __attribute__((target("avx2"))) __m256i v_load_opa16_avx2(const lv_opa_t * p)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+#define v_load_opa32        v_load_opa32_avx2
+#define v_load_opa16        v_load_opa16_avx2
+
+#include "lv_blend_x86_kernels.h"
+
+#endif /*BLEND_X86_AVX2*/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const kernels_t kernels_sse2 = {
+    fill32_sse2, fill24_sse2, fill16_sse2, blend32_sse2, blend16_sse2, image_blend16_sse2
+};
+
+#if BLEND_X86_AVX2
+static const kernels_t kernels_avx2 = {
+    fill32_avx2, fill24_avx2, fill16_avx2, blend32_avx2, blend16_avx2, image_blend16_avx2
+};
+#endif
+
+static const kernels_t * kernels;
+static lv_blend_x86_isa_t isa_active;
+static lv_blend_x86_isa_t isa_supported;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_blend_x86_init(void)
+{
+    isa_supported = LV_BLEND_X86_ISA_SSE2;   /*Part of x86-64*/
+#if BLEND_X86_AVX2
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) isa_supported = LV_BLEND_X86_ISA_AVX2;
+#endif
+
+    lv_blend_x86_set_isa(isa_supported);
+    LV_LOG_INFO("using %s blend kernels", isa_active == LV_BLEND_X86_ISA_AVX2 ? "AVX2" : "SSE2");
+}
+
+lv_blend_x86_isa_t lv_blend_x86_get_isa(void)
+{
+    return isa_active;
+}
+
+lv_blend_x86_isa_t lv_blend_x86_set_isa(lv_blend_x86_isa_t isa)
+{
+    if(isa > isa_supported) isa = isa_supported;
+
+    isa_active = isa;
+    switch(isa) {
+#if BLEND_X86_AVX2
+        case LV_BLEND_X86_ISA_AVX2:
+            kernels = &kernels_avx2;
+            break;
+#endif
+        case LV_BLEND_X86_ISA_SSE2:
+            kernels = &kernels_sse2;
+            break;
+        default:
+            kernels = NULL;
+            break;
+    }
+
+    return isa_active;
+}
+
+lv_result_t lv_color_blend_to_rgb565_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+
+    blend_t b;
+    fill_dsc_to_blend(&b, dsc);
+    b.color = lv_color_to_u16(dsc->color);
+    if(b.mask == NULL && b.opa >= LV_OPA_MAX) kernels->fill16(&b);
+    else kernels->blend16(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    kernels->image_blend16(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    /*Without mask and opacity it's a `memcpy`*/
+    if(kernels == NULL || (dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX)) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    b.src_opaque = true;
+    kernels->blend16(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    if(kernels == NULL || src_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    b.src_opaque = true;
+    kernels->image_blend16(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+
+    blend_t b;
+    fill_dsc_to_blend(&b, dsc);
+    if(dst_px_size == 4) {
+        if(b.mask == NULL && b.opa >= LV_OPA_MAX) kernels->fill32(&b);
+        else kernels->blend32(&b, false);
+        return LV_RESULT_OK;
+    }
+
+    /*The pixels of RGB888 don't fit the lanes so the per pixel masks would need shuffles*/
+    if(b.mask) return LV_RESULT_INVALID;
+
+    if(b.opa > 0) kernels->fill24(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(kernels == NULL || dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    kernels->blend32(&b, false);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                uint32_t src_px_size)
+{
+    if(kernels == NULL || dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+    /*Without mask and opacity it's a `memcpy`*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    b.src_opaque = true;
+    kernels->blend32(&b, false);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+
+    blend_t b;
+    fill_dsc_to_blend(&b, dsc);
+    if(b.mask == NULL && b.opa >= LV_OPA_MAX) kernels->fill32(&b);
+    else kernels->blend32(&b, true);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    kernels->blend32(&b, true);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    if(kernels == NULL || src_px_size != 4) return LV_RESULT_INVALID;
+    /*Without mask and opacity it's a `memcpy` which keeps the 4th byte of the source*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    blend_t b;
+    image_dsc_to_blend(&b, dsc);
+    b.src_opaque = true;
+    kernels->blend32(&b, true);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void fill_dsc_to_blend(blend_t * b, const lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    b->dest = dsc->dest_buf;
+    b->dest_stride = dsc->dest_stride;
+    b->w = dsc->dest_w;
+    b->h = dsc->dest_h;
+    b->src = NULL;
+    b->src_stride = 0;
+    b->src_opaque = false;
+    b->color = lv_color_to_u32(dsc->color);
+    b->mask = dsc->mask_buf;
+    b->mask_stride = dsc->mask_stride;
+    b->opa = dsc->opa;
+}
+
+static void image_dsc_to_blend(blend_t * b, const lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    b->dest = dsc->dest_buf;
+    b->dest_stride = dsc->dest_stride;
+    b->w = dsc->dest_w;
+    b->h = dsc->dest_h;
+    b->src = dsc->src_buf;
+    b->src_stride = dsc->src_stride;
+    b->src_opaque = false;
+    b->color = 0;
+    b->mask = dsc->mask_buf;
+    b->mask_stride = dsc->mask_stride;
+    b->opa = dsc->opa;
+}
+
+#endif /*LV_USE_DRAW_SW && LV_BLEND_X86_SUPPORTED*/
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2*/
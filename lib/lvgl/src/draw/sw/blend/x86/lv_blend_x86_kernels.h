@@ -0,0 +1,395 @@
+/**
+ * @file lv_blend_x86_kernels.h
+ *
+ * The blend kernels written once for every vector width.
+ * Included by lv_blend_x86.c for SSE2 and AVX2 with `KERNEL()`, `VEC_BYTES`, `vec_t` and the `v_...` operations
+ * defined for the given instruction set. Don't include it anywhere else.
+ *
+ * Every kernel gives exactly the same result as the C code in lv_draw_sw_blend_to_*.c.
+ * Channels are mixed in 16 bit lanes: `(fg * a + bg * (255 - a)) >> 8` never overflows 65535.
+ */
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define VEC_PX32    (VEC_BYTES / 4)     /*32 bit pixels in a vector*/
+#define VEC_PX16    (VEC_BYTES / 2)     /*16 bit pixels in a vector*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Fill with an ARGB8888 color (ARGB8888 and XRGB8888 destinations)
+ */
+KERNEL_ATTR void KERNEL(fill32)(const blend_t * b)
+{
+    const vec_t color = v_set1_32(b->color);
+    uint8_t * dest_row = b->dest;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+        int32_t x = 0;
+        for(; x <= b->w - VEC_PX32 * 2; x += VEC_PX32 * 2) {
+            v_store(&dest[x], color);
+            v_store(&dest[x + VEC_PX32], color);
+        }
+        for(; x < b->w; x++) {
+            dest[x] = b->color;
+        }
+        dest_row += b->dest_stride;
+    }
+}
+
+/**
+ * Fill RGB888 with a color and optionally with opacity, without mask.
+ * 3 vectors hold a whole number of pixels, so the color bytes are repeated in 3 vectors.
+ */
+KERNEL_ATTR void KERNEL(fill24)(const blend_t * b)
+{
+    uint8_t pattern[VEC_BYTES * 3];
+    int32_t i;
+    for(i = 0; i < VEC_BYTES * 3; i++) {
+        pattern[i] = (uint8_t)(b->color >> ((i % 3) * 8));
+    }
+
+    const vec_t zero = v_zero();
+    const vec_t opa = v_set1_16(b->opa);
+    const vec_t opa_inv = v_set1_16(255 - b->opa);
+    vec_t p[3];
+    vec_t p_opa[6];
+    for(i = 0; i < 3; i++) {
+        p[i] = v_load(&pattern[i * VEC_BYTES]);
+        p_opa[i * 2] = v_mullo16(v_unpacklo8(p[i], zero), opa);
+        p_opa[i * 2 + 1] = v_mullo16(v_unpackhi8(p[i], zero), opa);
+    }
+
+    bool cover = b->opa >= LV_OPA_MAX;
+    int32_t bytes = b->w * 3;
+    uint8_t * dest = b->dest;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        int32_t x = 0;
+        if(cover) {
+            for(; x <= bytes - VEC_BYTES * 3; x += VEC_BYTES * 3) {
+                v_store(&dest[x], p[0]);
+                v_store(&dest[x + VEC_BYTES], p[1]);
+                v_store(&dest[x + VEC_BYTES * 2], p[2]);
+            }
+            for(; x < bytes; x++) {
+                dest[x] = pattern[x % 3];
+            }
+        }
+        else {
+            for(; x <= bytes - VEC_BYTES * 3; x += VEC_BYTES * 3) {
+                for(i = 0; i < 3; i++) {
+                    vec_t d = v_load(&dest[x + i * VEC_BYTES]);
+                    vec_t lo = v_srli16(v_add16(p_opa[i * 2], v_mullo16(v_unpacklo8(d, zero), opa_inv)), 8);
+                    vec_t hi = v_srli16(v_add16(p_opa[i * 2 + 1], v_mullo16(v_unpackhi8(d, zero), opa_inv)), 8);
+                    v_store(&dest[x + i * VEC_BYTES], v_packus16(lo, hi));
+                }
+            }
+            for(; x < bytes; x++) {
+                dest[x] = (uint8_t)(((uint32_t)pattern[x % 3] * b->opa + dest[x] * (255 - b->opa)) >> 8);
+            }
+        }
+        dest += b->dest_stride;
+    }
+}
+
+/**
+ * Fill RGB565 with a color
+ */
+KERNEL_ATTR void KERNEL(fill16)(const blend_t * b)
+{
+    const uint16_t color16 = (uint16_t)b->color;
+    const vec_t color = v_set1_16(color16);
+    uint8_t * dest_row = b->dest;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        int32_t x = 0;
+        for(; x <= b->w - VEC_PX16 * 2; x += VEC_PX16 * 2) {
+            v_store(&dest[x], color);
+            v_store(&dest[x + VEC_PX16], color);
+        }
+        for(; x < b->w; x++) {
+            dest[x] = color16;
+        }
+        dest_row += b->dest_stride;
+    }
+}
+
+/**
+ * Blend an ARGB8888 or XRGB8888 image or a color with opacity and/or mask to ARGB8888 or XRGB8888.
+ * On ARGB8888 the pixels where both colors are semi-transparent need a division, they are done one by one.
+ * @param b             the blend operation
+ * @param dest_argb     true: ARGB8888 destination, false: XRGB8888 (the 4th byte is kept)
+ */
+KERNEL_ATTR void KERNEL(blend32)(const blend_t * b, bool dest_argb)
+{
+    const vec_t zero = v_zero();
+    const vec_t v255_16 = v_set1_16(255);
+    const vec_t v255 = v_set1_32(255);
+    const vec_t opa = v_set1_32(b->opa);
+    const vec_t color = v_set1_32(b->color);
+    const vec_t rgb_mask = v_set1_32(0x00FFFFFF);
+    const vec_t alpha_mask = v_set1_32(0xFF000000);
+    const vec_t opa_max = v_set1_32(LV_OPA_MAX - 1);
+    const vec_t opa_min = v_set1_32(LV_OPA_MIN + 1);
+    const bool apply_opa = b->opa < LV_OPA_MAX;
+
+    uint8_t * dest_row = b->dest;
+    const uint8_t * src_row = b->src;
+    const lv_opa_t * mask_row = b->mask;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+        const uint32_t * src = (const uint32_t *)src_row;
+        int32_t x = 0;
+        for(; x <= b->w - VEC_PX32; x += VEC_PX32) {
+            vec_t s;
+            vec_t a;
+            if(src == NULL || b->src_opaque) {
+                s = src ? v_load(&src[x]) : color;
+                if(mask_row == NULL) {
+                    a = opa;
+                }
+                else {
+                    a = v_load_opa32(&mask_row[x]);
+                    if(apply_opa) a = v_srli32(v_mullo16(a, opa), 8);
+                }
+            }
+            else {
+                s = v_load(&src[x]);
+                a = v_srli32(s, 24);
+                if(mask_row) {
+                    vec_t m = v_load_opa32(&mask_row[x]);
+                    if(apply_opa) a = v_mulhi16(v_mullo16(a, opa), m);
+                    else a = v_srli32(v_mullo16(a, m), 8);
+                }
+                else if(apply_opa) {
+                    a = v_srli32(v_mullo16(a, opa), 8);
+                }
+            }
+
+            vec_t d = v_load(&dest[x]);
+            vec_t m_fg;     /*Lanes to set the foreground*/
+            vec_t m_bg;     /*Lanes to keep*/
+            if(dest_argb) {
+                vec_t da = v_srli32(d, 24);
+                m_fg = v_or(v_cmpgt32(a, opa_max), v_cmpgt32(opa_min, da));
+                m_bg = v_andnot(m_fg, v_cmpgt32(opa_min, a));
+            }
+            else {
+                m_fg = v_cmpgt32(a, opa_max);
+                m_bg = v_cmpeq32(a, zero);
+            }
+            int32_t known = v_movemask8(v_or(m_fg, m_bg));
+            if(v_movemask8(m_bg) == VEC_ALL) continue;
+
+            vec_t res;
+            if(known == VEC_ALL) {
+                res = v_or(v_and(m_fg, s), v_andnot(m_fg, d));
+            }
+            else {
+                /*Broadcast the alpha to the 4 bytes and mix the channels in 16 bit*/
+                vec_t a2 = v_or(a, v_slli32(a, 8));
+                vec_t a4 = v_or(a2, v_slli32(a2, 16));
+                vec_t a_lo = v_unpacklo8(a4, zero);
+                vec_t a_hi = v_unpackhi8(a4, zero);
+                vec_t lo = v_add16(v_mullo16(v_unpacklo8(s, zero), a_lo),
+                                   v_mullo16(v_unpacklo8(d, zero), v_sub16(v255_16, a_lo)));
+                vec_t hi = v_add16(v_mullo16(v_unpackhi8(s, zero), a_hi),
+                                   v_mullo16(v_unpackhi8(d, zero), v_sub16(v255_16, a_hi)));
+                vec_t mix = v_packus16(v_srli16(lo, 8), v_srli16(hi, 8));
+
+                vec_t known_mask = v_or(m_fg, m_bg);
+                res = v_or(v_and(m_fg, s), v_and(m_bg, d));
+                res = v_or(res, v_andnot(known_mask, mix));
+            }
+
+            if(dest_argb) {
+                /*The foreground keeps its (modified) alpha, the mixed pixels are opaque*/
+                vec_t fg_alpha = v_and(m_fg, v_slli32(a, 24));
+                vec_t mix_alpha = v_andnot(v_or(m_fg, m_bg), alpha_mask);
+                res = v_or(v_and(res, v_or(rgb_mask, m_bg)), v_or(fg_alpha, mix_alpha));
+                v_store(&dest[x], res);
+
+                /*Semi-transparent background under semi-transparent foreground*/
+                int32_t opaque = v_movemask8(v_or(v_cmpeq32(v_srli32(d, 24), v255), v_or(m_fg, m_bg)));
+                if(opaque != VEC_ALL) {
+                    int32_t i;
+                    for(i = 0; i < VEC_PX32; i++) {
+                        if(opaque & (1 << (i * 4))) continue;
+                        uint32_t s_px = src ? src[x + i] : b->color;
+                        uint32_t a_px = px_alpha(b, s_px >> 24, mask_row, x + i);
+                        dest[x + i] = px_argb8888(s_px, a_px, load_u32(&((const uint8_t *)&d)[i * 4]));
+                    }
+                }
+            }
+            else {
+                v_store(&dest[x], v_or(v_and(res, rgb_mask), v_and(d, alpha_mask)));
+            }
+        }
+
+        for(; x < b->w; x++) {
+            uint32_t s_px = src ? src[x] : b->color;
+            uint32_t a_px = px_alpha(b, s_px >> 24, mask_row, x);
+            if(dest_argb) dest[x] = px_argb8888(s_px, a_px, dest[x]);
+            else dest[x] = px_xrgb8888(s_px, a_px, dest[x]);
+        }
+
+        dest_row += b->dest_stride;
+        if(src_row) src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+/**
+ * Blend a color or an RGB565 image with opacity and/or mask to RGB565 like `lv_color_16_16_mix`:
+ * the packed fields are multiplied by a 5 bit mix. The 32 bit product is made of 16 bit multiplications.
+ */
+KERNEL_ATTR void KERNEL(blend16)(const blend_t * b)
+{
+    const vec_t zero = v_zero();
+    const vec_t fields = v_set1_32(RGB565_FIELDS);
+    const vec_t fg = v_set1_32((b->color | (b->color << 16)) & RGB565_FIELDS);
+    const vec_t opa = v_set1_16(b->opa);
+    const vec_t four = v_set1_16(4);
+    const bool apply_opa = b->opa < LV_OPA_MAX;
+
+    uint8_t * dest_row = b->dest;
+    const uint8_t * src_row = b->src;
+    const lv_opa_t * mask_row = b->mask;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        const uint16_t * src = (const uint16_t *)src_row;
+        int32_t x = 0;
+        for(; x <= b->w - VEC_PX16; x += VEC_PX16) {
+            vec_t a = opa;
+            if(mask_row) {
+                a = v_load_opa16(&mask_row[x]);
+                if(apply_opa) a = v_srli16(v_mullo16(a, opa), 8);
+                if(v_movemask8(v_cmpeq16(a, zero)) == VEC_ALL) continue;
+            }
+
+            vec_t mix5 = v_srli16(v_add16(a, four), 3);
+            vec_t d = v_load(&dest[x]);
+            vec_t s = src ? v_load(&src[x]) : zero;
+            vec_t res[2];
+            int32_t i;
+            for(i = 0; i < 2; i++) {
+                vec_t d32 = i == 0 ? v_unpacklo16(d, zero) : v_unpackhi16(d, zero);
+                vec_t m32 = i == 0 ? v_unpacklo16(mix5, zero) : v_unpackhi16(mix5, zero);
+                m32 = v_or(m32, v_slli32(m32, 16));
+                vec_t bg = v_and(v_or(d32, v_slli32(d32, 16)), fields);
+                vec_t fg_px = fg;
+                if(src) {
+                    vec_t s32 = i == 0 ? v_unpacklo16(s, zero) : v_unpackhi16(s, zero);
+                    fg_px = v_and(v_or(s32, v_slli32(s32, 16)), fields);
+                }
+                vec_t diff = v_sub32(fg_px, bg);
+                vec_t prod = v_add16(v_mullo16(diff, m32), v_slli32(v_mulhi16(diff, m32), 16));
+                vec_t r = v_and(v_add32(v_srli32(prod, 5), bg), fields);
+                r = v_or(r, v_srli32(r, 16));
+                res[i] = v_srai32(v_slli32(r, 16), 16);
+            }
+            v_store(&dest[x], v_packs32(res[0], res[1]));
+        }
+
+        for(; x < b->w; x++) {
+            uint16_t s_px = src ? src[x] : (uint16_t)b->color;
+            dest[x] = lv_color_16_16_mix(s_px, dest[x], (uint8_t)px_alpha(b, 0, mask_row, x));
+        }
+
+        dest_row += b->dest_stride;
+        if(src_row) src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+/**
+ * Blend an ARGB8888 or XRGB8888 image with opacity and/or mask to RGB565 like `lv_color_24_16_mix`
+ */
+KERNEL_ATTR void KERNEL(image_blend16)(const blend_t * b)
+{
+    const vec_t zero = v_zero();
+    const vec_t v255_16 = v_set1_16(255);
+    const vec_t v255 = v_set1_32(255);
+    const vec_t opa = v_set1_16(b->opa);
+    const vec_t c1f = v_set1_16(0x1F);
+    const vec_t c3f = v_set1_16(0x3F);
+    const vec_t cf8 = v_set1_16(0xF8);
+    const vec_t cfc = v_set1_16(0xFC);
+    const vec_t r_mask = v_set1_16(0xF800);
+    const vec_t g_mask = v_set1_16(0x07E0);
+    const bool apply_opa = b->opa < LV_OPA_MAX;
+
+    uint8_t * dest_row = b->dest;
+    const uint8_t * src_row = b->src;
+    const lv_opa_t * mask_row = b->mask;
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        const uint32_t * src = (const uint32_t *)src_row;
+        int32_t x = 0;
+        for(; x <= b->w - VEC_PX16; x += VEC_PX16) {
+            vec_t s0 = v_load(&src[x]);
+            vec_t s1 = v_load(&src[x + VEC_PX32]);
+            vec_t a;
+            if(b->src_opaque) {
+                a = apply_opa ? opa : v255_16;
+                if(mask_row) {
+                    a = v_load_opa16(&mask_row[x]);
+                    if(apply_opa) a = v_srli16(v_mullo16(a, opa), 8);
+                }
+            }
+            else if(mask_row) {
+                a = v_pack_order(v_packs32(v_srli32(s0, 24), v_srli32(s1, 24)));
+                vec_t m = v_load_opa16(&mask_row[x]);
+                if(apply_opa) a = v_mulhi16(v_mullo16(a, opa), m);
+                else a = v_srli16(v_mullo16(a, m), 8);
+            }
+            else {
+                a = v_pack_order(v_packs32(v_srli32(s0, 24), v_srli32(s1, 24)));
+                if(apply_opa) a = v_srli16(v_mullo16(a, opa), 8);
+            }
+
+            vec_t m_bg = v_cmpeq16(a, zero);
+            if(v_movemask8(m_bg) == VEC_ALL) continue;
+
+            vec_t r8 = v_pack_order(v_packs32(v_and(v_srli32(s0, 16), v255), v_and(v_srli32(s1, 16), v255)));
+            vec_t g8 = v_pack_order(v_packs32(v_and(v_srli32(s0, 8), v255), v_and(v_srli32(s1, 8), v255)));
+            vec_t b8 = v_pack_order(v_packs32(v_and(s0, v255), v_and(s1, v255)));
+
+            vec_t d = v_load(&dest[x]);
+            vec_t a_inv = v_sub16(v255_16, a);
+            vec_t red = v_add16(v_mullo16(v_srli16(r8, 3), a), v_mullo16(v_and(v_srli16(d, 11), c1f), a_inv));
+            vec_t green = v_add16(v_mullo16(v_srli16(g8, 2), a), v_mullo16(v_and(v_srli16(d, 5), c3f), a_inv));
+            vec_t blue = v_add16(v_mullo16(v_srli16(b8, 3), a), v_mullo16(v_and(d, c1f), a_inv));
+            vec_t res = v_or(v_or(v_and(v_slli16(red, 3), r_mask), v_and(v_srli16(green, 3), g_mask)), v_srli16(blue, 8));
+
+            /*The exact color where fully covered*/
+            vec_t m_fg = v_cmpeq16(a, v255_16);
+            vec_t fg = v_or(v_or(v_slli16(v_and(r8, cf8), 8), v_slli16(v_and(g8, cfc), 3)), v_srli16(b8, 3));
+            res = v_or(v_and(m_fg, fg), v_andnot(m_fg, res));
+            res = v_or(v_and(m_bg, d), v_andnot(m_bg, res));
+            v_store(&dest[x], res);
+        }
+
+        for(; x < b->w; x++) {
+            uint32_t s_px = src[x];
+            dest[x] = px_argb8888_to_rgb565(s_px, dest[x], px_alpha(b, s_px >> 24, mask_row, x));
+        }
+
+        dest_row += b->dest_stride;
+        src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+#undef VEC_PX32
+#undef VEC_PX16
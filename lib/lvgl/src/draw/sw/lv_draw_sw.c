@@ -7,7 +7,9 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_private.h"
+#include "lv_draw_sw_gradient_private.h"
 #include "../lv_draw_private.h"
+#include "../../misc/lv_area_private.h"
 #if LV_USE_DRAW_SW
 
 #include "../../core/lv_refr.h"
@@ -25,6 +27,8 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #include "blend/x86/lv_blend_x86.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -38,6 +42,8 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+#define DRAW_SW_SPLIT       (LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_SPLIT_MIN_AREA > 0)
+
 #ifndef LV_DRAW_SW_RGB565_SWAP
     #define LV_DRAW_SW_RGB565_SWAP(...) LV_RESULT_INVALID
 #endif
@@ -106,6 +112,9 @@ static void execute_drawing(lv_draw_sw_unit_t * u);
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit);
+#if DRAW_SW_SPLIT
+    static void split_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t, lv_layer_t * layer);
+#endif
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888
 static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t src_width, int32_t src_height,
@@ -168,6 +177,17 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if DRAW_SW_SPLIT
+    lv_mutex_init(&_draw_info.split_mutex);
+#endif
+
+#if (LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2) && LV_BLEND_X86_SUPPORTED
+    lv_blend_x86_init();
+#endif
+
+    lv_draw_sw_gradient_cache_init();
+    lv_draw_sw_box_shadow_cache_init();
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -195,6 +215,13 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+    lv_draw_sw_gradient_cache_deinit();
+    lv_draw_sw_box_shadow_cache_deinit();
+
+#if DRAW_SW_SPLIT
+    lv_mutex_delete(&_draw_info.split_mutex);
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -382,7 +409,19 @@ static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
     execute_drawing(u);
 
-    u->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_t * t = u->task_act;
+    bool last = true;
+#if DRAW_SW_SPLIT
+    /*Only the unit finishing the last band can tell that the task is ready*/
+    if(t->split_cnt) {
+        lv_mutex_lock(&_draw_info.split_mutex);
+        t->split_cnt--;
+        last = t->split_cnt == 0;
+        lv_mutex_unlock(&_draw_info.split_mutex);
+    }
+#endif
+
+    if(last) t->state = LV_DRAW_TASK_STATE_READY;
     u->task_act = NULL;
 
     /*The draw unit is free now. Request a new dispatching as it can get a new task*/
@@ -453,7 +492,11 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 
     t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
     draw_sw_unit->base_unit.target_layer = layer;
-    draw_sw_unit->base_unit.clip_area = &t->clip_area;
+    draw_sw_unit->clip_band = t->clip_area;
+    draw_sw_unit->base_unit.clip_area = &draw_sw_unit->clip_band;
+#if DRAW_SW_SPLIT
+    split_task(draw_sw_unit, t, layer);
+#endif
     draw_sw_unit->task_act = t;
 
 #if LV_USE_OS
@@ -496,6 +539,72 @@ static void render_thread_cb(void * ptr)
 }
 #endif
 
+#if DRAW_SW_SPLIT
+/**
+ * Split a large task into horizontal bands: `draw_sw_unit` keeps the top band
+ * and the other idle SW draw units start rendering the others right away.
+ * The bands are clip areas, so every unit renders the same task only in its own rows.
+ * @param draw_sw_unit  the unit which took the task, its `clip_band` is the task's clip area
+ * @param t             the task to split
+ * @param layer         the target layer
+ */
+static void split_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    /*Labels are not split: each band would break all the lines above it again to find its first line*/
+    if(t->type != LV_DRAW_TASK_TYPE_FILL && t->type != LV_DRAW_TASK_TYPE_IMAGE &&
+       t->type != LV_DRAW_TASK_TYPE_LAYER) return;
+
+    /*Each band opens the image on its own: if it needs decoding (PNG, JPEG, compressed, not cached yet)
+     *the units would decode the same image in parallel and all but one result would be thrown away*/
+    if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t * image_dsc = t->draw_dsc;
+        if(!lv_image_decoder_is_decoded(image_dsc->src)) return;
+    }
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) return;
+    if(lv_area_get_size(&draw_area) < LV_DRAW_SW_SPLIT_MIN_AREA) return;
+
+    lv_draw_sw_unit_t * units[LV_DRAW_SW_DRAW_UNIT_CNT];
+    int32_t unit_cnt = 0;
+    units[unit_cnt++] = draw_sw_unit;
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u && unit_cnt < LV_DRAW_SW_DRAW_UNIT_CNT) {
+        lv_draw_sw_unit_t * u_sw = (lv_draw_sw_unit_t *)u;
+        if(u->dispatch_cb == dispatch && u_sw != draw_sw_unit && u_sw->task_act == NULL) {
+            units[unit_cnt++] = u_sw;
+        }
+        u = u->next;
+    }
+
+    int32_t h = lv_area_get_height(&draw_area);
+    if(unit_cnt > h) unit_cnt = h;
+    if(unit_cnt < 2) return;
+
+    t->split_cnt = unit_cnt;
+
+    int32_t y = draw_area.y1;
+    int32_t i;
+    for(i = 0; i < unit_cnt; i++) {
+        int32_t band_h = (draw_area.y2 + 1 - y) / (unit_cnt - i);
+        lv_draw_sw_unit_t * u_sw = units[i];
+        u_sw->clip_band = t->clip_area;
+        u_sw->clip_band.y1 = y;
+        u_sw->clip_band.y2 = y + band_h - 1;
+        y += band_h;
+
+        /*`draw_sw_unit` is started by the caller*/
+        if(u_sw == draw_sw_unit) continue;
+
+        u_sw->base_unit.target_layer = layer;
+        u_sw->base_unit.clip_area = &u_sw->clip_band;
+        u_sw->task_act = t;
+        if(u_sw->inited) lv_thread_sync_signal(&u_sw->sync);
+    }
+}
+#endif
+
 static void execute_drawing(lv_draw_sw_unit_t * u)
 {
     LV_PROFILER_BEGIN;
@@ -32,6 +32,18 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Counters of the shadow corner cache (see `LV_DRAW_SW_SHADOW_CACHE_SIZE`) */
+typedef struct {
+    uint32_t hits;      /**< Shadows whose corner was taken from the cache*/
+    uint32_t misses;    /**< Shadows whose corner had to be blurred*/
+    uint32_t size;      /**< Bytes used by the cached corners*/
+    uint32_t max_size;  /**< Size of the cache in bytes, 0 if disabled*/
+} lv_draw_sw_box_shadow_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -71,6 +83,18 @@ void lv_draw_sw_border(lv_draw_unit_t * draw_unit, const lv_draw_border_dsc_t *
  */
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
 
+/**
+ * Get the counters of the shadow corner cache.
+ * The counters are not exact if several draw units draw shadows in parallel.
+ * @param stats     store the counters here
+ */
+void lv_draw_sw_box_shadow_cache_get_stats(lv_draw_sw_box_shadow_cache_stats_t * stats);
+
+/**
+ * Clear the hit and miss counters of the shadow corner cache
+ */
+void lv_draw_sw_box_shadow_cache_reset_stats(void);
+
 /**
  * Draw an image with SW render. It handles image decoding, tiling, transformations, and recoloring.
  * @param draw_unit     pointer to a draw unit
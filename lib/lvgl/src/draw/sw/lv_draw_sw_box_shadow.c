@@ -8,8 +8,10 @@
  *********************/
 #include "../../misc/lv_area_private.h"
 #include "lv_draw_sw_mask_private.h"
+#include "lv_draw_sw_private.h"
 #include "../lv_draw_private.h"
 #include "lv_draw_sw.h"
+#include "../../stdlib/lv_string.h"
 #if LV_USE_DRAW_SW
 
 #if LV_DRAW_SW_COMPLEX
@@ -19,7 +21,6 @@
 #include "../../misc/lv_math.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
-#include "../../stdlib/lv_string.h"
 #include "../lv_draw_mask.h"
 
 /*********************
@@ -28,21 +29,46 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+
+    #if LV_DRAW_SW_SHADOW_CACHE_SIZE < 256
+        #warning "LV_DRAW_SW_SHADOW_CACHE_SIZE is in bytes now, not the max. corner size in pixels"
+    #endif
 #endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    int32_t sw;         /*Shadow width*/
+    int32_t r;          /*Clamped radius*/
+    int32_t w;          /*Size of the blurred rectangle, clamped to where it doesn't change the corner*/
+    int32_t h;
+
+    lv_opa_t * buf;     /*`(sw + r)^2` opacity values*/
+} shadow_cache_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_opa_t * get_corner_buf(const lv_area_t * core_area, int32_t sw, int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    static bool shadow_cache_create_cb(shadow_cache_data_t * node, void * user_data);
+    static void shadow_cache_free_cb(shadow_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs,
+                                                          const shadow_cache_data_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -97,31 +123,9 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    /*It's modified below so it's always a copy*/
+    lv_opa_t * sh_buf = get_corner_buf(&core_area, dsc->width, r_sh);
+    if(sh_buf == NULL) return;
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -556,10 +560,118 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_free(mask_buf);
 }
 
+void lv_draw_sw_box_shadow_cache_init(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    shadow_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(shadow_cache_data_t),
+                                         LV_DRAW_SW_SHADOW_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb,
+    });
+    lv_cache_set_name(shadow_cache.cache, "SW_SHADOW");
+    shadow_cache.lookups = 0;
+    shadow_cache.misses = 0;
+#endif
+}
+
+void lv_draw_sw_box_shadow_cache_deinit(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    if(shadow_cache.cache == NULL) return;
+
+    lv_cache_destroy(shadow_cache.cache, NULL);
+    shadow_cache.cache = NULL;
+#endif
+}
+
+void lv_draw_sw_box_shadow_cache_get_stats(lv_draw_sw_box_shadow_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_draw_sw_box_shadow_cache_stats_t));
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    if(shadow_cache.cache == NULL) return;
+
+    stats->misses = shadow_cache.misses;
+    stats->hits = shadow_cache.lookups > shadow_cache.misses ? shadow_cache.lookups - shadow_cache.misses : 0;
+    stats->size = (uint32_t)lv_cache_get_size(shadow_cache.cache, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(shadow_cache.cache, NULL);
+#endif
+}
+
+void lv_draw_sw_box_shadow_cache_reset_stats(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    shadow_cache.lookups = 0;
+    shadow_cache.misses = 0;
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get a blurred corner from the cache or calculate it
+ * @param core_area     the rectangle to blur
+ * @param sw            shadow width
+ * @param r             radius, clamped to the size of `core_area`
+ * @return              `(sw + r)^2` opacity values in a new buffer, free it with `lv_free`
+ */
+static lv_opa_t * get_corner_buf(const lv_area_t * core_area, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    shadow_cache_data_t search_key;
+    lv_cache_entry_t * entry = NULL;
+    if(shadow_cache.cache) {
+        /*The far sides of wider or taller rectangles are out of the corner*/
+        int32_t max_len = size + r + 2;
+        search_key.slot.size = size * size;
+        search_key.sw = sw;
+        search_key.r = r;
+        search_key.w = LV_MIN(lv_area_get_width(core_area), max_len);
+        search_key.h = LV_MIN(lv_area_get_height(core_area), max_len);
+        search_key.buf = NULL;
+
+        shadow_cache.lookups++;
+        entry = lv_cache_acquire(shadow_cache.cache, &search_key, NULL);
+        if(entry) {
+            lv_opa_t * sh_buf = lv_malloc(size * size);
+            LV_ASSERT_MALLOC(sh_buf);
+            if(sh_buf) {
+                shadow_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+                lv_memcpy(sh_buf, cached_data->buf, size * size);
+            }
+            lv_cache_release(shadow_cache.cache, entry, NULL);
+            return sh_buf;
+        }
+
+        shadow_cache.misses++;
+    }
+#endif
+
+    /*A larger buffer is required for calculation*/
+    uint16_t * sh_buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    if(sh_buf == NULL) return NULL;
+
+    /*Blur without holding the cache's lock so the other draw units can use the cache meanwhile*/
+    shadow_draw_corner_buf(core_area, sh_buf, sw, r);
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    if(shadow_cache.cache) {
+        /*Copied by the create callback. If an other draw unit added this corner meanwhile, it's just acquired.
+         *NULL if larger than the whole cache*/
+        entry = lv_cache_acquire_or_create(shadow_cache.cache, &search_key, sh_buf);
+        if(entry) lv_cache_release(shadow_cache.cache, entry, NULL);
+    }
+#endif
+
+    return (lv_opa_t *)sh_buf;
+}
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
@@ -727,6 +839,55 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+
+/*-----------------
+ * Cache Callbacks
+ *----------------*/
+
+static bool shadow_cache_create_cb(shadow_cache_data_t * node, void * user_data)
+{
+    /*`user_data` is the corner just blurred by `get_corner_buf`*/
+    uint32_t buf_size = (uint32_t)(node->sw + node->r) * (node->sw + node->r);
+    node->buf = lv_malloc(buf_size);
+    if(node->buf == NULL) return false;
+
+    lv_memcpy(node->buf, user_data, buf_size);
+    return true;
+}
+
+static void shadow_cache_free_cb(shadow_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->buf);
+    node->buf = NULL;
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs,
+                                                      const shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) {
+        return lhs->sw > rhs->sw ? 1 : -1;
+    }
+
+    if(lhs->r != rhs->r) {
+        return lhs->r > rhs->r ? 1 : -1;
+    }
+
+    if(lhs->w != rhs->w) {
+        return lhs->w > rhs->w ? 1 : -1;
+    }
+
+    if(lhs->h != rhs->h) {
+        return lhs->h > rhs->h ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE > 0*/
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
@@ -738,6 +899,23 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     LV_LOG_WARN("LV_DRAW_SW_COMPLEX needs to be enabled");
 }
 
+void lv_draw_sw_box_shadow_cache_init(void)
+{
+}
+
+void lv_draw_sw_box_shadow_cache_deinit(void)
+{
+}
+
+void lv_draw_sw_box_shadow_cache_get_stats(lv_draw_sw_box_shadow_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_draw_sw_box_shadow_cache_stats_t));
+}
+
+void lv_draw_sw_box_shadow_cache_reset_stats(void)
+{
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
 
 #endif /*LV_DRAW_USE_SW*/
@@ -12,6 +12,7 @@
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -26,10 +27,34 @@
     #define ALIGN(X)    (((X) + 3) & ~3)
 #endif
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    #define grad_cache LV_GLOBAL_DEFAULT()->sw_grad_cache
+
+    /*The lookups are counted before the cache is locked, by every draw unit*/
+    #if defined(__GNUC__) || defined(__clang__)
+        #define GRAD_STAT_INC(cnt)      __atomic_fetch_add(&(cnt), 1, __ATOMIC_RELAXED)
+    #else
+        #define GRAD_STAT_INC(cnt)      (cnt)++
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    /*The maps depend only on the stops and on their size (the direction only selects the size)*/
+    lv_gradient_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    uint8_t stops_count;
+    uint32_t size;
+
+    lv_grad_t * grad;
+} grad_cache_data_t;
+#endif
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 typedef struct {
@@ -73,7 +98,17 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static uint32_t get_map_size(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static size_t get_item_size(uint32_t size);
+static lv_grad_t * allocate_item(uint32_t size);
+static lv_grad_t * gradient_get(const lv_grad_dsc_t * g, uint32_t size, bool cacheable);
+static void fill_item(const lv_grad_dsc_t * g, lv_grad_t * item);
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data);
+    static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs);
+#endif
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
@@ -89,25 +124,29 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+static uint32_t get_map_size(const lv_grad_dsc_t * g, int32_t w, int32_t h)
 {
-    int32_t size;
     switch(g->dir) {
         case LV_GRAD_DIR_HOR:
         case LV_GRAD_DIR_LINEAR:
         case LV_GRAD_DIR_RADIAL:
         case LV_GRAD_DIR_CONICAL:
-            size = w;
-            break;
+            return w;
         case LV_GRAD_DIR_VER:
-            size = h;
-            break;
+            return h;
         default:
-            size = 64;
+            return 64;
     }
+}
 
-    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
-    lv_grad_t * item  = lv_malloc(req_size);
+static size_t get_item_size(uint32_t size)
+{
+    return ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+}
+
+static lv_grad_t * allocate_item(uint32_t size)
+{
+    lv_grad_t * item  = lv_malloc(get_item_size(size));
     LV_ASSERT_MALLOC(item);
     if(item == NULL) return NULL;
 
@@ -115,9 +154,116 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->entry = NULL;
+    return item;
+}
+
+static void fill_item(const lv_grad_dsc_t * g, lv_grad_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_gradient_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+/**
+ * Get the maps of a gradient from the cache or calculate them
+ * @param g             the gradient descriptor
+ * @param size          number of elements in the maps
+ * @param cacheable     false if the caller writes into the maps
+ * @return              the maps, release them with `lv_gradient_cleanup`
+ */
+static lv_grad_t * gradient_get(const lv_grad_dsc_t * g, uint32_t size, bool cacheable)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    if(cacheable && grad_cache.cache) {
+        grad_cache_data_t search_key;
+        search_key.slot.size = get_item_size(size);
+        lv_memzero(search_key.stops, sizeof(search_key.stops));
+        lv_memcpy(search_key.stops, g->stops, g->stops_count * sizeof(lv_gradient_stop_t));
+        search_key.stops_count = g->stops_count;
+        search_key.size = size;
+        search_key.grad = NULL;
+
+        GRAD_STAT_INC(grad_cache.lookups);
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(grad_cache.cache, &search_key, NULL);
+        if(entry) {
+            grad_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+            return cached_data->grad;
+        }
+        /*Larger than the whole cache or out of memory: calculate the maps only for this draw*/
+    }
+#else
+    LV_UNUSED(cacheable);
+#endif
+
+    lv_grad_t * item = allocate_item(size);
+    if(item == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return NULL;
+    }
+
+    fill_item(g, item);
     return item;
 }
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+
+/*-----------------
+ * Cache Callbacks
+ *----------------*/
+
+static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Called with the cache locked so the counter is exact*/
+    grad_cache.misses++;
+
+    node->grad = allocate_item(node->size);
+    if(node->grad == NULL) return false;
+
+    lv_grad_dsc_t g;
+    lv_memzero(&g, sizeof(g));
+    lv_memcpy(g.stops, node->stops, sizeof(node->stops));
+    g.stops_count = node->stops_count;
+    fill_item(&g, node->grad);
+
+    /*Let `lv_gradient_cleanup` release the entry*/
+    node->grad->entry = lv_cache_entry_get_entry(node, sizeof(grad_cache_data_t));
+
+    return true;
+}
+
+static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->grad);
+    node->grad = NULL;
+}
+
+static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs)
+{
+    if(lhs->size != rhs->size) {
+        return lhs->size > rhs->size ? 1 : -1;
+    }
+
+    if(lhs->stops_count != rhs->stops_count) {
+        return lhs->stops_count > rhs->stops_count ? 1 : -1;
+    }
+
+    /*The unused stops are zeroed*/
+    int32_t cmp_res = lv_memcmp(lhs->stops, rhs->stops, sizeof(lhs->stops));
+    if(cmp_res != 0) {
+        return cmp_res > 0 ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0*/
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -146,19 +292,10 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 1: Search cache for the given key */
-    lv_grad_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
-        return item;
-    }
-
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_gradient_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
-    return item;
+    /* The complex gradients use the returned maps as line buffer so only cache the simple ones.
+     * Their 256 element color map is cached by the setup functions. */
+    bool cacheable = g->dir == LV_GRAD_DIR_HOR || g->dir == LV_GRAD_DIR_VER;
+    return gradient_get(g, get_map_size(g, w, h), cacheable);
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_gradient_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
@@ -216,9 +353,63 @@ void LV_ATTRIBUTE_FAST_MEM lv_gradient_color_calculate(const lv_grad_dsc_t * dsc
 
 void lv_gradient_cleanup(lv_grad_t * grad)
 {
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    if(grad->entry) {
+        lv_cache_release(grad_cache.cache, grad->entry, NULL);
+        return;
+    }
+#endif
+
     lv_free(grad);
 }
 
+void lv_draw_sw_gradient_cache_init(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    grad_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(grad_cache_data_t),
+                                       LV_DRAW_SW_GRADIENT_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) grad_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) grad_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) grad_cache_free_cb,
+    });
+    lv_cache_set_name(grad_cache.cache, "SW_GRADIENT");
+    grad_cache.lookups = 0;
+    grad_cache.misses = 0;
+#endif
+}
+
+void lv_draw_sw_gradient_cache_deinit(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    if(grad_cache.cache == NULL) return;
+
+    lv_cache_destroy(grad_cache.cache, NULL);
+    grad_cache.cache = NULL;
+#endif
+}
+
+void lv_draw_sw_gradient_cache_get_stats(lv_draw_sw_gradient_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_draw_sw_gradient_cache_stats_t));
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    if(grad_cache.cache == NULL) return;
+
+    stats->misses = grad_cache.misses;
+    stats->hits = grad_cache.lookups > grad_cache.misses ? grad_cache.lookups - grad_cache.misses : 0;
+    stats->size = (uint32_t)lv_cache_get_size(grad_cache.cache, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(grad_cache.cache, NULL);
+#endif
+}
+
+void lv_draw_sw_gradient_cache_reset_stats(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    grad_cache.lookups = 0;
+    grad_cache.misses = 0;
+#endif
+}
+
 void lv_gradient_init_stops(lv_grad_dsc_t * grad, const lv_color_t colors[], const lv_opa_t opa[],
                             const uint8_t fracs[], int num_stops)
 {
@@ -305,7 +496,7 @@ void lv_gradient_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = gradient_get(dsc, 256, true);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -474,7 +665,7 @@ void lv_gradient_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = gradient_get(dsc, 256, true);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -501,7 +692,7 @@ void lv_gradient_linear_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_gradient_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -548,7 +739,7 @@ void lv_gradient_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = gradient_get(dsc, 256, true);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -573,7 +764,7 @@ void lv_gradient_conical_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_gradient_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -36,6 +36,14 @@ extern "C" {
  **********************/
 typedef lv_color_t lv_grad_color_t;
 
+/** Counters of the gradient cache (see `LV_DRAW_SW_GRADIENT_CACHE_SIZE`) */
+typedef struct {
+    uint32_t hits;      /**< Gradients whose maps were taken from the cache*/
+    uint32_t misses;    /**< Gradients whose maps had to be calculated*/
+    uint32_t size;      /**< Bytes used by the cached maps*/
+    uint32_t max_size;  /**< Size of the cache in bytes, 0 if disabled*/
+} lv_draw_sw_gradient_cache_stats_t;
+
 /**********************
  *      PROTOTYPES
  **********************/
@@ -51,15 +59,34 @@ typedef lv_color_t lv_grad_color_t;
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_gradient_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                              int32_t frac, lv_grad_color_t * color_out, lv_opa_t * opa_out);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get the color and opacity maps of a gradient. They are taken from the gradient cache
+ * if a gradient with the same stops and size was drawn recently.
+ * @param gradient  the gradient descriptor
+ * @param w         width of the area to fill, the size of the maps for all but vertical gradients
+ * @param h         height of the area to fill, the size of the maps for vertical gradients
+ * @return          the maps or NULL if `gradient` has no direction or on error
+ */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Clean up the gradient item after it was get with `lv_gradient_get`.
  * @param grad      pointer to a gradient
  */
 void lv_gradient_cleanup(lv_grad_t * grad);
 
+/**
+ * Get the counters of the gradient cache.
+ * The hit counter is not exact if several draw units draw gradients in parallel.
+ * @param stats     store the counters here
+ */
+void lv_draw_sw_gradient_cache_get_stats(lv_draw_sw_gradient_cache_stats_t * stats);
+
+/**
+ * Clear the hit and miss counters of the gradient cache
+ */
+void lv_draw_sw_gradient_cache_reset_stats(void);
+
 /**
  * Initialize gradient color map from a table
  * @param grad      pointer to a gradient descriptor
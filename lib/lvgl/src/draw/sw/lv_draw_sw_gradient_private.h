@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_sw_gradient.h"
+#include "../../misc/cache/lv_cache.h"
 
 #if LV_USE_DRAW_SW
 
@@ -30,13 +31,31 @@ struct lv_grad_t {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_cache_entry_t * entry;       /**< The cache entry holding the maps or NULL if not cached*/
 };
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+typedef struct {
+    struct lv_cache_t * cache;
+    uint32_t lookups;
+    uint32_t misses;
+} lv_draw_sw_gradient_cache_t;
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Create the gradient cache. Called by `lv_draw_sw_init`.
+ */
+void lv_draw_sw_gradient_cache_init(void);
+
+/**
+ * Free the gradient cache. Called by `lv_draw_sw_deinit`.
+ */
+void lv_draw_sw_gradient_cache_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
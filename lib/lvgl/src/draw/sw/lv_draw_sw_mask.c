@@ -21,11 +21,31 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 #define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
 #define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
 
+/*Keep empty slots to always end the probing*/
+#define CIRCLE_CACHE_ENTRY_MAX          (LV_DRAW_SW_CIRCLE_CACHE_SLOTS * 3 / 4)
+
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0 && LV_DRAW_SW_CIRCLE_CACHE_SIZE < 256
+    #warning "LV_DRAW_SW_CIRCLE_CACHE_SIZE is in bytes now, not the number of circles"
+#endif
+
+/*The circles are published with release and looked up with acquire ordering.
+ *The statistics are counted with relaxed atomics by all draw units.
+ *Without these builtins the lookups lock `circle_cache_mutex` too.*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define CIRCLE_CACHE_LOCK_FREE      1
+    #define CIRCLE_SLOT_LOAD(slot)      __atomic_load_n(&(slot), __ATOMIC_ACQUIRE)
+    #define CIRCLE_SLOT_STORE(slot, c)  __atomic_store_n(&(slot), (c), __ATOMIC_RELEASE)
+    #define CIRCLE_STAT_INC(cnt)        __atomic_fetch_add(&(cnt), 1, __ATOMIC_RELAXED)
+#else
+    #define CIRCLE_CACHE_LOCK_FREE      0
+    #define CIRCLE_SLOT_LOAD(slot)      (slot)
+    #define CIRCLE_SLOT_STORE(slot, c)  (slot) = (c)
+    #define CIRCLE_STAT_INC(cnt)        (cnt)++
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -62,6 +82,12 @@ static void circ_init(lv_point_t * c, int32_t * tmp, int32_t radius);
 static bool circ_cont(lv_point_t * c);
 static void circ_next(lv_point_t * c, int32_t * tmp);
 static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius);
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_create(int32_t radius);
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius);
+    static void circle_cache_insert(lv_draw_sw_mask_radius_circle_dsc_t * c);
+    static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius);
+#endif
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
@@ -85,6 +111,14 @@ void lv_draw_sw_mask_init(void)
 
 void lv_draw_sw_mask_deinit(void)
 {
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SLOTS; i++) {
+        lv_free(_circle_cache.slots[i]);
+    }
+    lv_memzero(&_circle_cache, sizeof(_circle_cache));
+#endif
+
     lv_mutex_delete(&circle_cache_mutex);
 }
 
@@ -109,33 +143,73 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
-        if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+        /*The cached circles are freed only by the cleanup*/
+        if(radius_p->circle && radius_p->circle->cached == 0) {
+            lv_free(radius_p->circle);
         }
+        radius_p->circle = NULL;
     }
-
-    lv_mutex_unlock(&circle_cache_mutex);
 }
 
 void lv_draw_sw_mask_cleanup(void)
 {
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    lv_mutex_lock(&circle_cache_mutex);
+
+    lv_draw_sw_mask_radius_circle_dsc_t * kept[LV_DRAW_SW_CIRCLE_CACHE_SLOTS];
+    uint32_t kept_cnt = 0;
+    uint32_t i;
+
+    /*If some circles didn't fit, make room for them by dropping the ones not used since the last cleanup*/
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SLOTS; i++) {
+        lv_draw_sw_mask_radius_circle_dsc_t * c = _circle_cache.slots[i];
+        if(c == NULL) continue;
+
+        if(c->used || _circle_cache.rejected == 0) {
+            c->used = 0;
+            kept[kept_cnt++] = c;
+        }
+        else {
+            _circle_cache.size -= c->size;
+            lv_free(c);
         }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
     }
+
+    /*Nothing is drawn now, so the table can be rebuilt without the removed entries*/
+    if(_circle_cache.rejected) {
+        lv_memzero(_circle_cache.slots, sizeof(_circle_cache.slots));
+        _circle_cache.entry_cnt = 0;
+        for(i = 0; i < kept_cnt; i++) {
+            circle_cache_insert(kept[i]);
+        }
+        _circle_cache.rejected = 0;
+    }
+
+    lv_mutex_unlock(&circle_cache_mutex);
+#endif
+}
+
+void lv_draw_sw_mask_circle_cache_get_stats(lv_draw_sw_mask_circle_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_draw_sw_mask_circle_cache_stats_t));
+
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    stats->misses = _circle_cache.misses;
+    stats->hits = _circle_cache.lookups > _circle_cache.misses ? _circle_cache.lookups - _circle_cache.misses : 0;
+    stats->size = _circle_cache.size;
+    stats->max_size = LV_DRAW_SW_CIRCLE_CACHE_SIZE;
+#endif
+}
+
+void lv_draw_sw_mask_circle_cache_reset_stats(void)
+{
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    _circle_cache.lookups = 0;
+    _circle_cache.misses = 0;
+#endif
 }
 
 void lv_draw_sw_mask_line_points_init(lv_draw_sw_mask_line_param_t * param, int32_t p1x, int32_t p1y,
@@ -311,47 +385,14 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
-            return;
-        }
-    }
-
-    /*If not cached use the free entry with lowest life*/
-    lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
-
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    param->circle = circle_cache_get(radius);
+#else
+    param->circle = circle_create(radius);
+#endif
 
+    /*Out of memory, draw sharp corners instead*/
+    if(param->circle == NULL) param->cfg.radius = 0;
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -1068,16 +1109,17 @@ static void circ_next(lv_point_t * c, int32_t * tmp)
     c->y++;
 }
 
+/**
+ * Calculate the anti-aliased circumference of a 1/4 circle
+ * @param c         store the result here. `c->buf` needs to be `radius * 6 + 6` bytes
+ * @param radius    radius of the circle
+ */
 static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius)
 {
     if(radius == 0) return;
     c->radius = radius;
 
-    /*Allocate buffers*/
-    if(c->buf) lv_free(c->buf);
-
-    c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
-    LV_ASSERT_MALLOC(c->buf);
+    /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
     c->x_start_on_y = (uint16_t *)(c->buf + 4 * radius + 4);
@@ -1217,6 +1259,119 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
     lv_free(cir_x);
 }
 
+/**
+ * Allocate and calculate a circle which is not cached yet
+ * @param radius    radius of the circle
+ * @return          the circle with its buffer in the same allocation, free it with `lv_free`. NULL if out of memory.
+ */
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_create(int32_t radius)
+{
+    uint32_t size = sizeof(lv_draw_sw_mask_radius_circle_dsc_t) + radius * 6 + 6;
+    lv_draw_sw_mask_radius_circle_dsc_t * c = lv_malloc(size);
+    LV_ASSERT_MALLOC(c);
+    if(c == NULL) return NULL;
+
+    lv_memzero(c, sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+    c->buf = (uint8_t *)(c + 1);
+    c->size = size;
+    circ_calc_aa4(c, radius);
+    return c;
+}
+
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+
+/**
+ * Find a circle in the cache. Can be called without locking `circle_cache_mutex`
+ * if `CIRCLE_CACHE_LOCK_FREE` is 1.
+ * @param radius    radius of the circle
+ * @return          the cached circle or NULL if not found
+ */
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius)
+{
+    uint32_t i = ((uint32_t)radius * 2654435761U) & (LV_DRAW_SW_CIRCLE_CACHE_SLOTS - 1);
+    uint32_t n;
+    for(n = 0; n < LV_DRAW_SW_CIRCLE_CACHE_SLOTS; n++) {
+        lv_draw_sw_mask_radius_circle_dsc_t * c = CIRCLE_SLOT_LOAD(_circle_cache.slots[i]);
+        if(c == NULL) return NULL;
+        if(c->radius == radius) return c;
+        i = (i + 1) & (LV_DRAW_SW_CIRCLE_CACHE_SLOTS - 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a circle to the hash table. `circle_cache_mutex` needs to be locked
+ * and the table must have an empty slot.
+ * @param c     the circle to add. It's published only when fully calculated.
+ */
+static void circle_cache_insert(lv_draw_sw_mask_radius_circle_dsc_t * c)
+{
+    uint32_t i = ((uint32_t)c->radius * 2654435761U) & (LV_DRAW_SW_CIRCLE_CACHE_SLOTS - 1);
+    while(_circle_cache.slots[i]) {
+        i = (i + 1) & (LV_DRAW_SW_CIRCLE_CACHE_SLOTS - 1);
+    }
+
+    c->cached = 1;
+    _circle_cache.entry_cnt++;
+    CIRCLE_SLOT_STORE(_circle_cache.slots[i], c);
+}
+
+/**
+ * Get a circle from the cache or calculate and add it
+ * @param radius    radius of the circle
+ * @return          the circle. If it's not cached (`cached == 0`) it needs to be freed with the mask parameter.
+ */
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius)
+{
+#if CIRCLE_CACHE_LOCK_FREE
+    CIRCLE_STAT_INC(_circle_cache.lookups);
+    lv_draw_sw_mask_radius_circle_dsc_t * c = circle_cache_find(radius);
+#else
+    lv_mutex_lock(&circle_cache_mutex);
+    CIRCLE_STAT_INC(_circle_cache.lookups);
+    lv_draw_sw_mask_radius_circle_dsc_t * c = circle_cache_find(radius);
+    lv_mutex_unlock(&circle_cache_mutex);
+#endif
+
+    if(c) {
+        /*Avoid writing the shared cache line if not required*/
+        if(c->used == 0) c->used = 1;
+        return c;
+    }
+
+    /*Calculate without holding the lock so the other draw units can use the cache meanwhile*/
+    c = circle_create(radius);
+    if(c == NULL) return NULL;
+
+    lv_mutex_lock(&circle_cache_mutex);
+    CIRCLE_STAT_INC(_circle_cache.misses);
+
+    /*An other draw unit might have added it meanwhile*/
+    lv_draw_sw_mask_radius_circle_dsc_t * cached = circle_cache_find(radius);
+    if(cached) {
+        lv_free(c);
+        c = cached;
+        c->used = 1;
+    }
+    else if(_circle_cache.size + c->size <= LV_DRAW_SW_CIRCLE_CACHE_SIZE &&
+            _circle_cache.entry_cnt < CIRCLE_CACHE_ENTRY_MAX) {
+        c->used = 1;
+        _circle_cache.size += c->size;
+        circle_cache_insert(c);
+    }
+    else {
+        /*Used only by this mask. The cleanup will make room for it.*/
+        _circle_cache.rejected++;
+    }
+
+    lv_mutex_unlock(&circle_cache_mutex);
+
+    return c;
+}
+
+#endif /*LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0*/
+
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start)
 {
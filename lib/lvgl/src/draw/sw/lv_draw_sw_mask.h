@@ -64,6 +64,14 @@ typedef lv_draw_sw_mask_res_t (*lv_draw_sw_mask_xcb_t)(lv_opa_t * mask_buf, int3
                                                        int32_t len,
                                                        void * p);
 
+/** Counters of the circle cache of the radius masks (see `LV_DRAW_SW_CIRCLE_CACHE_SIZE`) */
+typedef struct {
+    uint32_t hits;      /**< Radius masks whose circle was taken from the cache*/
+    uint32_t misses;    /**< Radius masks whose circle had to be calculated*/
+    uint32_t size;      /**< Bytes used by the cached circles*/
+    uint32_t max_size;  /**< Size of the cache in bytes, 0 if disabled*/
+} lv_draw_sw_mask_circle_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -172,6 +180,18 @@ void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_ar
  */
 void lv_draw_sw_mask_map_init(lv_draw_sw_mask_map_param_t * param, const lv_area_t * coords, const lv_opa_t * map);
 
+/**
+ * Get the counters of the circle cache of the radius masks.
+ * The counters are not exact if several draw units use radius masks in parallel.
+ * @param stats     store the counters here
+ */
+void lv_draw_sw_mask_circle_cache_get_stats(lv_draw_sw_mask_circle_cache_stats_t * stats);
+
+/**
+ * Clear the hit and miss counters of the circle cache
+ */
+void lv_draw_sw_mask_circle_cache_reset_stats(void);
+
 #endif /*LV_DRAW_SW_COMPLEX*/
 
 /**********************
@@ -22,6 +22,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of slots in the hash table of the circle cache. Must be a power of 2. */
+#define LV_DRAW_SW_CIRCLE_CACHE_SLOTS   64
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -31,11 +34,26 @@ typedef struct  {
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
     int32_t radius;             /**< The radius of the entry */
+    uint32_t size;              /**< Bytes used by the entry and its buffer */
+    uint8_t cached;             /**< 1: owned by the circle cache, 0: freed with the mask parameter */
+    volatile uint8_t used;      /**< Set when taken from the cache, cleared by `lv_draw_sw_mask_cleanup` */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+typedef struct {
+    /** Hash table of the cached circles with linear probing.
+     *  Written only with `circle_cache_mutex` locked, read without locking.
+     *  Entries are removed only by `lv_draw_sw_mask_cleanup` when nothing is drawn.*/
+    lv_draw_sw_mask_radius_circle_dsc_t * slots[LV_DRAW_SW_CIRCLE_CACHE_SLOTS];
+    uint32_t entry_cnt;
+    uint32_t size;              /**< Bytes used by the entries */
+    uint32_t rejected;          /**< Circles not added since the last cleanup because the cache was full */
+    uint32_t lookups;
+    uint32_t misses;
+} lv_draw_sw_mask_circle_cache_t;
+#endif
+
 struct lv_draw_sw_mask_common_dsc_t {
     lv_draw_sw_mask_xcb_t cb;
     lv_draw_sw_mask_type_t type;
@@ -132,15 +150,14 @@ struct lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 /**
  * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * the temporal (cache) data of the masks.
+ * Nothing can be drawn meanwhile as it frees the circles not used since the last call.
  */
 void lv_draw_sw_mask_cleanup(void);
 
@@ -34,6 +34,9 @@ extern "C" {
 struct lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
     lv_draw_task_t * task_act;
+
+    /** Clip area of the band to render if `task_act` is split among draw units */
+    lv_area_t clip_band;
 #if LV_USE_OS
     lv_thread_sync_t sync;
     lv_thread_t thread;
@@ -43,11 +46,11 @@ struct lv_draw_sw_unit_t {
     uint32_t idx;
 };
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
+    struct lv_cache_t * cache;
+    uint32_t lookups;
+    uint32_t misses;
 } lv_draw_sw_shadow_cache_t;
 #endif
 
@@ -55,6 +58,16 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Create the cache of the blurred shadow corners. Called by `lv_draw_sw_init`.
+ */
+void lv_draw_sw_box_shadow_cache_init(void);
+
+/**
+ * Free the cache of the blurred shadow corners. Called by `lv_draw_sw_deinit`.
+ */
+void lv_draw_sw_box_shadow_cache_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
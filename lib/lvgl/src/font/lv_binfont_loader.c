@@ -121,6 +121,10 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    /*The cached glyphs and the lookup tables point to the font*/
+    lv_font_fmt_txt_glyph_cache_drop_all();
+    lv_font_fmt_txt_accel_drop(font);
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -480,6 +484,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     font->line_height = font_header.ascent - font_header.descent;
     font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
     font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->release_glyph = lv_font_release_glyph_fmt_txt;
     font->subpx = font_header.subpixels_mode;
     font->underline_position = (int8_t) font_header.underline_position;
     font->underline_thickness = (int8_t) font_header.underline_thickness;
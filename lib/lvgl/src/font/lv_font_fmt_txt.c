@@ -14,6 +14,8 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../draw/lv_draw_buf.h"
+#include "../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +24,37 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    #define glyph_cache LV_GLOBAL_DEFAULT()->font_glyph_cache
+    #define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+
+    /*The lookups are counted before the cache is locked, by every thread drawing text*/
+    #if defined(__GNUC__) || defined(__clang__)
+        #define GLYPH_STAT_INC(cnt)     __atomic_fetch_add(&(cnt), 1, __ATOMIC_RELAXED)
+    #else
+        #define GLYPH_STAT_INC(cnt)     (cnt)++
+    #endif
+#endif
+
+#if LV_FONT_FMT_TXT_ACCEL
+    #define accel_list LV_GLOBAL_DEFAULT()->font_fmt_txt_accel
+
+    /*The code points with a direct glyph id lookup: ASCII and Latin-1*/
+    #define ACCEL_RANGE 256
+
+    /*The tables and their font are published with release and looked up with acquire ordering.
+     *Without these builtins the lookups lock `accel_list.lock` too.*/
+    #if defined(__GNUC__) || defined(__clang__)
+        #define ACCEL_LOCK_FREE         1
+        #define ACCEL_LOAD(field)       __atomic_load_n(&(field), __ATOMIC_ACQUIRE)
+        #define ACCEL_STORE(field, v)   __atomic_store_n(&(field), (v), __ATOMIC_RELEASE)
+    #else
+        #define ACCEL_LOCK_FREE         0
+        #define ACCEL_LOAD(field)       (field)
+        #define ACCEL_STORE(field, v)   (field) = (v)
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,11 +63,46 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_font_t * font;
+    uint32_t gid;
+    uint8_t bpp;
+
+    lv_draw_buf_t * draw_buf;
+} glyph_cache_data_t;
+#endif
+
+#if LV_FONT_FMT_TXT_ACCEL
+#if LV_FONT_FMT_TXT_LARGE == 0
+typedef uint16_t accel_gid_t;
+#else
+typedef uint32_t accel_gid_t;
+#endif
+
+struct lv_font_fmt_txt_accel_t {
+    lv_font_fmt_txt_accel_t * next;
+    const lv_font_t * font;             /**< NULL: dropped, can be reused by an other font*/
+    accel_gid_t glyph_ids[ACCEL_RANGE]; /**< Glyph id of each code point, 0: not in the font*/
+
+    /*Open addressing hash table of the kerning pairs (only for `kern_classes == 0`)*/
+    uint32_t * kern_keys;               /**< `gid_left << 16 | gid_right`, 0: empty slot*/
+    int8_t * kern_values;
+    uint32_t kern_bits;                 /**< The table has `1 << kern_bits` slots*/
+};
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
-static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint8_t * bitmap_out);
+static uint32_t get_glyph_dsc_id(const lv_font_t * font, const lv_font_fmt_txt_accel_t * accel, uint32_t letter);
+static uint32_t find_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static int8_t get_kern_value(const lv_font_t * font, const lv_font_fmt_txt_accel_t * accel, uint32_t gid_left,
+                             uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
@@ -47,6 +115,21 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_ACCEL
+    static const lv_font_fmt_txt_accel_t * accel_get(const lv_font_t * font);
+    static lv_font_fmt_txt_accel_t * accel_find(const lv_font_t * font);
+    static lv_font_fmt_txt_accel_t * accel_create(const lv_font_t * font);
+    static void accel_free(lv_font_fmt_txt_accel_t * accel);
+    static void kern_hash_create(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_dsc_t * fdsc);
+    static inline uint32_t kern_hash(uint32_t key, uint32_t bits);
+#endif
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data);
+    static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -78,7 +161,6 @@ static const uint8_t opa2_table[4] = {0, 85, 170, 255};
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
     const lv_font_t * font = g_dsc->resolved_font;
-    uint8_t * bitmap_out = draw_buf->data;
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = g_dsc->gid.index;
@@ -89,6 +171,208 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    if(glyph_cache.cache) {
+        glyph_cache_data_t search_key;
+        search_key.slot.size = sizeof(lv_draw_buf_t) +
+                               lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+        search_key.font = font;
+        search_key.gid = gid;
+        search_key.bpp = (uint8_t)fdsc->bpp;
+        search_key.draw_buf = NULL;
+
+        GLYPH_STAT_INC(glyph_cache.lookups);
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_FONT);
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(glyph_cache.cache, &search_key, NULL);
+        LV_MEM_TAG_POP();
+        if(entry) {
+            g_dsc->entry = entry;
+            glyph_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+            return cached_data->draw_buf;
+        }
+        /*Larger than the whole cache or out of memory: decode into `draw_buf`*/
+    }
+#endif
+
+    return decode_glyph(fdsc, gdsc, draw_buf->data) ? draw_buf : NULL;
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+#if LV_FONT_FMT_TXT_ACCEL
+    const lv_font_fmt_txt_accel_t * accel = accel_get(font);
+#else
+    const lv_font_fmt_txt_accel_t * accel = NULL;
+#endif
+    uint32_t gid = get_glyph_dsc_id(font, accel, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, accel, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, accel, gid, gid_next);
+        }
+    }
+
+    /*Put together a glyph dsc*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->format = (uint8_t)fdsc->bpp;
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+    dsc_out->entry = NULL;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_UNUSED(font);
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(glyph_cache.cache, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+#else
+    LV_UNUSED(g_dsc);
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_init(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    glyph_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(glyph_cache_data_t),
+                                        LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+    });
+    lv_cache_set_name(glyph_cache.cache, "FONT_GLYPH");
+    glyph_cache.lookups = 0;
+    glyph_cache.misses = 0;
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_deinit(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_destroy(glyph_cache.cache, NULL);
+    glyph_cache.cache = NULL;
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_font_fmt_txt_glyph_cache_stats_t));
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    if(glyph_cache.cache == NULL) return;
+
+    stats->misses = glyph_cache.misses;
+    stats->hits = glyph_cache.lookups > glyph_cache.misses ? glyph_cache.lookups - glyph_cache.misses : 0;
+    stats->size = (uint32_t)lv_cache_get_size(glyph_cache.cache, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(glyph_cache.cache, NULL);
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_reset_stats(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    glyph_cache.lookups = 0;
+    glyph_cache.misses = 0;
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_drop_all(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_drop_all(glyph_cache.cache, NULL);
+#endif
+}
+
+void lv_font_fmt_txt_accel_init(void)
+{
+#if LV_FONT_FMT_TXT_ACCEL
+    accel_list.head = NULL;
+    lv_mutex_init(&accel_list.lock);
+#endif
+}
+
+void lv_font_fmt_txt_accel_deinit(void)
+{
+#if LV_FONT_FMT_TXT_ACCEL
+    while(accel_list.head) {
+        lv_font_fmt_txt_accel_t * next = accel_list.head->next;
+        accel_free(accel_list.head);
+        accel_list.head = next;
+    }
+    lv_mutex_delete(&accel_list.lock);
+#endif
+}
+
+void lv_font_fmt_txt_accel_drop(const lv_font_t * font)
+{
+#if LV_FONT_FMT_TXT_ACCEL
+    lv_mutex_lock(&accel_list.lock);
+    /*Lookups of other fonts might walk through the tables, so they stay in the list
+     *and are reused by the next font*/
+    lv_font_fmt_txt_accel_t * accel = accel_find(font);
+    if(accel) {
+        ACCEL_STORE(accel->font, NULL);
+        lv_free(accel->kern_keys);
+        lv_free(accel->kern_values);
+        accel->kern_keys = NULL;
+        accel->kern_values = NULL;
+        accel->kern_bits = 0;
+    }
+    lv_mutex_unlock(&accel_list.lock);
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Expand or decompress the bitmap of a glyph to A8
+ * @param fdsc          the font's descriptor
+ * @param gdsc          the glyph's descriptor
+ * @param bitmap_out    store the A8 bitmap here (`box_h` rows with A8 stride)
+ * @return              true: `bitmap_out` is filled
+ */
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint8_t * bitmap_out)
+{
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
         uint8_t * bitmap_out_tmp = bitmap_out;
@@ -146,7 +430,7 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
                 bitmap_out_tmp += stride;
             }
         }
-        return draw_buf;
+        return true;
     }
     /*Handle compressed bitmap*/
     else {
@@ -154,67 +438,32 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return draw_buf;
+        return true;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
+        return false;
 #endif
     }
 
     /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
+    return false;
 }
 
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
+static uint32_t get_glyph_dsc_id(const lv_font_t * font, const lv_font_fmt_txt_accel_t * accel, uint32_t letter)
 {
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
-
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
-        }
-    }
-
-    /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
-
-    uint32_t adv_w = gdsc->adv_w;
-    if(is_tab) adv_w *= 2;
-
-    adv_w += kv;
-    adv_w  = (adv_w + (1 << 3)) >> 4;
-
-    dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
-    dsc_out->format = (uint8_t)fdsc->bpp;
-    dsc_out->is_placeholder = false;
-    dsc_out->gid.index = gid;
-
-    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+#if LV_FONT_FMT_TXT_ACCEL
+    if(accel && letter < ACCEL_RANGE) return accel->glyph_ids[letter];
+#else
+    LV_UNUSED(accel);
+#endif
 
-    return true;
+    return find_glyph_dsc_id(font, letter);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+/**
+ * Search the glyph id of a code point in the cmaps of the font
+ */
+static uint32_t find_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
 
@@ -263,12 +512,28 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
-static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
+static int8_t get_kern_value(const lv_font_t * font, const lv_font_fmt_txt_accel_t * accel, uint32_t gid_left,
+                             uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
     int8_t value = 0;
 
+#if LV_FONT_FMT_TXT_ACCEL
+    if(accel && accel->kern_keys) {
+        uint32_t key = gid_left << 16 | gid_right;
+        uint32_t mask = (1U << accel->kern_bits) - 1;
+        uint32_t i = kern_hash(key, accel->kern_bits);
+        while(accel->kern_keys[i] != 0) {
+            if(accel->kern_keys[i] == key) return accel->kern_values[i];
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
+#else
+    LV_UNUSED(accel);
+#endif
+
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
@@ -553,3 +818,210 @@ static int unicode_list_compare(const void * ref, const void * element)
 {
     return (*(uint16_t *)ref) - (*(uint16_t *)element);
 }
+
+#if LV_FONT_FMT_TXT_ACCEL
+
+/*-----------------
+ * Lookup tables
+ *----------------*/
+
+/**
+ * Get the lookup tables of a font, create them on the first use.
+ * Draw units running in parallel can call it, so the tables are linked in only when complete.
+ * @return      the tables or NULL if out of memory
+ */
+static const lv_font_fmt_txt_accel_t * accel_get(const lv_font_t * font)
+{
+#if ACCEL_LOCK_FREE
+    lv_font_fmt_txt_accel_t * accel = accel_find(font);
+#else
+    lv_mutex_lock(&accel_list.lock);
+    lv_font_fmt_txt_accel_t * accel = accel_find(font);
+    lv_mutex_unlock(&accel_list.lock);
+#endif
+    if(accel) return accel;
+
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_FONT);
+    accel = accel_create(font);
+    LV_MEM_TAG_POP();
+    return accel;
+}
+
+/**
+ * Find the lookup tables of a font in the list. Can be called without locking `accel_list.lock`
+ * if `ACCEL_LOCK_FREE` is 1.
+ * @return      the tables or NULL if not created yet
+ */
+static lv_font_fmt_txt_accel_t * accel_find(const lv_font_t * font)
+{
+    lv_font_fmt_txt_accel_t * accel;
+    for(accel = ACCEL_LOAD(accel_list.head); accel; accel = accel->next) {
+        if(ACCEL_LOAD(accel->font) == font) return accel;
+    }
+
+    return NULL;
+}
+
+static lv_font_fmt_txt_accel_t * accel_create(const lv_font_t * font)
+{
+    lv_mutex_lock(&accel_list.lock);
+
+    /*An other thread might have created it meanwhile*/
+    lv_font_fmt_txt_accel_t * accel = accel_find(font);
+    if(accel) {
+        lv_mutex_unlock(&accel_list.lock);
+        return accel;
+    }
+
+    /*Reuse the tables of a dropped font*/
+    bool reused = true;
+    accel = accel_find(NULL);
+    if(accel == NULL) {
+        reused = false;
+        accel = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_accel_t));
+        if(accel == NULL) {
+            LV_LOG_WARN("Couldn't allocate the lookup tables of the font");
+            lv_mutex_unlock(&accel_list.lock);
+            return NULL;
+        }
+    }
+
+    uint32_t i;
+    for(i = 0; i < ACCEL_RANGE; i++) {
+        accel->glyph_ids[i] = (accel_gid_t)find_glyph_dsc_id(font, i);
+    }
+
+    /*Without the hash table the kerning pairs are still found by binary search*/
+    kern_hash_create(accel, font->dsc);
+
+    /*Publish the tables only when complete*/
+    ACCEL_STORE(accel->font, font);
+    if(!reused) {
+        accel->next = accel_list.head;
+        ACCEL_STORE(accel_list.head, accel);
+    }
+
+    lv_mutex_unlock(&accel_list.lock);
+
+    return accel;
+}
+
+static void accel_free(lv_font_fmt_txt_accel_t * accel)
+{
+    lv_free(accel->kern_keys);
+    lv_free(accel->kern_values);
+    lv_free(accel);
+}
+
+static void kern_hash_create(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*Class based kerning is already a direct lookup*/
+    if(fdsc->kern_dsc == NULL || fdsc->kern_classes != 0) return;
+
+    const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+    if(kdsc->pair_cnt == 0 || kdsc->glyph_ids_size > 1) return;
+
+    /*Keep the table at most half full to have short probe sequences*/
+    uint32_t bits = 4;
+    while((1U << bits) < kdsc->pair_cnt * 2) bits++;
+    uint32_t slot_cnt = 1U << bits;
+
+    accel->kern_keys = lv_malloc_zeroed(slot_cnt * sizeof(uint32_t));
+    accel->kern_values = lv_malloc(slot_cnt);
+    if(accel->kern_keys == NULL || accel->kern_values == NULL) {
+        lv_free(accel->kern_keys);
+        lv_free(accel->kern_values);
+        accel->kern_keys = NULL;
+        accel->kern_values = NULL;
+        return;
+    }
+
+    accel->kern_bits = bits;
+    uint32_t p;
+    for(p = 0; p < kdsc->pair_cnt; p++) {
+        uint32_t left;
+        uint32_t right;
+        if(kdsc->glyph_ids_size == 0) {
+            const uint8_t * ids = kdsc->glyph_ids;
+            left = ids[p * 2];
+            right = ids[p * 2 + 1];
+        }
+        else {
+            const uint16_t * ids = kdsc->glyph_ids;
+            left = ids[p * 2];
+            right = ids[p * 2 + 1];
+        }
+
+        uint32_t key = left << 16 | right;
+        uint32_t i = kern_hash(key, bits);
+        while(accel->kern_keys[i] != 0 && accel->kern_keys[i] != key) {
+            i = (i + 1) & (slot_cnt - 1);
+        }
+        accel->kern_keys[i] = key;
+        accel->kern_values[i] = kdsc->values[p];
+    }
+}
+
+static inline uint32_t kern_hash(uint32_t key, uint32_t bits)
+{
+    /*Fibonacci hashing: the high bits of the product are well mixed*/
+    return (key * 2654435761U) >> (32 - bits);
+}
+
+#endif /*LV_FONT_FMT_TXT_ACCEL*/
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+
+/*-----------------
+ * Cache Callbacks
+ *----------------*/
+
+static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Called with the cache locked so the counter is exact*/
+    glyph_cache.misses++;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = node->font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[node->gid];
+
+    node->draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, gdsc->box_w, gdsc->box_h, LV_COLOR_FORMAT_A8,
+                                           LV_STRIDE_AUTO);
+    if(node->draw_buf == NULL) return false;
+
+    if(!decode_glyph(fdsc, gdsc, node->draw_buf->data)) {
+        lv_draw_buf_destroy(node->draw_buf);
+        node->draw_buf = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(node->draw_buf) lv_draw_buf_destroy(node->draw_buf);
+    node->draw_buf = NULL;
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    if(lhs->bpp != rhs->bpp) {
+        return lhs->bpp > rhs->bpp ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0*/
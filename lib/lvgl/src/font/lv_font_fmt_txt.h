@@ -185,6 +185,14 @@ typedef struct {
     uint16_t bitmap_format  : 2;
 } lv_font_fmt_txt_dsc_t;
 
+/** Counters of the glyph cache (see `LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE`) */
+typedef struct {
+    uint32_t hits;      /**< Glyphs taken already decoded from the cache*/
+    uint32_t misses;    /**< Glyphs which had to be decoded*/
+    uint32_t size;      /**< Bytes used by the cached glyphs*/
+    uint32_t max_size;  /**< Size of the cache in bytes, 0 if disabled*/
+} lv_font_fmt_txt_glyph_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -209,6 +217,32 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Used as `release_glyph` callback in lvgl's native font format.
+ * Gives back the glyph cache entry taken by `lv_font_get_bitmap_fmt_txt`.
+ * `lv_font_glyph_release_draw_data` calls it for the fonts which don't set `release_glyph`.
+ * @param font      pointer to font
+ * @param g_dsc     the glyph descriptor passed to `lv_font_get_bitmap_fmt_txt`
+ */
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Get the counters of the glyph cache.
+ * The hit counter is not exact if several draw units render letters in parallel.
+ * @param stats     store the counters here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats);
+
+/**
+ * Clear the hit and miss counters of the glyph cache
+ */
+void lv_font_fmt_txt_glyph_cache_reset_stats(void);
+
+/**
+ * Free all the cached glyphs, e.g. before deleting a font loaded at run time
+ */
+void lv_font_fmt_txt_glyph_cache_drop_all(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -41,10 +42,54 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+/** Glyph id and kerning lookup tables of a font, see `LV_FONT_FMT_TXT_ACCEL`*/
+typedef struct lv_font_fmt_txt_accel_t lv_font_fmt_txt_accel_t;
+
+#if LV_FONT_FMT_TXT_ACCEL
+typedef struct {
+    lv_font_fmt_txt_accel_t * head;     /**< Tables of the fonts used so far*/
+    lv_mutex_t lock;                    /**< Serializes the changes of the list*/
+} lv_font_fmt_txt_accel_list_t;
+#endif
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0
+typedef struct {
+    struct lv_cache_t * cache;
+    uint32_t lookups;
+    uint32_t misses;
+} lv_font_fmt_txt_glyph_cache_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Create the glyph cache of the fmt_txt fonts. Called by `lv_init`.
+ */
+void lv_font_fmt_txt_glyph_cache_init(void);
+
+/**
+ * Free the glyph cache. Called by `lv_deinit`.
+ */
+void lv_font_fmt_txt_glyph_cache_deinit(void);
+
+/**
+ * Prepare the glyph id and kerning lookup tables. Called by `lv_init`.
+ */
+void lv_font_fmt_txt_accel_init(void);
+
+/**
+ * Free the lookup tables of all fonts. Called by `lv_deinit`.
+ */
+void lv_font_fmt_txt_accel_deinit(void);
+
+/**
+ * Release the lookup tables of a font, e.g. before deleting it. They are reused by the next font.
+ * @param font      pointer to a font
+ */
+void lv_font_fmt_txt_accel_drop(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
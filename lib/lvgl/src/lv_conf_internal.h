@@ -27,6 +27,8 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -212,6 +214,46 @@
             #endif
         #endif
     #endif
+
+    /*Bytes of small freed blocks (<= 256 bytes) each thread keeps to allocate them without locking the heap.
+     *Only with `LV_USE_OS == LV_OS_PTHREAD`. 0: disable*/
+    #ifndef LV_MEM_THREAD_CACHE_SIZE
+        #ifdef CONFIG_LV_MEM_THREAD_CACHE_SIZE
+            #define LV_MEM_THREAD_CACHE_SIZE CONFIG_LV_MEM_THREAD_CACHE_SIZE
+        #else
+            #define LV_MEM_THREAD_CACHE_SIZE 0
+        #endif
+    #endif
+
+    /*Number of `lv_malloc()` blocks whose tag (subsystem), size and age are recorded to analyze the fragmentation
+     *and to trace the allocations (see `lv_mem_track_dump()`). At most 7/8 of them are used. 0: disable*/
+    #ifndef LV_MEM_TRACK_BLOCK_CNT
+        #ifdef CONFIG_LV_MEM_TRACK_BLOCK_CNT
+            #define LV_MEM_TRACK_BLOCK_CNT CONFIG_LV_MEM_TRACK_BLOCK_CNT
+        #else
+            #define LV_MEM_TRACK_BLOCK_CNT 0
+        #endif
+    #endif
+
+    /*Size of the bulk heap in bytes, e.g. in external SDRAM, used for the draw buffers and the decoded images
+     *while the small blocks stay in the `LV_MEM_SIZE` heap (see `lv_malloc_heap()`). 0: only one heap*/
+    #ifndef LV_MEM_BULK_SIZE
+        #ifdef CONFIG_LV_MEM_BULK_SIZE
+            #define LV_MEM_BULK_SIZE CONFIG_LV_MEM_BULK_SIZE
+        #else
+            #define LV_MEM_BULK_SIZE 0
+        #endif
+    #endif
+
+    /*Address of the bulk heap. 0: add its pools (up to `LV_MEM_BULK_SIZE` bytes each) with
+     *`lv_mem_add_heap_pool(LV_MEM_HEAP_BULK, ...)`, e.g. once the external RAM is initialized*/
+    #ifndef LV_MEM_BULK_ADR
+        #ifdef CONFIG_LV_MEM_BULK_ADR
+            #define LV_MEM_BULK_ADR CONFIG_LV_MEM_BULK_ADR
+        #else
+            #define LV_MEM_BULK_ADR 0
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -483,6 +525,18 @@
         #endif
     #endif
 
+    /* Split draw tasks covering at least this many pixels into horizontal bands
+     * and render the bands in parallel on the idle draw units.
+     * Only fills, images and layers are split. 0: disable.
+     * Has effect only if LV_DRAW_SW_DRAW_UNIT_CNT > 1 */
+    #ifndef LV_DRAW_SW_SPLIT_MIN_AREA
+        #ifdef CONFIG_LV_DRAW_SW_SPLIT_MIN_AREA
+            #define LV_DRAW_SW_SPLIT_MIN_AREA CONFIG_LV_DRAW_SW_SPLIT_MIN_AREA
+        #else
+            #define LV_DRAW_SW_SPLIT_MIN_AREA   0
+        #endif
+    #endif
+
     /* Use Arm-2D to accelerate the sw render */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -516,9 +570,9 @@
     #endif
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        /*Size of the cache of the blurred shadow corners [bytes].
+        *A corner costs `(shadow_width + radius)^2` bytes, the least recently used ones are dropped.
+        *0: blur the corners for every draw task*/
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -527,15 +581,14 @@
             #endif
         #endif
 
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
+        /*Size of the cache of the anti-aliased circle corners used by the radius masks [bytes].
+        *A corner costs about `radius * 6` bytes, it's shared by all the draw units without locking.
+        *0: calculate the corners for every mask*/
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #else
-                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024U)
             #endif
         #endif
     #endif
@@ -566,6 +619,17 @@
             #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
         #endif
     #endif
+
+    /* Size of the cache of the gradient color and opacity maps [bytes].
+     * A map costs about 4 bytes per pixel of the gradient's width (or height if vertical).
+     * 0: recalculate the maps for every draw task */
+    #ifndef LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE  0
+        #endif
+    #endif
 #endif
 
 /* Use NXP's VG-Lite GPU on iMX RTxxx platforms. */
@@ -1076,7 +1140,8 @@
 
 /*Default cache size in bytes.
  *Used by image decoders such as `lv_lodepng` to keep the decoded image in the memory.
- *If size is not set to 0, the decoder will fail to decode when the cache is full.
+ *The image with the lowest decode time per byte is evicted first (see `lv_image_cache_set_class()`).
+ *The decoder fails only if the cache is full of images in use or pinned with `lv_image_cache_pin()`.
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
 #ifndef LV_CACHE_DEF_SIZE
     #ifdef CONFIG_LV_CACHE_DEF_SIZE
@@ -1096,6 +1161,17 @@
     #endif
 #endif
 
+/*1: decode the images of the `lv_image` widgets in a thread. A placeholder is drawn until they are in the image cache
+ *(see `lv_image_set_placeholder()`). Needs `LV_USE_OS` and the image cache.
+ *The images drawn directly from the memory (uncompressed C arrays) are not affected.*/
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1201,29 @@
     #endif
 #endif
 
+/* Cache the resolved style property values of each lv_obj_t per part and state.
+ * Set the number of cached values per object (power of 2, e.g. 64), 0 to disable.
+ * Costs 8 bytes per value on 32-bit targets (16 on 64-bit), allocated when the object's style is first read.
+ * Styles shared by several objects need `lv_obj_report_style_change()` after a change. */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE 0
+    #endif
+#endif
+
+/* Index the properties of the non-constant styles having at least this many properties
+ * in a small hash table so that they are found without scanning all of them.
+ * Costs 16..256 bytes per such style. 0: always scan the properties */
+#ifndef LV_STYLE_PROP_INDEX_MIN
+    #ifdef CONFIG_LV_STYLE_PROP_INDEX_MIN
+        #define LV_STYLE_PROP_INDEX_MIN CONFIG_LV_STYLE_PROP_INDEX_MIN
+    #else
+        #define LV_STYLE_PROP_INDEX_MIN 8
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1636,6 +1735,28 @@
     #endif
 #endif
 
+/*Size of the cache of ready-to-blend (A8) glyphs of `lv_font_fmt_txt` fonts in bytes.
+ *Saves expanding (1, 2, 4 bpp) or decompressing the same glyphs on every redraw.
+ *0: no cache, the glyphs are decoded every time they are drawn*/
+#ifndef LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
+/*1: Look up the glyph ids of ASCII and Latin-1 in a table and the kerning pairs in a hash table.
+ *The tables are built on the first use of an `lv_font_fmt_txt` font (~530 bytes + ~10 bytes per kerning pair)
+ *and make measuring and wrapping long texts cheaper.*/
+#ifndef LV_FONT_FMT_TXT_ACCEL
+    #ifdef CONFIG_LV_FONT_FMT_TXT_ACCEL
+        #define LV_FONT_FMT_TXT_ACCEL CONFIG_LV_FONT_FMT_TXT_ACCEL
+    #else
+        #define LV_FONT_FMT_TXT_ACCEL 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -15,6 +15,7 @@
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "lv_init.h"
 #include "core/lv_global.h"
 #include "core/lv_obj.h"
@@ -118,11 +119,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -230,6 +226,9 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+    lv_font_fmt_txt_glyph_cache_init();
+    lv_font_fmt_txt_accel_init();
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -384,6 +383,8 @@ void lv_deinit(void)
 #endif
 
     lv_image_decoder_deinit();
+    lv_font_fmt_txt_glyph_cache_deinit();
+    lv_font_fmt_txt_accel_deinit();
 
     lv_refr_deinit();
 
@@ -53,6 +53,9 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    cache->evict_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -86,6 +89,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_END;
@@ -95,6 +99,10 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -133,7 +141,9 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
         return NULL;
     }
 
-    lv_cache_entry_t * entry = cache_add_internal_no_lock(cache, key, user_data);
+    /*E.g. two draw units decoded the same image: the entry added first is returned to both*/
+    lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
+    if(entry == NULL) entry = cache_add_internal_no_lock(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
     }
@@ -156,6 +166,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_END;
@@ -163,6 +174,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->miss_cnt++;
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -242,6 +254,46 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 
     LV_PROFILER_END;
 }
+void lv_cache_set_entry_cost(lv_cache_t * cache, lv_cache_entry_t * entry, uint32_t cost, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(entry);
+
+    if(cache->clz->set_cost_cb == NULL) return;
+
+    lv_mutex_lock(&cache->lock);
+    /*A dropped entry is not in the cache anymore*/
+    if(!lv_cache_entry_is_invalid(entry)) {
+        cache->clz->set_cost_cb(cache, entry, cost, user_data);
+    }
+    lv_mutex_unlock(&cache->lock);
+}
+bool lv_cache_set_pinned(lv_cache_t * cache, const void * key, bool pinned, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(key);
+
+    lv_mutex_lock(&cache->lock);
+    lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
+    if(entry != NULL) {
+        lv_cache_entry_set_pinned(entry, pinned);
+    }
+    lv_mutex_unlock(&cache->lock);
+
+    return entry != NULL;
+}
+
+bool lv_cache_contains(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(key);
+
+    lv_mutex_lock(&cache->lock);
+    lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
+    lv_mutex_unlock(&cache->lock);
+
+    return entry != NULL;
+}
 
 void lv_cache_set_max_size(lv_cache_t * cache, size_t max_size, void * user_data)
 {
@@ -263,6 +315,22 @@ size_t lv_cache_get_free_size(lv_cache_t * cache, void * user_data)
     LV_UNUSED(user_data);
     return cache->max_size - cache->size;
 }
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats)
+{
+    stats->hits = cache->hit_cnt;
+    stats->misses = cache->miss_cnt;
+    stats->evictions = cache->evict_cnt;
+    stats->size = cache->size;
+    stats->max_size = cache->max_size;
+}
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    lv_mutex_lock(&cache->lock);
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    cache->evict_cnt = 0;
+    lv_mutex_unlock(&cache->lock);
+}
 bool lv_cache_is_enabled(lv_cache_t * cache)
 {
     return cache->max_size > 0;
@@ -326,6 +394,7 @@ static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_dat
     cache->clz->remove_cb(cache, victim, user_data);
     cache->ops.free_cb(lv_cache_entry_get_data(victim), user_data);
     lv_cache_entry_delete(victim);
+    cache->evict_cnt++;
     return true;
 }
 
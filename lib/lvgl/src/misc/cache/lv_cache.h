@@ -18,6 +18,7 @@ extern "C" {
 #include "../lv_types.h"
 
 #include "lv_cache_lru_rb.h"
+#include "lv_cache_gds.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
@@ -35,13 +36,15 @@ extern "C" {
 
 /**
  * Create a cache object with the given parameters.
- * @param cache_class   The class of the cache. Currently only support one two builtin classes:
+ * @param cache_class   The class of the cache. Currently only support three builtin classes:
  *                        - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  *                        - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ *                        - lv_cache_class_gds_size for GreedyDual-Size cache with cost and size-based eviction policy.
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
  *                        - lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
  *                        - lv_cache_class_lru_rb_size: max_size is the maximum size of the cache in bytes.
+ *                        - lv_cache_class_gds_size: max_size is the maximum size of the cache in bytes.
  * @param ops           A set of operations that can be performed on the cache. See lv_cache_ops_t for details.
  * @return              Returns a pointer to the created cache object on success, `NULL` on error.
  */
@@ -81,6 +84,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
 
 /**
  * Add a new cache entry with the given key and data. If the cache is full, the cache's policy will be used to evict an entry.
+ * If an entry with the same key is already in the cache (e.g. added by an other thread), it's returned instead
+ * and its data is not changed: compare its data with the key to know whether it's a new entry.
  * @param cache         The cache object pointer to add the entry.
  * @param key           The key of the entry to add.
  * @param user_data     A user data pointer that will be passed to the create callback.
@@ -134,6 +139,36 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data);
  */
 bool lv_cache_evict_one(lv_cache_t * cache, void * user_data);
 
+/**
+ * Set the cost of recreating the data of an entry, e.g. its decode time.
+ * The cost aware classes (lv_cache_class_gds_size) keep the costly entries longer, the other classes ignore it.
+ * @param cache         The cache object pointer the entry belongs to.
+ * @param entry         The cache entry to weigh.
+ * @param cost          The cost of the entry, in a unit common to all the entries of the cache.
+ * @param user_data     A user data pointer.
+ */
+void lv_cache_set_entry_cost(lv_cache_t * cache, lv_cache_entry_t * entry, uint32_t cost, void * user_data);
+
+/**
+ * Pin or unpin the entry of a key. A pinned entry is never evicted, it stays until it's unpinned or dropped.
+ * @param cache         The cache object pointer to look up the key.
+ * @param key           The key of the entry.
+ * @param pinned        true: pin the entry; false: make it evictable again.
+ * @param user_data     A user data pointer.
+ * @return              Returns true if the key was found, false otherwise.
+ */
+bool lv_cache_set_pinned(lv_cache_t * cache, const void * key, bool pinned, void * user_data);
+
+/**
+ * Check whether the entry of a key is in the cache, without acquiring it and without counting a hit or a miss.
+ * The entry's priority is changed by the cache's policy as in lv_cache_acquire().
+ * @param cache         The cache object pointer to look up the key.
+ * @param key           The key of the entry.
+ * @param user_data     A user data pointer.
+ * @return              Returns true if the key was found, false otherwise.
+ */
+bool lv_cache_contains(lv_cache_t * cache, const void * key, void * user_data);
+
 /**
  * Set the maximum size of the cache.
  * If the current cache size is greater than the new maximum size, the cache's policy will be used to evict entries until the new maximum size is reached.
@@ -177,6 +212,19 @@ size_t lv_cache_get_free_size(lv_cache_t * cache, void * user_data);
  */
 bool lv_cache_is_enabled(lv_cache_t * cache);
 
+/**
+ * Get the hit, miss and eviction counters and the size of the cache.
+ * @param cache         The cache object pointer to get the counters of.
+ * @param stats         Store the counters here.
+ */
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats);
+
+/**
+ * Clear the hit, miss and eviction counters of the cache.
+ * @param cache         The cache object pointer to clear the counters of.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /**
  * Set the compare callback of the cache.
  * @param cache         The cache object pointer to set the compare callback.
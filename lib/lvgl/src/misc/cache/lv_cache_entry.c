@@ -25,6 +25,7 @@ struct lv_cache_entry_t {
     uint32_t node_size;
 
     bool is_invalid;
+    bool is_pinned;
 };
 /**********************
  *  STATIC PROTOTYPES
@@ -89,6 +90,16 @@ bool lv_cache_entry_is_invalid(lv_cache_entry_t * entry)
     LV_ASSERT_NULL(entry);
     return entry->is_invalid;
 }
+void lv_cache_entry_set_pinned(lv_cache_entry_t * entry, bool is_pinned)
+{
+    LV_ASSERT_NULL(entry);
+    entry->is_pinned = is_pinned;
+}
+bool lv_cache_entry_is_pinned(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    return entry->is_pinned;
+}
 void * lv_cache_entry_get_data(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
@@ -154,6 +165,7 @@ void lv_cache_entry_init(lv_cache_entry_t * entry, const lv_cache_t * cache, con
     entry->node_size = node_size;
     entry->ref_cnt = 0;
     entry->is_invalid = false;
+    entry->is_pinned = false;
 }
 void lv_cache_entry_delete(lv_cache_entry_t * entry)
 {
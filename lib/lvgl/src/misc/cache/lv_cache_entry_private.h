@@ -32,6 +32,7 @@ void   lv_cache_entry_inc_ref(lv_cache_entry_t * entry);
 void   lv_cache_entry_dec_ref(lv_cache_entry_t * entry);
 void   lv_cache_entry_set_node_size(lv_cache_entry_t * entry, uint32_t node_size);
 void   lv_cache_entry_set_invalid(lv_cache_entry_t * entry, bool is_invalid);
+void   lv_cache_entry_set_pinned(lv_cache_entry_t * entry, bool is_pinned);
 void   lv_cache_entry_set_cache(lv_cache_entry_t * entry, const lv_cache_t * cache);
 void * lv_cache_entry_acquire_data(lv_cache_entry_t * entry);
 void   lv_cache_entry_release_data(lv_cache_entry_t * entry, void * user_data);
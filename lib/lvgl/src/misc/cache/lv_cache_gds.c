@@ -0,0 +1,517 @@
+/**
+* @file lv_cache_gds.c
+*
+*/
+
+/*
+ * GreedyDual-Size (Cao and Irani): every entry has a priority H = L + cost / size, set when it's
+ * added and again on every hit. The entry with the lowest H is evicted and L, the inflation, takes
+ * its H. So an entry which is cheap to recreate per byte goes first, and an expensive one which is
+ * not used anymore ages out as L catches up with its H.
+ *
+ * The entries are found with a RB tree by their key, like in lv_cache_lru_rb.c, and ordered in a
+ * binary min-heap by H. Each entry stores its heap index.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_gds.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_math.h"
+#include "../lv_rb_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HEAP_MIN_SIZE 16
+#define HEAP_NONE UINT32_MAX
+
+/*The cost per byte is a fixed point number, a 1 MB entry of cost 1 still gets 16 steps*/
+#define COST_SHIFT 24
+
+/*Cost of an entry until lv_cache_set_entry_cost() is called*/
+#define DEFAULT_COST 1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint64_t priority;      /*H: the inflation when it was last used + cost per byte*/
+    uint32_t cost;
+    uint32_t heap_index;
+} gds_node_t;
+
+struct lv_cache_gds_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+
+    gds_node_t ** heap;     /*The node with the lowest priority is the root*/
+    uint32_t heap_cnt;
+    uint32_t heap_size;
+
+    uint32_t node_ofs;      /*Offset of the gds_node_t in the data of a RB node*/
+    uint64_t inflation;     /*L: the priority of the last evicted entry*/
+};
+typedef struct lv_cache_gds_t lv_cache_gds_t_;
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cb(lv_cache_t * cache);
+static void destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+static void set_cost_cb(lv_cache_t * cache, lv_cache_entry_t * entry, uint32_t cost, void * user_data);
+
+inline static gds_node_t * get_gds_node(lv_cache_gds_t_ * gds, void * data);
+inline static void * get_node_data(lv_cache_gds_t_ * gds, gds_node_t * node);
+static uint32_t get_data_size(const void * data);
+static uint64_t get_priority(lv_cache_gds_t_ * gds, gds_node_t * node);
+static gds_node_t * find_victim(lv_cache_gds_t_ * gds, uint32_t i);
+
+static bool heap_reserve(lv_cache_gds_t_ * gds, uint32_t cnt);
+static void heap_remove(lv_cache_gds_t_ * gds, gds_node_t * node);
+static void heap_sift_up(lv_cache_gds_t_ * gds, uint32_t i);
+static void heap_sift_down(lv_cache_gds_t_ * gds, uint32_t i);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_gds_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .set_cost_cb = set_cost_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_cache_gds_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_cache_gds_t_));
+    return res;
+}
+
+static bool init_cb(lv_cache_t * cache)
+{
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds->cache.ops.compare_cb);
+    LV_ASSERT_NULL(gds->cache.ops.free_cb);
+    LV_ASSERT(gds->cache.node_size > 0);
+
+    if(gds->cache.node_size <= 0 || gds->cache.ops.compare_cb == NULL || gds->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*The gds_node_t follows the entry, aligned for its 64 bit priority*/
+    gds->node_ofs = LV_ALIGN_UP(lv_cache_entry_get_size(gds->cache.node_size), sizeof(uint64_t));
+    if(!lv_rb_init(&gds->rb, gds->cache.ops.compare_cb, gds->node_ofs + sizeof(gds_node_t))) {
+        return false;
+    }
+
+    gds->heap = NULL;
+    gds->heap_cnt = 0;
+    gds->heap_size = 0;
+    gds->inflation = 0;
+
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    if(gds == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+
+    lv_free(gds->heap);
+    gds->heap = NULL;
+    gds->heap_size = 0;
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*cache hit. L never decreases so the priority can only grow.*/
+    gds_node_t * gds_node = get_gds_node(gds, node->data);
+    gds_node->priority = get_priority(gds, gds_node);
+    heap_sift_down(gds, gds_node->heap_index);
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return NULL;
+    }
+
+    if(!heap_reserve(gds, gds->heap_cnt + 1)) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&gds->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    void * data = node->data;
+    lv_memcpy(data, key, cache->node_size);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    gds_node_t * gds_node = get_gds_node(gds, data);
+    gds_node->cost = DEFAULT_COST;
+    gds_node->priority = get_priority(gds, gds_node);
+    gds->heap[gds->heap_cnt] = gds_node;
+    gds_node->heap_index = gds->heap_cnt;
+    gds->heap_cnt++;
+    heap_sift_up(gds, gds_node->heap_index);
+
+    cache->size += get_data_size(key);
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(entry);
+
+    if(gds == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    heap_remove(gds, get_gds_node(gds, data));
+    lv_rb_remove_node(&gds->rb, node);
+
+    cache->size -= get_data_size(data);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    gds->cache.ops.free_cb(data, user_data);
+    cache->size -= get_data_size(data);
+
+    heap_remove(gds, get_gds_node(gds, data));
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_rb_remove_node(&gds->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    if(gds == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < gds->heap_cnt; i++) {
+        /*free user handled data and do other clean up*/
+        void * data = get_node_data(gds, gds->heap[i]);
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            gds->cache.ops.free_cb(data, user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            used_cnt++;
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&gds->rb);
+    gds->heap_cnt = 0;
+    gds->inflation = 0;
+
+    cache->size = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    gds_node_t * victim = find_victim(gds, 0);
+    if(victim == NULL) {
+        return NULL;
+    }
+
+    /*The victim is removed by the caller. An entry which was referenced during the previous evictions
+     *can have a lower priority than the inflation, it mustn't decrease.*/
+    gds->inflation = LV_MAX(gds->inflation, victim->priority);
+
+    return lv_cache_entry_get_entry(get_node_data(gds, victim), cache->node_size);
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    if(gds == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? get_data_size(key) : 0;
+    if(data_size > gds->cache.max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, gds->cache.max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > gds->cache.max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static void set_cost_cb(lv_cache_t * cache, lv_cache_entry_t * entry, uint32_t cost, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_gds_t_ * gds = (lv_cache_gds_t_ *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(entry);
+
+    gds_node_t * node = get_gds_node(gds, lv_cache_entry_get_data(entry));
+    node->cost = LV_MAX(cost, 1);
+
+    /*As if it was used now with its real cost. The priority can be lower than before.*/
+    node->priority = get_priority(gds, node);
+    heap_sift_up(gds, node->heap_index);
+    heap_sift_down(gds, node->heap_index);
+}
+
+inline static gds_node_t * get_gds_node(lv_cache_gds_t_ * gds, void * data)
+{
+    return (gds_node_t *)((uint8_t *)data + gds->node_ofs);
+}
+
+inline static void * get_node_data(lv_cache_gds_t_ * gds, gds_node_t * node)
+{
+    return (uint8_t *)node - gds->node_ofs;
+}
+
+static uint32_t get_data_size(const void * data)
+{
+    const lv_cache_slot_size_t * slot = (const lv_cache_slot_size_t *)data;
+    return slot->size;
+}
+
+/**
+ * Get the priority of an entry used now: H = L + cost / size
+ * @param gds       pointer to a GDS cache
+ * @param node      the node of the entry
+ * @return          the new priority of the entry
+ */
+static uint64_t get_priority(lv_cache_gds_t_ * gds, gds_node_t * node)
+{
+    uint32_t size = LV_MAX(get_data_size(get_node_data(gds, node)), 1);
+    return gds->inflation + ((uint64_t)node->cost << COST_SHIFT) / size;
+}
+
+/**
+ * Find the evictable node with the lowest priority in a sub-heap.
+ * A node which is not referenced and not pinned is the best of its sub-heap, so only the referenced
+ * and pinned nodes are walked through.
+ * @param gds       pointer to a GDS cache
+ * @param i         index of the root of the sub-heap
+ * @return          the node to evict or NULL if all are in use
+ */
+static gds_node_t * find_victim(lv_cache_gds_t_ * gds, uint32_t i)
+{
+    if(i >= gds->heap_cnt) return NULL;
+
+    gds_node_t * node = gds->heap[i];
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(get_node_data(gds, node), gds->cache.node_size);
+    if(lv_cache_entry_get_ref(entry) == 0 && !lv_cache_entry_is_pinned(entry)) {
+        return node;
+    }
+
+    gds_node_t * left = find_victim(gds, 2 * i + 1);
+    gds_node_t * right = find_victim(gds, 2 * i + 2);
+    if(left == NULL) return right;
+    if(right == NULL) return left;
+    return right->priority < left->priority ? right : left;
+}
+
+inline static void heap_set(lv_cache_gds_t_ * gds, uint32_t i, gds_node_t * node)
+{
+    gds->heap[i] = node;
+    node->heap_index = i;
+}
+
+/**
+ * Make sure the heap can store some nodes
+ * @param gds       pointer to a GDS cache
+ * @param cnt       number of nodes to store
+ * @return          true: success; false: out of memory
+ */
+static bool heap_reserve(lv_cache_gds_t_ * gds, uint32_t cnt)
+{
+    if(cnt <= gds->heap_size) return true;
+
+    uint32_t new_size = LV_MAX(gds->heap_size * 2, HEAP_MIN_SIZE);
+    gds_node_t ** new_heap = lv_realloc(gds->heap, new_size * sizeof(gds_node_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    gds->heap = new_heap;
+    gds->heap_size = new_size;
+    return true;
+}
+
+/**
+ * Remove a node from the heap. Does nothing if it's not in the heap.
+ * @param gds       pointer to a GDS cache
+ * @param node      pointer to a node
+ */
+static void heap_remove(lv_cache_gds_t_ * gds, gds_node_t * node)
+{
+    uint32_t i = node->heap_index;
+    if(i == HEAP_NONE) return;
+
+    node->heap_index = HEAP_NONE;
+    gds->heap_cnt--;
+    if(i == gds->heap_cnt) return;
+
+    /*Move the last node to the hole and restore the order*/
+    gds_node_t * last = gds->heap[gds->heap_cnt];
+    heap_set(gds, i, last);
+    heap_sift_up(gds, i);
+    heap_sift_down(gds, last->heap_index);
+}
+
+static void heap_sift_up(lv_cache_gds_t_ * gds, uint32_t i)
+{
+    gds_node_t * node = gds->heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(node->priority >= gds->heap[parent]->priority) break;
+        heap_set(gds, i, gds->heap[parent]);
+        i = parent;
+    }
+    heap_set(gds, i, node);
+}
+
+static void heap_sift_down(lv_cache_gds_t_ * gds, uint32_t i)
+{
+    gds_node_t * node = gds->heap[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= gds->heap_cnt) break;
+        if(child + 1 < gds->heap_cnt && gds->heap[child + 1]->priority < gds->heap[child]->priority) child++;
+        if(gds->heap[child]->priority >= node->priority) break;
+        heap_set(gds, i, gds->heap[child]);
+        i = child;
+    }
+    heap_set(gds, i, node);
+}
@@ -0,0 +1,48 @@
+/**
+* @file lv_cache_gds.h
+*
+*/
+
+#ifndef LV_CACHE_GDS_H
+#define LV_CACHE_GDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_entry.h"
+#include "lv_cache_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+/**
+ * GreedyDual-Size cache: the size of an entry is read from its `lv_cache_slot_size_t` like in
+ * lv_cache_class_lru_rb_size, its cost is set with lv_cache_set_entry_cost() (1 by default).
+ * The entry with the lowest cost per byte is evicted first, the others age as entries are evicted.
+ */
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_cache_class_t lv_cache_class_gds_size;
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CACHE_GDS_H*/
@@ -417,7 +417,7 @@ static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
     LV_LL_READ_BACK(&lru->ll, tail) {
         lv_rb_node_t * tail_node = *tail;
         lv_cache_entry_t * entry = lv_cache_entry_get_entry(tail_node->data, cache->node_size);
-        if(lv_cache_entry_get_ref(entry) == 0) {
+        if(lv_cache_entry_get_ref(entry) == 0 && !lv_cache_entry_is_pinned(entry)) {
             return entry;
         }
     }
@@ -107,6 +107,12 @@ typedef lv_cache_entry_t * (*lv_cache_get_victim_cb)(lv_cache_t * cache, void *
 typedef lv_cache_reserve_cond_res_t (*lv_cache_reserve_cond_cb)(lv_cache_t * cache, const void * key, size_t size,
                                                                 void * user_data);
 
+/**
+ * The cache set cost function, used by the cost aware cache classes to weigh an entry with the cost of recreating its data.
+ * It's optional, the classes that ignore the cost leave it `NULL`.
+ */
+typedef void (*lv_cache_set_cost_cb)(lv_cache_t * cache, lv_cache_entry_t * entry, uint32_t cost, void * user_data);
+
 /**
  * The cache operations struct
  */
@@ -120,9 +126,10 @@ struct lv_cache_ops_t {
  * The cache entry struct
  */
 struct lv_cache_t {
-    const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
+    const lv_cache_class_t * clz;     /**< Cache class. There are three built-in classes:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_gds_size for GreedyDual-Size cache with cost and size-based eviction policy. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -134,14 +141,30 @@ struct lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    uint32_t hit_cnt;                 /**< Lookups that found the entry */
+    uint32_t miss_cnt;                /**< Lookups that didn't find the entry */
+    uint32_t evict_cnt;               /**< Entries evicted to make room */
 };
 
+/**
+ * Counters of a cache, see lv_cache_get_stats()
+ */
+typedef struct {
+    uint32_t hits;                    /**< Lookups that found the entry */
+    uint32_t misses;                  /**< Lookups that didn't find the entry */
+    uint32_t evictions;               /**< Entries evicted to make room for new ones */
+    uint32_t size;                    /**< Current size of the cache */
+    uint32_t max_size;                /**< Maximum size of the cache, 0 if disabled */
+} lv_cache_stats_t;
+
 /**
  * Cache class struct for building custom cache classes
  *
  * Examples:
  * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * - lv_cache_class_gds_size for GreedyDual-Size cache with cost and size-based eviction policy.
  */
 struct lv_cache_class_t {
     lv_cache_alloc_cb_t alloc_cb;                 /**< The allocation function for cache entries */
@@ -155,6 +178,7 @@ struct lv_cache_class_t {
     lv_cache_drop_all_cb_t drop_all_cb;           /**< The drop all function for cache entries */
     lv_cache_get_victim_cb get_victim_cb;         /**< The get victim function for cache entries */
     lv_cache_reserve_cond_cb reserve_cond_cb;     /**< The reserve condition function for cache entries */
+    lv_cache_set_cost_cb set_cost_cb;             /**< The set cost function for cache entries, can be `NULL` */
 };
 
 /*-----------------
@@ -34,6 +34,7 @@
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
+static lv_cache_t * image_cache_create(const lv_cache_class_t * cache_class, uint32_t size);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -57,17 +58,21 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
-    sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
-        .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
-        .create_cb = NULL,
-        .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
-    });
-
-    lv_cache_set_name(img_cache_p, CACHE_NAME);
+    /*Weigh the images by their decode time (see lv_image_decoder_open())*/
+    img_cache_p = image_cache_create(&lv_cache_class_gds_size, size);
     return img_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
 }
 
+lv_result_t lv_image_cache_set_class(const lv_cache_class_t * cache_class)
+{
+    lv_cache_t * new_cache = image_cache_create(cache_class, lv_cache_get_max_size(img_cache_p, NULL));
+    if(new_cache == NULL) return LV_RESULT_INVALID;
+
+    lv_cache_destroy(img_cache_p, NULL);
+    img_cache_p = new_cache;
+    return LV_RESULT_OK;
+}
+
 void lv_image_cache_resize(uint32_t new_size, bool evict_now)
 {
     lv_cache_set_max_size(img_cache_p, new_size, NULL);
@@ -99,6 +104,49 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+lv_result_t lv_image_cache_pin(const void * src)
+{
+    if(!lv_image_cache_is_enabled()) return LV_RESULT_INVALID;
+
+    /*Decode it if it's not cached yet, with the args of the draw units*/
+    lv_image_decoder_dsc_t dsc;
+    lv_result_t res = lv_image_decoder_open(&dsc, src, NULL);
+    if(res != LV_RESULT_OK) return res;
+
+    /*Pin it while it's open so that it can't be evicted in the meantime*/
+    lv_image_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+    if(!lv_cache_set_pinned(img_cache_p, &search_key, true, NULL)) {
+        LV_LOG_INFO("the image is not cached, e.g. it's used directly from the memory");
+        res = LV_RESULT_INVALID;
+    }
+
+    lv_image_decoder_close(&dsc);
+    return res;
+}
+
+void lv_image_cache_unpin(const void * src)
+{
+    lv_image_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    lv_cache_set_pinned(img_cache_p, &search_key, false, NULL);
+}
+
+void lv_image_cache_get_stats(lv_cache_stats_t * stats)
+{
+    lv_cache_get_stats(img_cache_p, stats);
+}
+
+void lv_image_cache_reset_stats(void)
+{
+    lv_cache_reset_stats(img_cache_p);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -130,6 +178,19 @@ static lv_cache_compare_res_t image_cache_compare_cb(
     return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
 }
 
+static lv_cache_t * image_cache_create(const lv_cache_class_t * cache_class, uint32_t size)
+{
+    lv_cache_t * cache = lv_cache_create(cache_class,
+    sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
+    });
+
+    lv_cache_set_name(cache, CACHE_NAME);
+    return cache;
+}
+
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
 {
     LV_UNUSED(user_data);
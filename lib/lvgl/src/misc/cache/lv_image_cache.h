@@ -16,6 +16,7 @@ extern "C" {
 
 #include "../../lv_conf_internal.h"
 #include "../lv_types.h"
+#include "lv_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -30,7 +31,7 @@ extern "C" {
  **********************/
 
 /**
- * Initialize image cache.
+ * Initialize image cache. The images are evicted by their decode time per byte (lv_cache_class_gds_size).
  * @param  size size of the cache in bytes.
  * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
  */
@@ -56,6 +57,41 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Replace the eviction policy of the image cache, keeping its size. The cached images are dropped.
+ * Call it only while no image is open, e.g. at start up.
+ * @param cache_class   `lv_cache_class_gds_size` (default) or `lv_cache_class_lru_rb_size`
+ * @return LV_RESULT_OK: the class is replaced, LV_RESULT_INVALID: out of memory.
+ */
+lv_result_t lv_image_cache_set_class(const lv_cache_class_t * cache_class);
+
+/**
+ * Decode an image into the cache if it's not there yet and keep it until it's unpinned or dropped.
+ * The pinned images still count in the size of the cache.
+ * @param src pointer to an image source.
+ * @return LV_RESULT_OK: the image is pinned, LV_RESULT_INVALID: it couldn't be decoded or it's not cached
+ *         (e.g. an uncompressed image is used directly from the memory).
+ */
+lv_result_t lv_image_cache_pin(const void * src);
+
+/**
+ * Let the image cache evict a pinned image again.
+ * @param src pointer to an image source.
+ */
+void lv_image_cache_unpin(const void * src);
+
+/**
+ * Get the hit, miss and eviction counters and the size of the image cache.
+ * A lookup of an image which is used directly from the memory is a miss too.
+ * @param stats store the counters here.
+ */
+void lv_image_cache_get_stats(lv_cache_stats_t * stats);
+
+/**
+ * Clear the hit, miss and eviction counters of the image cache.
+ */
+void lv_image_cache_reset_stats(void);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -22,12 +22,21 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 #define state LV_GLOBAL_DEFAULT()->anim_state
-#define anim_ll_p &(state.anim_ll)
+#define ANIM_MIN_SIZE 16
+#define ANIM_BUCKET_MIN_BITS 4
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Paths which are evaluated without calling `path_cb`*/
+typedef enum {
+    ANIM_PATH_NONE = 0,
+    ANIM_PATH_LINEAR,
+    ANIM_PATH_BEZIER,
+    ANIM_PATH_STEP,
+} anim_path_kind_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -40,6 +49,13 @@ static uint32_t convert_speed_to_time(uint32_t speed, int32_t start, int32_t end
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(lv_anim_t * a_current);
 static void remove_anim(void * a);
+static bool anim_insert(lv_anim_t * a);
+static void anim_unlink(lv_anim_t * a);
+static void anim_compact(void);
+static uint32_t hash_var(const void * var);
+static bool hash_resize(uint32_t bits);
+static anim_path_kind_t get_path(const lv_anim_t * a, lv_anim_bezier3_para_t * para);
+static int32_t eval_path(const lv_anim_t * a, anim_path_kind_t path, const lv_anim_bezier3_para_t * para);
 
 /**********************
  *  STATIC VARIABLES
@@ -60,7 +76,6 @@ static void remove_anim(void * a);
 
 void lv_anim_core_init(void)
 {
-    lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
     state.anim_list_changed = false;
@@ -70,6 +85,18 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+    lv_free(state.anims);
+    lv_free(state.values);
+    lv_free(state.paths);
+    lv_free(state.buckets);
+    state.anims = NULL;
+    state.values = NULL;
+    state.paths = NULL;
+    state.buckets = NULL;
+    state.anim_end = 0;
+    state.anim_size = 0;
+    state.bucket_bits = 0;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -87,8 +114,9 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 {
     LV_TRACE_ANIM("begin");
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = lv_ll_ins_head(anim_ll_p);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_ANIM);
+    lv_anim_t * new_anim = lv_malloc(sizeof(lv_anim_t));
+    LV_MEM_TAG_POP();
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
 
@@ -98,6 +126,16 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
 
+    /*Add the new animation to the running ones*/
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_ANIM);
+    bool inserted = anim_insert(new_anim);
+    LV_MEM_TAG_POP();
+    if(!inserted) {
+        LV_LOG_WARN("couldn't add the animation");
+        lv_free(new_anim);
+        return NULL;
+    }
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->get_value_cb) {
@@ -120,7 +158,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
+    /*Creating an animation changed the running ones.
      *It's important if it happens in a ready callback. (see `anim_timer`)*/
     anim_mark_list_change();
 
@@ -146,35 +184,46 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
     lv_anim_t * a;
     bool del_any = false;
-    a        = lv_ll_get_head(anim_ll_p);
-    while(a != NULL) {
-        bool del = false;
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+
+    if(var != NULL) {
+        /*Look up again after each delete, because we don't know
+         *how the animations were changed in `a->deleted_cb` */
+        while((a = lv_anim_get(var, exec_cb)) != NULL) {
             remove_anim(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
             del_any = true;
-            del = true;
         }
-
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
     }
+    else {
+        /*The slots are not compacted meanwhile so the others stay in place*/
+        state.iter_depth++;
+        uint32_t i;
+        for(i = 0; i < state.anim_end; i++) {
+            a = state.anims[i];
+            if(a != NULL && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+                remove_anim(a);
+                del_any = true;
+            }
+        }
+        state.iter_depth--;
+        anim_compact();
+    }
+
+    if(del_any) anim_mark_list_change();
 
     return del_any;
 }
 
 void lv_anim_delete_all(void)
 {
-    lv_ll_clear_custom(anim_ll_p, remove_anim);
-    anim_mark_list_change();
+    lv_anim_delete(NULL, NULL);
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+    if(state.buckets == NULL) return NULL;
+
     lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) {
+    for(a = state.buckets[hash_var(var)]; a != NULL; a = a->hash_next) {
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
@@ -190,11 +239,7 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) cnt++;
-
-    return cnt;
+    return (uint16_t)state.anim_cnt;
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -497,23 +542,53 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
-    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
+    /*Started animations are added to the end and the slots are not compacted until the end
+     *of the round, so the slots can be read even if the callbacks start or delete animations.
+     *The newest animations run first.*/
+    state.iter_depth++;
+
+    uint32_t tick = lv_tick_get();
+    uint32_t end = state.anim_end;
+    uint32_t i;
+
+    /*Advance the time of all the animations and evaluate the built-in paths in one pass.
+     *No callbacks are called here so the animations can't change meanwhile.*/
+    for(i = end; i-- > 0;) {
+        lv_anim_t * a = state.anims[i];
+        state.paths[i] = ANIM_PATH_NONE;
+        if(a == NULL || a->run_round == state.anim_run_round) continue;
+
+        a->act_time += tick - a->last_timer_run;
+        a->last_timer_run = tick;
+
+        /*Starting calls callbacks so it's done in the second pass*/
+        if(!a->start_cb_called || a->act_time < 0) continue;
+
+        lv_anim_bezier3_para_t para;
+        anim_path_kind_t path = get_path(a, &para);
+        if(path != ANIM_PATH_NONE) {
+            if(a->act_time > a->duration) a->act_time = a->duration;
+            state.values[i] = eval_path(a, path, &para);
+            state.paths[i] = path;
+        }
+    }
 
-    while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
-        a->act_time += elaps;
+    /*Start the animations, evaluate the other paths and apply the values*/
+    for(i = end; i-- > 0;) {
+        lv_anim_t * a = state.anims[i];
+        if(a == NULL || a->run_round == state.anim_run_round) continue;
 
-        a->last_timer_run = lv_tick_get();
+        /*A nested `lv_anim_refr_now()` needs to know which anim has run already*/
+        a->run_round = state.anim_run_round;
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
+        /*It's set if an animation is started or deleted by the callbacks, maybe this one*/
         state.anim_list_changed = false;
 
-        if(a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
+        int32_t new_value;
+        if(state.paths[i] != ANIM_PATH_NONE) {
+            new_value = state.values[i];
+        }
+        else {
             /*The animation will run now for the first time. Call `start_cb`*/
             if(!a->start_cb_called && a->act_time >= 0) {
 
@@ -532,34 +607,27 @@ static void anim_timer(lv_timer_t * param)
                 remove_concurrent_anims(a);
             }
 
-            if(a->act_time >= 0) {
-                if(a->act_time > a->duration) a->act_time = a->duration;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
+            if(a->act_time < 0) continue;
+            if(a->act_time > a->duration) a->act_time = a->duration;
 
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
-                }
+            new_value = a->path_cb(a);
+        }
 
-                /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
-                    anim_completed_handler(a);
-                }
-            }
+        if(new_value != a->current_value) {
+            a->current_value = new_value;
+            /*Apply the calculated value*/
+            if(a->exec_cb) a->exec_cb(a->var, new_value);
+            if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
+        /*If the time is elapsed the animation is ready*/
+        if(!state.anim_list_changed && a->act_time >= a->duration) {
+            anim_completed_handler(a);
+        }
     }
 
+    state.iter_depth--;
+    anim_compact();
 }
 
 /**
@@ -579,10 +647,10 @@ static void anim_completed_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_duration == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Remove the animation from the running ones.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
+        anim_unlink(a);
+        /*Pause the animation timer if it was the last one*/
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
@@ -615,7 +683,7 @@ static void anim_completed_handler(lv_anim_t * a)
 static void anim_mark_list_change(void)
 {
     state.anim_list_changed = true;
-    if(lv_ll_get_head(anim_ll_p) == NULL)
+    if(state.anim_cnt == 0)
         lv_timer_pause(state.timer);
     else
         lv_timer_resume(state.timer);
@@ -669,7 +737,7 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 
     lv_anim_t * a;
     bool del_any = false;
-    a = lv_ll_get_head(anim_ll_p);
+    a = state.buckets[hash_var(a_current->var)];
     while(a != NULL) {
         bool del = false;
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
@@ -680,19 +748,16 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
-            if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
+            remove_anim(a);
             anim_mark_list_change();
 
             del_any = true;
             del = true;
         }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        /*Always start from the head of the bucket on delete, because we don't know
+         *how the animations were changed in `a->deleted_cb` */
+        a = del ? state.buckets[hash_var(a_current->var)] : a->hash_next;
     }
 
     return del_any;
@@ -701,7 +766,204 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 static void remove_anim(void * a)
 {
     lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
+    anim_unlink(anim);
     if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
     lv_free(a);
 }
+
+/**
+ * Add an animation to the end of the slots and to the head of its bucket
+ * @param a     pointer to an allocated animation
+ * @return      false if there was no memory
+ */
+static bool anim_insert(lv_anim_t * a)
+{
+    if(state.anim_end == state.anim_size) anim_compact();
+
+    if(state.anim_end == state.anim_size) {
+        uint32_t new_size = state.anim_size ? state.anim_size * 2 : ANIM_MIN_SIZE;
+        lv_anim_t ** anims = lv_realloc(state.anims, new_size * sizeof(lv_anim_t *));
+        if(anims == NULL) return false;
+        state.anims = anims;
+        int32_t * values = lv_realloc(state.values, new_size * sizeof(int32_t));
+        if(values == NULL) return false;
+        state.values = values;
+        uint8_t * paths = lv_realloc(state.paths, new_size);
+        if(paths == NULL) return false;
+        state.paths = paths;
+        state.anim_size = new_size;
+    }
+
+    /*Keep at most one animation per bucket on average. If it can't grow the buckets get longer.*/
+    if(state.buckets == NULL) {
+        if(!hash_resize(ANIM_BUCKET_MIN_BITS)) return false;
+    }
+    else if(state.anim_cnt >= (1U << state.bucket_bits)) {
+        hash_resize(state.bucket_bits + 1);
+    }
+
+    a->slot = state.anim_end;
+    state.anims[a->slot] = a;
+    state.paths[a->slot] = ANIM_PATH_NONE;
+    state.anim_end++;
+    state.anim_cnt++;
+
+    lv_anim_t ** head = &state.buckets[hash_var(a->var)];
+    a->hash_next = *head;
+    *head = a;
+
+    return true;
+}
+
+/**
+ * Remove an animation from its slot and its bucket. It's not freed.
+ * Only the slot is cleared to keep the order, the slots are compacted when at least half of them are cleared.
+ * @param a     pointer to a running animation
+ */
+static void anim_unlink(lv_anim_t * a)
+{
+    lv_anim_t ** p = &state.buckets[hash_var(a->var)];
+    while(*p != a) {
+        if(*p == NULL) {
+            /*`var` was changed since the start, search in all the buckets*/
+            uint32_t b = 0;
+            p = &state.buckets[0];
+            while(*p != a) {
+                p = *p ? &(*p)->hash_next : &state.buckets[++b];
+            }
+            break;
+        }
+        p = &(*p)->hash_next;
+    }
+    *p = a->hash_next;
+
+    state.anims[a->slot] = NULL;
+    state.anim_cnt--;
+    if(state.anim_end - state.anim_cnt >= state.anim_cnt) anim_compact();
+}
+
+/**
+ * Remove the cleared slots keeping the order of the animations. Not done while the slots are iterated.
+ */
+static void anim_compact(void)
+{
+    if(state.iter_depth || state.anim_end == state.anim_cnt) return;
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < state.anim_end; i++) {
+        lv_anim_t * a = state.anims[i];
+        if(a == NULL) continue;
+        a->slot = cnt;
+        state.anims[cnt] = a;
+        cnt++;
+    }
+    state.anim_end = cnt;
+}
+
+static uint32_t hash_var(const void * var)
+{
+    /*The low bits of the pointers are usually 0 due to the alignment*/
+    uint32_t h = (uint32_t)((lv_uintptr_t)var >> 3) * 2654435761U;
+    return h >> (32 - state.bucket_bits);
+}
+
+/**
+ * Allocate new buckets and move the animations into them keeping their order
+ * @param bits  log2 of the new bucket count
+ * @return      false if there was no memory (the old buckets are kept)
+ */
+static bool hash_resize(uint32_t bits)
+{
+    lv_anim_t ** buckets = lv_malloc_zeroed(sizeof(lv_anim_t *) << bits);
+    if(buckets == NULL) return false;
+
+    lv_anim_t ** old_buckets = state.buckets;
+    uint32_t old_cnt = old_buckets ? 1U << state.bucket_bits : 0;
+    state.buckets = buckets;
+    state.bucket_bits = bits;
+
+    uint32_t b;
+    for(b = 0; b < old_cnt; b++) {
+        lv_anim_t * a = old_buckets[b];
+        while(a) {
+            lv_anim_t * next = a->hash_next;
+            /*Append so the animations of a `var` stay newest first*/
+            lv_anim_t ** tail = &buckets[hash_var(a->var)];
+            while(*tail) tail = &(*tail)->hash_next;
+            a->hash_next = NULL;
+            *tail = a;
+            a = next;
+        }
+    }
+
+    lv_free(old_buckets);
+    return true;
+}
+
+/**
+ * Recognize the built-in paths which can be evaluated without calling `path_cb`
+ * @param a     pointer to an animation
+ * @param para  the control points of the bezier paths are stored here
+ * @return      the kind of the path or `ANIM_PATH_NONE` if `path_cb` needs to be called
+ */
+static anim_path_kind_t get_path(const lv_anim_t * a, lv_anim_bezier3_para_t * para)
+{
+    lv_anim_path_cb_t path_cb = a->path_cb;
+
+    if(path_cb == lv_anim_path_linear) return ANIM_PATH_LINEAR;
+    if(path_cb == lv_anim_path_step) return ANIM_PATH_STEP;
+
+    if(path_cb == lv_anim_path_ease_in_out) {
+        para->x1 = LV_BEZIER_VAL_FLOAT(0.42);
+        para->y1 = LV_BEZIER_VAL_FLOAT(0);
+        para->x2 = LV_BEZIER_VAL_FLOAT(0.58);
+        para->y2 = LV_BEZIER_VAL_FLOAT(1);
+    }
+    else if(path_cb == lv_anim_path_ease_out) {
+        para->x1 = LV_BEZIER_VAL_FLOAT(0);
+        para->y1 = LV_BEZIER_VAL_FLOAT(0);
+        para->x2 = LV_BEZIER_VAL_FLOAT(0.58);
+        para->y2 = LV_BEZIER_VAL_FLOAT(1);
+    }
+    else if(path_cb == lv_anim_path_ease_in) {
+        para->x1 = LV_BEZIER_VAL_FLOAT(0.42);
+        para->y1 = LV_BEZIER_VAL_FLOAT(0);
+        para->x2 = LV_BEZIER_VAL_FLOAT(1);
+        para->y2 = LV_BEZIER_VAL_FLOAT(1);
+    }
+    else if(path_cb == lv_anim_path_overshoot) {
+        para->x1 = 341;
+        para->y1 = 0;
+        para->x2 = 683;
+        para->y2 = 1300;
+    }
+    else if(path_cb == lv_anim_path_custom_bezier3) {
+        *para = a->parameter.bezier3;
+    }
+    else {
+        return ANIM_PATH_NONE;
+    }
+
+    return ANIM_PATH_BEZIER;
+}
+
+/**
+ * Evaluate a built-in path. It gives the same value as the path's `path_cb`.
+ * @param a     pointer to an animation
+ * @param path  the kind of the path returned by `get_path`
+ * @param para  the control points returned by `get_path`
+ * @return      the current value of the animation
+ */
+static int32_t eval_path(const lv_anim_t * a, anim_path_kind_t path, const lv_anim_bezier3_para_t * para)
+{
+    switch(path) {
+        case ANIM_PATH_LINEAR:
+            return lv_anim_path_linear(a);
+        case ANIM_PATH_STEP:
+            return lv_anim_path_step(a);
+        case ANIM_PATH_BEZIER:
+        default:
+            return lv_anim_path_cubic_bezier(a, para->x1, para->y1, para->x2, para->y2);
+    }
+}
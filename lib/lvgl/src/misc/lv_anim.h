@@ -146,6 +146,8 @@ struct lv_anim_t {
     } parameter;
 
     /* Animation system use these - user shouldn't set */
+    lv_anim_t * hash_next;        /**< Next animation in the same bucket of the `var` hash*/
+    uint32_t slot;                /**< Index in the array of the running animations*/
     uint32_t last_timer_run;
     uint8_t playback_now : 1;     /**< Play back is in progress*/
     uint8_t run_round : 1;        /**< Indicates the animation has run in this round*/
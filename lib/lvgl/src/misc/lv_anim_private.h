@@ -28,7 +28,19 @@ typedef struct {
     bool anim_list_changed;
     bool anim_run_round;
     lv_timer_t * timer;
-    lv_ll_t anim_ll;
+
+    /*The running animations as a structure of arrays, indexed by `lv_anim_t::slot`*/
+    lv_anim_t ** anims;         /**< In start order, NULL if deleted (until compacted)*/
+    int32_t * values;           /**< Values evaluated by the batch pass of the animation timer*/
+    uint8_t * paths;            /**< Built-in path evaluated into `values`, 0 if none*/
+    uint32_t anim_end;          /**< Number of used slots*/
+    uint32_t anim_cnt;          /**< Number of running animations*/
+    uint32_t anim_size;         /**< Number of allocated slots*/
+    uint32_t iter_depth;        /**< The slots are not compacted while it's not 0*/
+
+    /*Running animations by `var`, newest first*/
+    lv_anim_t ** buckets;
+    uint32_t bucket_bits;
 } lv_anim_state_t;
 
 /**********************
@@ -20,6 +20,9 @@
 #define lv_style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define last_custom_prop_id LV_GLOBAL_DEFAULT()->style_last_custom_prop_id
 
+/*The props are allocated in steps to not reallocate on every new property*/
+#define PROP_ALLOC_STEP 4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -27,6 +30,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t get_index_bits(uint32_t prop_cnt);
+static size_t get_alloc_size(uint32_t prop_cnt);
+static int32_t find_prop(const lv_style_t * style, lv_style_prop_t prop);
+static void update_index(lv_style_t * style);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -219,7 +226,9 @@ lv_style_prop_t lv_style_register_prop(uint8_t flag)
         required_size = (required_size + 31) & ~31;
         LV_ASSERT_MSG(required_size > 0, "required size has become 0?");
         uint8_t * old_p = lv_style_custom_prop_flag_lookup_table;
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
         uint8_t * new_p = lv_realloc(old_p, required_size * sizeof(uint8_t));
+        LV_MEM_TAG_POP();
         if(new_p == NULL) {
             LV_LOG_ERROR("Unable to allocate space for custom property lookup table");
             return LV_STYLE_PROP_INV;
@@ -248,40 +257,39 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
         return false;
     }
 
-    if(style->prop_cnt == 0)  return false;
+    int32_t i = find_prop(style, prop);
+    if(i < 0) return false;
 
-    uint8_t * tmp = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    uint8_t * old_props = (uint8_t *)tmp;
-    uint32_t i;
-    for(i = 0; i < style->prop_cnt; i++) {
-        if(old_props[i] == prop) {
-            lv_style_value_t * old_values = (lv_style_value_t *)style->values_and_props;
-
-            size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
-            uint8_t * new_values_and_props = lv_malloc(size);
-            if(new_values_and_props == NULL) return false;
-            style->values_and_props = new_values_and_props;
-            style->prop_cnt--;
-
-            tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-            uint8_t * new_props = (uint8_t *)tmp;
-            lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
-
-            uint32_t j;
-            for(i = j = 0; j <= style->prop_cnt;
-                j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
-                if(old_props[j] != prop) {
-                    new_values[i] = old_values[j];
-                    new_props[i++] = old_props[j];
-                }
-            }
-
-            lv_free(old_values);
-            return true;
-        }
+    uint32_t prop_cnt = style->prop_cnt;
+    uint8_t * values_and_props = style->values_and_props;
+    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    lv_style_prop_t * old_props = values_and_props + prop_cnt * sizeof(lv_style_value_t);
+    lv_style_prop_t * new_props = values_and_props + (prop_cnt - 1) * sizeof(lv_style_value_t);
+
+    /*Close the gap in the values, then move the props after the last value and skip the removed one*/
+    lv_memmove(&values[i], &values[i + 1], (prop_cnt - i - 1) * sizeof(lv_style_value_t));
+    lv_memmove(new_props, old_props, i);
+    lv_memmove(new_props + i, old_props + i + 1, prop_cnt - i - 1);
+    style->prop_cnt--;
+
+    if(style->prop_cnt == 0) {
+        lv_free(values_and_props);
+        style->values_and_props = NULL;
+        style->index_bits = 0;
+        return true;
+    }
+
+    size_t size = get_alloc_size(style->prop_cnt);
+    if(size != get_alloc_size(prop_cnt)) {
+        /*If shrinking fails the larger buffer is still good*/
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
+        values_and_props = lv_realloc(values_and_props, size);
+        LV_MEM_TAG_POP();
+        if(values_and_props) style->values_and_props = values_and_props;
     }
 
-    return false;
+    update_index(style);
+    return true;
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
@@ -295,39 +303,41 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     LV_ASSERT(prop != LV_STYLE_PROP_INV);
 
-    lv_style_prop_t * props;
-    int32_t i;
-
-    if(style->values_and_props) {
-        props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                values[i] = value;
-                return;
-            }
-        }
+    int32_t i = find_prop(style, prop);
+    if(i >= 0) {
+        lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+        values[i] = value;
+        return;
     }
 
-    size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
-    uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
-    if(values_and_props == NULL) return;
-    style->values_and_props = values_and_props;
+    uint32_t prop_cnt = style->prop_cnt;
+    if(prop_cnt == 254) {
+        LV_LOG_WARN("Too many properties in the style");
+        return;
+    }
 
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    /*Shift all props to make place for the value before them*/
-    for(i = style->prop_cnt - 1; i >= 0; i--) {
-        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    uint8_t * values_and_props = style->values_and_props;
+    size_t size = get_alloc_size(prop_cnt + 1);
+    if(values_and_props == NULL || size != get_alloc_size(prop_cnt)) {
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_STYLE);
+        values_and_props = lv_realloc(values_and_props, size);
+        LV_MEM_TAG_POP();
+        if(values_and_props == NULL) return;
+        style->values_and_props = values_and_props;
     }
-    style->prop_cnt++;
 
-    /*Go to the new position with the props*/
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    /*Shift all props to make place for the value before them*/
+    lv_style_prop_t * props = values_and_props + prop_cnt * sizeof(lv_style_value_t);
+    lv_memmove(props + sizeof(lv_style_value_t), props, prop_cnt);
+    props += sizeof(lv_style_value_t);
     lv_style_value_t * values = (lv_style_value_t *)values_and_props;
 
     /*Set the new property and value*/
-    props[style->prop_cnt - 1] = prop;
-    values[style->prop_cnt - 1] = value;
+    props[prop_cnt] = prop;
+    values[prop_cnt] = value;
+    style->prop_cnt++;
+
+    update_index(style);
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
@@ -440,3 +450,91 @@ uint8_t lv_style_prop_lookup_flags(lv_style_prop_t prop)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Get the size of the hash index of a style
+ * @param prop_cnt      number of properties in the style
+ * @return              the index has `1 << index_bits` entries, 0: no index
+ */
+static uint32_t get_index_bits(uint32_t prop_cnt)
+{
+#if LV_STYLE_PROP_INDEX_MIN
+    if(prop_cnt < LV_STYLE_PROP_INDEX_MIN) return 0;
+
+    /*Keep the index at most half full so that the lookups probe 1-2 entries.
+     *Use the allocated count to not resize the index on every new property.*/
+    uint32_t alloc_cnt = LV_ALIGN_UP(prop_cnt, PROP_ALLOC_STEP);
+    uint32_t bits = 4;
+    while(bits < 8 && ((uint32_t)1 << bits) < 2 * alloc_cnt) bits++;
+    return bits;
+#else
+    LV_UNUSED(prop_cnt);
+    return 0;
+#endif
+}
+
+/**
+ * Get the size to allocate for the values, the props and the index of a style
+ * @param prop_cnt      number of properties in the style
+ * @return              size in bytes
+ */
+static size_t get_alloc_size(uint32_t prop_cnt)
+{
+    uint32_t alloc_cnt = LV_ALIGN_UP(prop_cnt, PROP_ALLOC_STEP);
+    size_t size = alloc_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+
+    uint32_t index_bits = get_index_bits(prop_cnt);
+    if(index_bits) size += (size_t)1 << index_bits;
+
+    return size;
+}
+
+/**
+ * Find a property in a non-constant style
+ * @param style     pointer to a style
+ * @param prop      the property to find
+ * @return          index of the property, -1 if not found
+ */
+static int32_t find_prop(const lv_style_t * style, lv_style_prop_t prop)
+{
+    if(style->prop_cnt == 0) return -1;
+
+    lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t i;
+    if(style->index_bits) {
+        const uint8_t * index = props + style->prop_cnt;
+        uint32_t mask = ((uint32_t)1 << style->index_bits) - 1;
+        for(i = prop & mask; index[i] != 0; i = (i + 1) & mask) {
+            if(props[index[i] - 1] == prop) return index[i] - 1;
+        }
+        return -1;
+    }
+
+    for(i = 0; i < style->prop_cnt; i++) {
+        if(props[i] == prop) return i;
+    }
+    return -1;
+}
+
+/**
+ * Rebuild the hash index after the props following the values, or remove it if the style is small.
+ * The props move with the number of values so the index is rebuilt when a property is added or removed.
+ * @param style     pointer to a style
+ */
+static void update_index(lv_style_t * style)
+{
+    style->index_bits = get_index_bits(style->prop_cnt);
+    if(style->index_bits == 0) return;
+
+    lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint8_t * index = props + style->prop_cnt;
+    uint32_t mask = ((uint32_t)1 << style->index_bits) - 1;
+    lv_memzero(index, mask + 1);
+
+    uint32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        uint32_t h = props[i] & mask;
+        while(index[h] != 0) h = (h + 1) & mask;
+        index[h] = (uint8_t)(i + 1);
+    }
+}
@@ -374,6 +374,7 @@ typedef struct {
 
     uint32_t has_group;
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
+    uint8_t index_bits; /**< The props are followed by a hash index of `1 << index_bits` bytes. 0: no index*/
 } lv_style_t;
 
 /**********************
@@ -510,6 +511,21 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     else {
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint32_t i;
+#if LV_STYLE_PROP_INDEX_MIN
+        if(style->index_bits) {
+            /*Open addressing by the prop ID, the entries are the prop indices + 1, 0 if empty*/
+            const uint8_t * index = props + style->prop_cnt;
+            uint32_t mask = ((uint32_t)1 << style->index_bits) - 1;
+            for(i = prop & mask; index[i] != 0; i = (i + 1) & mask) {
+                if(props[index[i] - 1] == prop) {
+                    lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+                    *value = values[index[i] - 1];
+                    return LV_STYLE_RES_FOUND;
+                }
+            }
+            return LV_STYLE_RES_NOT_FOUND;
+        }
+#endif
         for(i = 0; i < style->prop_cnt; i++) {
             if(props[i] == prop) {
                 lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
@@ -20,6 +20,8 @@
 
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_NONE UINT32_MAX
+#define HEAP_MIN_SIZE 8
 
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
@@ -31,9 +33,15 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static bool heap_reserve(uint32_t cnt);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,43 +98,20 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Run the ready timers in the order of their deadlines. The heap's root is always the next one,
+     *so the callbacks can create, delete or change any timer.
+     *A timer runs at most once per call, e.g. with 0 period it runs again in the next call.*/
+    state_p->run_id++;
+    while(state_p->heap_cnt > 0) {
+        lv_timer_t * timer_active = state_p->heap[0];
+        if(timer_active->handler_run_id == state_p->run_id) break;
+        if(lv_timer_time_remaining(timer_active) != 0) break;
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+        lv_timer_exec(timer_active);
+    }
 
     uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
-    }
+    if(state_p->heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -167,6 +152,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Make room in the heap first so that every timer can be scheduled*/
+    if(!heap_reserve(state.timer_cnt + 1)) return NULL;
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +166,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->handler_run_id = state.run_id - 1;
+    new_timer->heap_index = HEAP_NONE;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,7 +185,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    heap_remove(timer);
     lv_ll_remove(timer_ll_p, timer);
+    state.timer_cnt--;
     state.timer_deleted = true;
 
     lv_free(timer);
@@ -204,12 +197,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -217,12 +212,14 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -247,6 +244,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +259,11 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_cnt = 0;
+    state.heap_size = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -305,36 +308,36 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
- * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
+ * Execute a ready timer
+ * @param timer pointer to lv_timer, the root of the heap
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
+    state.timer_deleted = false;
 
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+    /* Decrement the repeat count before executing the timer_cb.
+     * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
+     * but at least the repeat count is zero and the timer can be deleted in the next round*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->handler_run_id = state.run_id;
 
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    /*Move it to its next deadline before the callback which might delete or change it*/
+    heap_sift_down(timer->heap_index);
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    if(!state.timer_deleted) {
+        LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
     }
+    else {
+        LV_TRACE_TIMER("timer callback finished");
+    }
+
+    LV_ASSERT_MEM_INTEGRITY();
 
     if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
@@ -348,8 +351,6 @@ static bool lv_timer_exec(lv_timer_t * timer)
             }
         }
     }
-
-    return exec;
 }
 
 /**
@@ -383,3 +384,118 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Tell if a timer's deadline is before an other's.
+ * The tick wraps around so the deadlines are compared by their difference.
+ * With equal deadlines the timers which haven't run in the current `lv_timer_handler()` call come first,
+ * so e.g. a timer with 0 period can't hide the others.
+ * @param a     pointer to a timer
+ * @param b     pointer to an other timer
+ * @return      true: `a` has to run before `b`
+ */
+static inline bool heap_less(const lv_timer_t * a, const lv_timer_t * b)
+{
+    /*Very long periods are limited to keep all the deadlines in half of the tick's range*/
+    uint32_t deadline_a = a->last_run + LV_MIN(a->period, INT32_MAX);
+    uint32_t deadline_b = b->last_run + LV_MIN(b->period, INT32_MAX);
+    if(deadline_a != deadline_b) return (int32_t)(deadline_a - deadline_b) < 0;
+
+    /*A new `run_id` clears this for all the timers at once which keeps the heap valid*/
+    return a->handler_run_id != state.run_id && b->handler_run_id == state.run_id;
+}
+
+static inline void heap_set(uint32_t i, lv_timer_t * timer)
+{
+    state.heap[i] = timer;
+    timer->heap_index = i;
+}
+
+/**
+ * Make sure the heap can store some timers
+ * @param cnt   number of timers to store
+ * @return      true: success; false: out of memory
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= state.heap_size) return true;
+
+    uint32_t new_size = LV_MAX(state.heap_size * 2, HEAP_MIN_SIZE);
+    lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    state.heap = new_heap;
+    state.heap_size = new_size;
+    return true;
+}
+
+/**
+ * Schedule a timer. Does nothing if it's already in the heap.
+ * @param timer     pointer to a timer
+ */
+static void heap_insert(lv_timer_t * timer)
+{
+    if(timer->heap_index != HEAP_NONE) return;
+
+    heap_set(state.heap_cnt, timer);
+    state.heap_cnt++;
+    heap_sift_up(timer->heap_index);
+}
+
+/**
+ * Unschedule a timer. Does nothing if it's not in the heap.
+ * @param timer     pointer to a timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    if(i == HEAP_NONE) return;
+
+    timer->heap_index = HEAP_NONE;
+    state.heap_cnt--;
+    if(i == state.heap_cnt) return;
+
+    /*Move the last timer to the hole and restore the order*/
+    heap_set(i, state.heap[state.heap_cnt]);
+    heap_sift_up(i);
+    heap_sift_down(state.heap[i]->heap_index);
+}
+
+/**
+ * Restore the order after the deadline of a timer has changed
+ * @param timer     pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    if(timer->heap_index == HEAP_NONE) return;
+
+    heap_sift_up(timer->heap_index);
+    heap_sift_down(timer->heap_index);
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t * timer = state.heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_less(timer, state.heap[parent])) break;
+        heap_set(i, state.heap[parent]);
+        i = parent;
+    }
+    heap_set(i, timer);
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t * timer = state.heap[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= state.heap_cnt) break;
+        if(child + 1 < state.heap_cnt && heap_less(state.heap[child + 1], state.heap[child])) child++;
+        if(!heap_less(state.heap[child], timer)) break;
+        heap_set(i, state.heap[child]);
+        i = child;
+    }
+    heap_set(i, timer);
+}
@@ -33,6 +33,8 @@ struct lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t heap_index;       /**< Position in the deadline heap, `UINT32_MAX` if paused*/
+    uint32_t handler_run_id;   /**< `run_id` of the last `lv_timer_handler()` call which ran the timer*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
 };
@@ -40,10 +42,17 @@ struct lv_timer_t {
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
 
+    /** The timers which are not paused in a binary min-heap ordered by their next deadline.
+     *  Allocated for all the timers so that resuming one never fails.*/
+    lv_timer_t ** heap;
+    uint32_t heap_cnt;
+    uint32_t heap_size;
+    uint32_t timer_cnt;
+    uint32_t run_id;           /**< Incremented on every `lv_timer_handler()` call*/
+
     bool lv_timer_run;
     uint8_t idle_last;
     bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
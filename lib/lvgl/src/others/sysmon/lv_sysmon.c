@@ -15,8 +15,10 @@
 #include "../../core/lv_global.h"
 #include "../../misc/lv_async.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_sprintf.h"
 #include "../../widgets/label/lv_label.h"
 #include "../../display/lv_display_private.h"
+#include "../../draw/sw/lv_draw_sw_gradient.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +31,12 @@
     #define sysmon_mem LV_GLOBAL_DEFAULT()->sysmon_mem
 #endif
 
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+    #define SYSMON_GRAD_CACHE 1
+#else
+    #define SYSMON_GRAD_CACHE 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -263,6 +271,20 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.fps) / info->calculated.run_cnt;
 
+#if SYSMON_GRAD_CACHE
+    /*Hit rate since the last report. Keep the previous one if no gradient was drawn*/
+    lv_draw_sw_gradient_cache_stats_t grad_stats;
+    lv_draw_sw_gradient_cache_get_stats(&grad_stats);
+    if(grad_stats.hits < info->measured.grad_cache_hits || grad_stats.misses < info->measured.grad_cache_misses) {
+        /*The counters were reset*/
+        info->measured.grad_cache_hits = 0;
+        info->measured.grad_cache_misses = 0;
+    }
+    uint32_t grad_hits = grad_stats.hits - info->measured.grad_cache_hits;
+    uint32_t grad_lookups = grad_hits + grad_stats.misses - info->measured.grad_cache_misses;
+    if(grad_lookups) info->calculated.grad_cache_hit_pct = (uint32_t)((uint64_t)grad_hits * 100 / grad_lookups);
+#endif
+
     lv_subject_set_pointer(&disp->perf_sysmon_backend.subject, info);
 
     lv_sysmon_perf_info_t prev_info = *info;
@@ -271,6 +293,11 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.cpu_avg_total = prev_info.calculated.cpu_avg_total;
     info->calculated.fps_avg_total = prev_info.calculated.fps_avg_total;
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
+#if SYSMON_GRAD_CACHE
+    info->calculated.grad_cache_hit_pct = prev_info.calculated.grad_cache_hit_pct;
+    info->measured.grad_cache_hits = grad_stats.hits;
+    info->measured.grad_cache_misses = grad_stats.misses;
+#endif
 
     info->measured.last_report_timestamp = lv_tick_get();
 }
@@ -288,6 +315,9 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
            perf->calculated.cpu);
+#if SYSMON_GRAD_CACHE
+    LV_LOG("sysmon: gradient cache %" LV_PRIu32 "%% hit\n", perf->calculated.grad_cache_hit_pct);
+#endif
 #else
     lv_obj_t * label = lv_observer_get_target(observer);
     lv_label_set_text_fmt(
@@ -298,6 +328,11 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
         perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
         perf->calculated.render_avg_time, perf->calculated.flush_avg_time
     );
+#if SYSMON_GRAD_CACHE
+    char buf[32];
+    lv_snprintf(buf, sizeof(buf), "\ngrad cache %" LV_PRIu32 "%%", perf->calculated.grad_cache_hit_pct);
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, buf);
+#endif
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
 }
 
@@ -48,6 +48,10 @@ struct lv_sysmon_perf_info_t {
         uint32_t flush_not_in_render_elaps_sum;
         uint32_t last_report_timestamp;
         uint32_t render_in_progress : 1;
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+        uint32_t grad_cache_hits;       /**< Gradient cache counters at the last report*/
+        uint32_t grad_cache_misses;
+#endif
     } measured;
 
     struct {
@@ -59,6 +63,9 @@ struct lv_sysmon_perf_info_t {
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE > 0
+        uint32_t grad_cache_hit_pct;    /**< Gradients taken from the gradient cache since the last report [%]*/
+#endif
     } calculated;
 
 };
@@ -37,6 +37,20 @@
     #define ALIGN_MASK       0x3
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
+#define fast_heap state.heaps[LV_MEM_HEAP_FAST]
+
+/*A bulk allocation is placed in the fast heap only if 1/FAST_RESERVE_DIV of it stays free for the small blocks*/
+#define FAST_RESERVE_DIV 4
+
+#if LV_MEM_THREAD_CACHE
+    /*Blocks of the last class are cached up to this size, bigger ones are freed*/
+    #define CACHE_MAX_BLOCK_SIZE 384
+    /*Blocks kept per class: the same number of bytes for each class*/
+    #define CLASS_CAP(size) LV_CLAMP(2, LV_MEM_THREAD_CACHE_SIZE / LV_MEM_THREAD_CACHE_CLASS_CNT / (size), \
+                                     LV_MEM_THREAD_CACHE_MAG_SIZE)
+    /*Read by every allocation without locking, it only selects the path of the next blocks*/
+    #define CACHE_DISABLED()        __atomic_load_n(&state.cache_disabled, __ATOMIC_RELAXED)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -46,10 +60,34 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static void * heap_malloc(size_t size, lv_mem_heap_t heap);
+static bool can_fall_back(lv_mem_heap_t heap, size_t size);
+static void heap_account_alloc(lv_mem_heap_state_t * h, void * p);
+static void heap_account_free(lv_mem_heap_state_t * h, size_t size);
+static lv_mem_heap_t heap_of(const void * p);
+static size_t pool_size(lv_pool_t pool);
+static void pool_size_walker(void * ptr, size_t size, int used, void * user);
+#if LV_MEM_THREAD_CACHE
+    static void pool_end_walker(void * ptr, size_t size, int used, void * user);
+    static lv_mem_thread_cache_t * get_thread_cache(void);
+    static void * cache_malloc(size_t size);
+    static bool cache_free(void * p);
+    static void cache_refill(lv_mem_thread_cache_t * cache, uint32_t c);
+    static void cache_return(lv_mem_thread_cache_t * cache, uint32_t c, uint32_t cnt);
+    static void cache_return_pool(lv_pool_t pool);
+    static void cache_destroy(void * cache);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_MEM_THREAD_CACHE
+static const uint32_t class_sizes[LV_MEM_THREAD_CACHE_CLASS_CNT] = {16, 32, 48, 64, 96, 128, 192, 256};
+static const uint8_t class_caps[LV_MEM_THREAD_CACHE_CLASS_CNT] = {
+    CLASS_CAP(16), CLASS_CAP(32), CLASS_CAP(48), CLASS_CAP(64),
+    CLASS_CAP(96), CLASS_CAP(128), CLASS_CAP(192), CLASS_CAP(256)
+};
+#endif
 
 /**********************
  *      MACROS
@@ -74,24 +112,50 @@ void lv_mem_init(void)
     lv_mutex_init(&state.mutex);
 #endif
 
+    /*Set up before the first allocation, i.e. recording the first pool*/
+#if LV_MEM_THREAD_CACHE
+    /*The cache of a thread is given back to the heap when it exits*/
+    state.caches = NULL;
+    state.cache_disabled = false;
+    lv_memzero(state.retired, sizeof(state.retired));
+    pthread_key_create(&state.cache_key, cache_destroy);
+#endif
+
+#if LV_MEM_TRACK
+    lv_mem_track_init();
+#endif
+
+    lv_memzero(state.heaps, sizeof(state.heaps));
+#if LV_MEM_BULK
+    state.bulk_range_cnt = 0;
+#endif
+
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
+    fast_heap.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
 #else
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
-    state.tlsf = lv_tlsf_create_with_pool((void *)work_mem_int, LV_MEM_SIZE);
+    fast_heap.tlsf = lv_tlsf_create_with_pool((void *)work_mem_int, LV_MEM_SIZE);
 #endif
 #else
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
+    fast_heap.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
 
-    lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        lv_ll_init(&state.heaps[heap].pool_ll, sizeof(lv_pool_t));
+    }
 
     /*Record the first pool*/
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
+    lv_pool_t * pool_p = lv_ll_ins_tail(&fast_heap.pool_ll);
     LV_ASSERT_MALLOC(pool_p);
-    *pool_p = lv_tlsf_get_pool(state.tlsf);
+    *pool_p = lv_tlsf_get_pool(fast_heap.tlsf);
+    fast_heap.total_size = pool_size(*pool_p);
+
+#if LV_MEM_BULK && LV_MEM_BULK_ADR != 0
+    lv_mem_add_heap_pool(LV_MEM_HEAP_BULK, (void *)LV_MEM_BULK_ADR, LV_MEM_BULK_SIZE);
+#endif
 
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
@@ -100,8 +164,28 @@ void lv_mem_init(void)
 
 void lv_mem_deinit(void)
 {
-    lv_ll_clear(&state.pool_ll);
-    lv_tlsf_destroy(state.tlsf);
+#if LV_MEM_TRACK
+    lv_mem_track_deinit();
+#endif
+
+#if LV_MEM_THREAD_CACHE
+    /*The cached blocks are dropped with the pools. No destructor will run after deleting the key.*/
+    state.cache_disabled = true;
+    pthread_key_delete(state.cache_key);
+    state.caches = NULL;
+#endif
+
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        lv_ll_clear(&state.heaps[heap].pool_ll);
+    }
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        if(state.heaps[heap].tlsf) lv_tlsf_destroy(state.heaps[heap].tlsf);
+        state.heaps[heap].tlsf = NULL;
+    }
+#if LV_MEM_BULK
+    state.bulk_range_cnt = 0;
+#endif
 #if LV_USE_OS
     lv_mutex_delete(&state.mutex);
 #endif
@@ -109,13 +193,61 @@ void lv_mem_deinit(void)
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 {
-    lv_mem_pool_t new_pool = lv_tlsf_add_pool(state.tlsf, mem, bytes);
+    return lv_mem_add_heap_pool(LV_MEM_HEAP_FAST, mem, bytes);
+}
+
+lv_mem_pool_t lv_mem_add_heap_pool(lv_mem_heap_t heap, void * mem, size_t bytes)
+{
+#if LV_MEM_BULK
+    if(heap == LV_MEM_HEAP_BULK && state.bulk_range_cnt == LV_MEM_BULK_POOL_MAX) {
+        LV_LOG_WARN("the bulk heap has already %d pools", LV_MEM_BULK_POOL_MAX);
+        return NULL;
+    }
+#else
+    if(heap != LV_MEM_HEAP_FAST) {
+        LV_LOG_WARN("the bulk heap needs LV_MEM_BULK_SIZE > 0");
+        return NULL;
+    }
+#endif
+
+    lv_mem_heap_state_t * h = &state.heaps[heap];
+    lv_mem_pool_t new_pool = NULL;
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    if(h->tlsf) {
+        new_pool = lv_tlsf_add_pool(h->tlsf, mem, bytes);
+    }
+    else if(bytes > lv_tlsf_size()) {
+        /*The first pool of the heap also holds its control structure*/
+        lv_tlsf_t tlsf = lv_tlsf_create(mem);
+        if(tlsf) new_pool = lv_tlsf_add_pool(tlsf, (uint8_t *)mem + lv_tlsf_size(), bytes - lv_tlsf_size());
+        if(new_pool) h->tlsf = tlsf;
+    }
+
+    if(new_pool) {
+        h->total_size += pool_size(new_pool);
+#if LV_MEM_BULK
+        if(heap == LV_MEM_HEAP_BULK) {
+            lv_mem_bulk_range_t * range = &state.bulk_ranges[state.bulk_range_cnt];
+            range->start = mem;
+            range->end = (uint8_t *)mem + bytes;
+            range->pool = new_pool;
+            state.bulk_range_cnt++;
+        }
+#endif
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
     if(!new_pool) {
         LV_LOG_WARN("failed to add memory pool, address: %p, size: %zu", mem, bytes);
         return NULL;
     }
 
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
+    lv_pool_t * pool_p = lv_ll_ins_tail(&h->pool_ll);
     LV_ASSERT_MALLOC(pool_p);
     *pool_p = new_pool;
 
@@ -124,12 +256,39 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(*pool_p == pool) {
-            lv_ll_remove(&state.pool_ll, pool_p);
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        lv_mem_heap_state_t * h = &state.heaps[heap];
+        lv_pool_t * pool_p;
+        LV_LL_READ(&h->pool_ll, pool_p) {
+            if(*pool_p != pool) continue;
+
+#if LV_MEM_THREAD_CACHE
+            /*The blocks cached by the threads can still keep the pool in use*/
+            cache_return_pool(pool);
+#endif
+
+            lv_ll_remove(&h->pool_ll, pool_p);
             lv_free(pool_p);
-            lv_tlsf_remove_pool(state.tlsf, pool);
+
+#if LV_USE_OS
+            lv_mutex_lock(&state.mutex);
+#endif
+            h->total_size -= pool_size(pool);
+            lv_tlsf_remove_pool(h->tlsf, pool);
+#if LV_MEM_BULK
+            /*The blocks of the other ranges can be freed meanwhile, so remove the pools when nothing else runs*/
+            uint32_t i;
+            for(i = 0; i < state.bulk_range_cnt; i++) {
+                if(state.bulk_ranges[i].pool != pool) continue;
+                state.bulk_range_cnt--;
+                state.bulk_ranges[i] = state.bulk_ranges[state.bulk_range_cnt];
+                break;
+            }
+#endif
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
             return;
         }
     }
@@ -138,20 +297,27 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void * lv_malloc_core(size_t size)
 {
-#if LV_USE_OS
-    lv_mutex_lock(&state.mutex);
+#if LV_MEM_THREAD_CACHE
+    if(size <= class_sizes[LV_MEM_THREAD_CACHE_CLASS_CNT - 1] && !CACHE_DISABLED()) {
+        void * p = cache_malloc(size);
+        if(p) {
+#if LV_MEM_TRACK
+            lv_mutex_lock(&state.mutex);
+            lv_mem_track_alloc(p, size);
+            lv_mutex_unlock(&state.mutex);
 #endif
-    void * p = lv_tlsf_malloc(state.tlsf, size);
-
-    if(p) {
-        state.cur_used += lv_tlsf_block_size(p);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
+            return p;
+        }
     }
-
-#if LV_USE_OS
-    lv_mutex_unlock(&state.mutex);
 #endif
-    return p;
+
+    return heap_malloc(size, LV_MEM_HEAP_FAST);
+}
+
+void * lv_malloc_heap_core(size_t size, lv_mem_heap_t heap)
+{
+    if(heap == LV_MEM_HEAP_FAST) return lv_malloc_core(size);
+    return heap_malloc(size, heap);
 }
 
 void * lv_realloc_core(void * p, size_t new_size)
@@ -160,14 +326,36 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
+    lv_mem_heap_t heap = heap_of(p);
+    lv_mem_heap_state_t * h = &state.heaps[heap];
     size_t old_size = lv_tlsf_block_size(p);
-    void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
+    void * p_new = lv_tlsf_realloc(h->tlsf, p, new_size);
 
     if(p_new) {
-        state.cur_used -= old_size;
-        state.cur_used += lv_tlsf_block_size(p_new);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
+        heap_account_free(h, old_size);
+        heap_account_alloc(h, p_new);
     }
+    else {
+        /*Move the block to the other heap if it's allowed*/
+        lv_mem_heap_t other = heap == LV_MEM_HEAP_FAST ? LV_MEM_HEAP_BULK : LV_MEM_HEAP_FAST;
+        if(can_fall_back(other, new_size)) p_new = lv_tlsf_malloc(state.heaps[other].tlsf, new_size);
+
+        if(p_new) {
+            lv_memcpy(p_new, p, LV_MIN(old_size, new_size));
+            lv_tlsf_free(h->tlsf, p);
+            heap_account_free(h, old_size);
+            heap_account_alloc(&state.heaps[other], p_new);
+            h->fallback_cnt++;
+        }
+        else {
+            h->fail_cnt++;
+        }
+    }
+
+#if LV_MEM_TRACK
+    if(p_new) lv_mem_track_realloc(p, p_new, new_size);
+    else lv_mem_track_fail(new_size);
+#endif
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
@@ -177,17 +365,33 @@ void * lv_realloc_core(void * p, size_t new_size)
 
 void lv_free_core(void * p)
 {
+#if LV_MEM_THREAD_CACHE && LV_MEM_TRACK
+    /*Forget the block before an other thread can get it from the heap*/
+    if(!CACHE_DISABLED()) {
+        lv_mutex_lock(&state.mutex);
+        lv_mem_track_free(p);
+        lv_mutex_unlock(&state.mutex);
+        if(cache_free(p)) return;
+    }
+#elif LV_MEM_THREAD_CACHE
+    if(!CACHE_DISABLED() && cache_free(p)) return;
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
 
+#if LV_MEM_TRACK
+    lv_mem_track_free(p);
+#endif
+
 #if LV_MEM_ADD_JUNK
-    lv_memset(p, 0xbb, lv_tlsf_block_size(data));
+    lv_memset(p, 0xbb, lv_tlsf_block_size(p));
 #endif
+    lv_mem_heap_state_t * h = &state.heaps[heap_of(p)];
     size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
+    lv_tlsf_free(h->tlsf, p);
+    heap_account_free(h, size);
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -201,7 +405,7 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
     LV_TRACE_MEM("begin");
 
     lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
+    LV_LL_READ(&fast_heap.pool_ll, pool_p) {
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
     }
 
@@ -214,7 +418,34 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 
-    mon_p->max_used = state.max_used;
+    mon_p->max_used = fast_heap.max_used;
+
+#if LV_MEM_THREAD_CACHE
+    uint32_t c;
+    for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+        lv_mem_class_monitor_t * class_mon = &mon_p->classes[c];
+        class_mon->size = class_sizes[c];
+        class_mon->hits = state.retired[c].hits;
+        class_mon->refills = state.retired[c].refills;
+        class_mon->flushes = state.retired[c].flushes;
+    }
+
+    /*The counters of the other threads are read while they might change, it's fine for statistics*/
+    lv_mutex_lock(&state.mutex);
+    lv_mem_thread_cache_t * cache;
+    for(cache = state.caches; cache; cache = cache->next) {
+        mon_p->thread_cnt++;
+        for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+            lv_mem_class_monitor_t * class_mon = &mon_p->classes[c];
+            class_mon->cached_cnt += cache->cnt[c];
+            class_mon->hits += cache->stats[c].hits;
+            class_mon->refills += cache->stats[c].refills;
+            class_mon->flushes += cache->stats[c].flushes;
+            mon_p->cached_size += (size_t)cache->cnt[c] * class_sizes[c];
+        }
+    }
+    lv_mutex_unlock(&state.mutex);
+#endif
 
     LV_TRACE_MEM("finished");
 }
@@ -224,23 +455,29 @@ lv_result_t lv_mem_test_core(void)
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
-    if(lv_tlsf_check(state.tlsf)) {
-        LV_LOG_WARN("failed");
-#if LV_USE_OS
-        lv_mutex_unlock(&state.mutex);
-#endif
-        return LV_RESULT_INVALID;
-    }
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        lv_mem_heap_state_t * h = &state.heaps[heap];
+        if(h->tlsf == NULL) continue;
 
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(lv_tlsf_check_pool(*pool_p)) {
-            LV_LOG_WARN("pool failed");
+        if(lv_tlsf_check(h->tlsf)) {
+            LV_LOG_WARN("%s heap failed", lv_mem_heap_get_name((lv_mem_heap_t)heap));
 #if LV_USE_OS
             lv_mutex_unlock(&state.mutex);
 #endif
             return LV_RESULT_INVALID;
         }
+
+        lv_pool_t * pool_p;
+        LV_LL_READ(&h->pool_ll, pool_p) {
+            if(lv_tlsf_check_pool(*pool_p)) {
+                LV_LOG_WARN("%s heap pool failed", lv_mem_heap_get_name((lv_mem_heap_t)heap));
+#if LV_USE_OS
+                lv_mutex_unlock(&state.mutex);
+#endif
+                return LV_RESULT_INVALID;
+            }
+        }
     }
 
     LV_TRACE_MEM("passed");
@@ -250,6 +487,76 @@ lv_result_t lv_mem_test_core(void)
     return LV_RESULT_OK;
 }
 
+lv_mem_heap_t lv_mem_get_heap(const void * p)
+{
+    return heap_of(p);
+}
+
+void lv_mem_heap_monitor(lv_mem_heap_t heap, lv_mem_heap_monitor_t * mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_heap_monitor_t));
+
+    lv_mem_monitor_t walk;
+    lv_memzero(&walk, sizeof(walk));
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_mem_heap_state_t * h = &state.heaps[heap];
+    lv_pool_t * pool_p;
+    LV_LL_READ(&h->pool_ll, pool_p) {
+        lv_tlsf_walk_pool(*pool_p, lv_mem_walker, &walk);
+    }
+
+    mon_p->total_size = walk.total_size;
+    mon_p->free_size = walk.free_size;
+    mon_p->free_biggest_size = walk.free_biggest_size;
+    mon_p->cur_used = h->cur_used;
+    mon_p->max_used = h->max_used;
+    mon_p->fallback_cnt = h->fallback_cnt;
+    mon_p->fail_cnt = h->fail_cnt;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_heap_reset_stats(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        lv_mem_heap_state_t * h = &state.heaps[heap];
+        h->max_used = h->cur_used;
+        h->fallback_cnt = 0;
+        h->fail_cnt = 0;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+#if LV_MEM_THREAD_CACHE
+
+void lv_mem_enable_thread_cache(bool en)
+{
+    __atomic_store_n(&state.cache_disabled, !en, __ATOMIC_RELAXED);
+}
+
+void lv_mem_flush_thread_cache(void)
+{
+    lv_mem_thread_cache_t * cache = pthread_getspecific(state.cache_key);
+    if(cache == NULL) return;
+
+    uint32_t c;
+    for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+        if(cache->cnt[c]) cache_return(cache, c, cache->cnt[c]);
+    }
+}
+
+#endif /*LV_MEM_THREAD_CACHE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -270,4 +577,315 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+/**
+ * Allocate a block in a heap or in the other one if it's full and the fallback is allowed
+ * @param size      requested size
+ * @param heap      the heap to use first
+ * @return          the block or NULL
+ */
+static void * heap_malloc(size_t size, lv_mem_heap_t heap)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_mem_heap_state_t * h = &state.heaps[heap];
+    void * p = h->tlsf ? lv_tlsf_malloc(h->tlsf, size) : NULL;
+
+    if(p) {
+        heap_account_alloc(h, p);
+    }
+    else {
+        lv_mem_heap_t other = heap == LV_MEM_HEAP_FAST ? LV_MEM_HEAP_BULK : LV_MEM_HEAP_FAST;
+        if(can_fall_back(other, size)) p = lv_tlsf_malloc(state.heaps[other].tlsf, size);
+
+        if(p) {
+            heap_account_alloc(&state.heaps[other], p);
+            /*Without bulk pool the bulk allocations simply use the fast heap*/
+            if(h->tlsf) h->fallback_cnt++;
+        }
+        else {
+            h->fail_cnt++;
+        }
+    }
+
+#if LV_MEM_TRACK
+    if(p) lv_mem_track_alloc(p, size);
+    else lv_mem_track_fail(size);
+#endif
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+    return p;
+}
+
+/**
+ * Check if an allocation for the other heap can be placed in a heap. Called with the heap locked.
+ * @param heap      the heap to use instead
+ * @param size      requested size
+ * @return          true: the allocation can be placed in `heap`
+ */
+static bool can_fall_back(lv_mem_heap_t heap, size_t size)
+{
+    lv_mem_heap_state_t * h = &state.heaps[heap];
+    if(h->tlsf == NULL) return false;
+    if(heap == LV_MEM_HEAP_BULK) return true;
+
+    /*Without bulk heap the fast heap is the only one, else a part of it is kept for the small blocks*/
+    if(state.heaps[LV_MEM_HEAP_BULK].tlsf == NULL) return true;
+    return h->cur_used + size <= h->total_size - h->total_size / FAST_RESERVE_DIV;
+}
+
+static void heap_account_alloc(lv_mem_heap_state_t * h, void * p)
+{
+    h->cur_used += lv_tlsf_block_size(p);
+    h->max_used = LV_MAX(h->cur_used, h->max_used);
+}
+
+static void heap_account_free(lv_mem_heap_state_t * h, size_t size)
+{
+    if(h->cur_used > size) h->cur_used -= size;
+    else h->cur_used = 0;
+}
+
+/**
+ * Find the heap of a block from the addresses of the bulk pools, without locking
+ * @param p     an allocated block
+ * @return      its heap
+ */
+static lv_mem_heap_t heap_of(const void * p)
+{
+#if LV_MEM_BULK
+    uint32_t i;
+    for(i = 0; i < state.bulk_range_cnt; i++) {
+        const lv_mem_bulk_range_t * range = &state.bulk_ranges[i];
+        if((const uint8_t *)p >= range->start && (const uint8_t *)p < range->end) return LV_MEM_HEAP_BULK;
+    }
+#else
+    LV_UNUSED(p);
+#endif
+    return LV_MEM_HEAP_FAST;
+}
+
+static size_t pool_size(lv_pool_t pool)
+{
+    size_t size = 0;
+    lv_tlsf_walk_pool(pool, pool_size_walker, &size);
+    return size;
+}
+
+static void pool_size_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(ptr);
+    LV_UNUSED(used);
+
+    size_t * total = user;
+    *total += size;
+}
+
+#if LV_MEM_THREAD_CACHE
+
+/**
+ * Get the cache of the calling thread and create it on its first allocation
+ * @return      the cache or NULL if there is no memory for it
+ */
+static lv_mem_thread_cache_t * get_thread_cache(void)
+{
+    lv_mem_thread_cache_t * cache = pthread_getspecific(state.cache_key);
+    if(cache) return cache;
+
+    lv_mutex_lock(&state.mutex);
+    cache = lv_tlsf_malloc(fast_heap.tlsf, sizeof(lv_mem_thread_cache_t));
+    if(cache) {
+        lv_memzero(cache, sizeof(lv_mem_thread_cache_t));
+        cache->next = state.caches;
+        state.caches = cache;
+        heap_account_alloc(&fast_heap, cache);
+    }
+    lv_mutex_unlock(&state.mutex);
+
+    if(cache) pthread_setspecific(state.cache_key, cache);
+    return cache;
+}
+
+/**
+ * Allocate a block of the smallest class which fits from the thread's cache
+ * @param size      requested size, at most the size of the last class
+ * @return          the block or NULL if the heap has no block of the class (try with the exact size)
+ */
+static void * cache_malloc(size_t size)
+{
+    lv_mem_thread_cache_t * cache = get_thread_cache();
+    if(cache == NULL) return NULL;
+
+    uint32_t c = 0;
+    while(class_sizes[c] < size) c++;
+
+    if(cache->cnt[c] == 0) {
+        cache_refill(cache, c);
+        if(cache->cnt[c] == 0) return NULL;
+    }
+    else {
+        cache->stats[c].hits++;
+    }
+
+    cache->cnt[c]--;
+    return cache->blocks[c][cache->cnt[c]];
+}
+
+/**
+ * Keep a freed block in the thread's cache if it fits a class
+ * @param p     the block to free
+ * @return      false if the block needs to be freed in the heap
+ */
+static bool cache_free(void * p)
+{
+    /*Only the blocks of the fast heap are cached*/
+    if(heap_of(p) != LV_MEM_HEAP_FAST) return false;
+
+    /*The size of an allocated block doesn't change so it can be read without locking*/
+    size_t size = lv_tlsf_block_size(p);
+    if(size < class_sizes[0] || size >= CACHE_MAX_BLOCK_SIZE) return false;
+
+    lv_mem_thread_cache_t * cache = get_thread_cache();
+    if(cache == NULL) return false;
+
+    /*The largest class which fits in the block*/
+    uint32_t c = LV_MEM_THREAD_CACHE_CLASS_CNT - 1;
+    while(class_sizes[c] > size) c--;
+
+    /*Give back the oldest half if full*/
+    if(cache->cnt[c] == class_caps[c]) cache_return(cache, c, class_caps[c] / 2);
+
+    cache->blocks[c][cache->cnt[c]] = p;
+    cache->cnt[c]++;
+    return true;
+}
+
+/**
+ * Take half of the capacity of a class from the heap with one lock
+ * @param cache     the cache of the calling thread
+ * @param c         index of the class
+ */
+static void cache_refill(lv_mem_thread_cache_t * cache, uint32_t c)
+{
+    uint32_t cnt = class_caps[c] / 2;
+
+    lv_mutex_lock(&state.mutex);
+    while(cache->cnt[c] < cnt) {
+        void * p = lv_tlsf_malloc(fast_heap.tlsf, class_sizes[c]);
+        if(p == NULL) break;
+        heap_account_alloc(&fast_heap, p);
+        cache->blocks[c][cache->cnt[c]] = p;
+        cache->cnt[c]++;
+    }
+    lv_mutex_unlock(&state.mutex);
+
+    cache->stats[c].refills++;
+}
+
+/**
+ * Free the oldest blocks of a class in the heap with one lock
+ * @param cache     the cache of a thread
+ * @param c         index of the class
+ * @param cnt       number of blocks to free
+ */
+static void cache_return(lv_mem_thread_cache_t * cache, uint32_t c, uint32_t cnt)
+{
+    void ** blocks = cache->blocks[c];
+    uint32_t i;
+
+    lv_mutex_lock(&state.mutex);
+    for(i = 0; i < cnt; i++) {
+        size_t size = lv_tlsf_block_size(blocks[i]);
+        lv_tlsf_free(fast_heap.tlsf, blocks[i]);
+        heap_account_free(&fast_heap, size);
+    }
+    lv_mutex_unlock(&state.mutex);
+
+    cache->cnt[c] -= cnt;
+    lv_memmove(blocks, &blocks[cnt], cache->cnt[c] * sizeof(void *));
+    cache->stats[c].flushes++;
+}
+
+/**
+ * Free the blocks of a pool from the caches of all the threads, e.g. before removing the pool.
+ * The other threads must not allocate or free meanwhile, as they use their cache without locking.
+ * @param pool      the pool whose blocks should leave the caches
+ */
+static void cache_return_pool(lv_pool_t pool)
+{
+    lv_mutex_lock(&state.mutex);
+
+    uint8_t * start = (uint8_t *)pool;
+    uint8_t * end = start;
+    lv_tlsf_walk_pool(pool, pool_end_walker, &end);
+
+    lv_mem_thread_cache_t * cache;
+    for(cache = state.caches; cache; cache = cache->next) {
+        uint32_t c;
+        for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+            void ** blocks = cache->blocks[c];
+            uint32_t kept = 0;
+            uint32_t i;
+            for(i = 0; i < cache->cnt[c]; i++) {
+                uint8_t * p = blocks[i];
+                if(p >= start && p < end) {
+                    size_t size = lv_tlsf_block_size(p);
+                    lv_tlsf_free(fast_heap.tlsf, p);
+                    heap_account_free(&fast_heap, size);
+                }
+                else {
+                    blocks[kept] = p;
+                    kept++;
+                }
+            }
+            cache->cnt[c] = kept;
+        }
+    }
+
+    lv_mutex_unlock(&state.mutex);
+}
+
+static void pool_end_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(used);
+
+    uint8_t ** end = user;
+    uint8_t * block_end = (uint8_t *)ptr + size;
+    if(block_end > *end) *end = block_end;
+}
+
+/**
+ * Called by pthread when a thread having a cache exits
+ * @param cache     the cache of the thread
+ */
+static void cache_destroy(void * cache)
+{
+    lv_mem_thread_cache_t * thread_cache = cache;
+    uint32_t c;
+    for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+        if(thread_cache->cnt[c]) cache_return(thread_cache, c, thread_cache->cnt[c]);
+    }
+
+    lv_mutex_lock(&state.mutex);
+    lv_mem_thread_cache_t ** p = &state.caches;
+    while(*p != thread_cache) p = &(*p)->next;
+    *p = thread_cache->next;
+
+    for(c = 0; c < LV_MEM_THREAD_CACHE_CLASS_CNT; c++) {
+        state.retired[c].hits += thread_cache->stats[c].hits;
+        state.retired[c].refills += thread_cache->stats[c].refills;
+        state.retired[c].flushes += thread_cache->stats[c].flushes;
+    }
+
+    size_t size = lv_tlsf_block_size(thread_cache);
+    lv_tlsf_free(fast_heap.tlsf, thread_cache);
+    heap_account_free(&fast_heap, size);
+    lv_mutex_unlock(&state.mutex);
+}
+
+#endif /*LV_MEM_THREAD_CACHE*/
+
 #endif /*LV_STDLIB_BUILTIN*/
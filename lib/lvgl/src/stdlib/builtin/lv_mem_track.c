@@ -0,0 +1,564 @@
+/**
+ * @file lv_mem_track.c
+ * Record the blocks of the builtin heap with their tag to find which subsystem fragments it.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_mem.h"
+#if LV_MEM_TRACK
+
+#include "lv_tlsf.h"
+#include "../lv_string.h"
+#include "../../misc/lv_log.h"
+#include "../../misc/lv_ll.h"
+#include "../../misc/lv_math.h"
+#include "../../tick/lv_tick.h"
+#include "../../osal/lv_os.h"
+#include "../../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define state LV_GLOBAL_DEFAULT()->tlsf_state
+#define track LV_GLOBAL_DEFAULT()->tlsf_state.track
+
+/*Blocks are not recorded above this load to keep the probe sequences short*/
+#define TRACK_BLOCK_MAX_CNT (LV_MEM_TRACK_BLOCK_CNT - LV_MEM_TRACK_BLOCK_CNT / 8)
+
+#define TAG_BITS    4
+#define TAG_MASK    ((1U << TAG_BITS) - 1)
+
+/*Characters of the heap map*/
+#define MAP_LINE_LEN        64
+#define MAP_MAX_LINE_CNT    16
+#define MAP_SYM_FREE        LV_MEM_TAG_LAST
+#define MAP_SYM_UNTRACKED   (LV_MEM_TAG_LAST + 1)
+#define MAP_SYM_CNT         (LV_MEM_TAG_LAST + 2)
+
+/*Size ranges of the free blocks in the dump*/
+#define FREE_RANGE_CNT  6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    size_t total_size;
+    size_t free_size;
+    size_t free_biggest_size;
+    uint32_t used_cnt;
+    uint32_t untracked_cnt;
+    uint32_t free_cnts[FREE_RANGE_CNT];
+} heap_summary_t;
+
+typedef struct {
+    uint8_t * base;             /**< First block of the pool*/
+    size_t cell_size;           /**< Bytes per character*/
+    size_t cell_start;          /**< Offset of the current cell*/
+    size_t end;                 /**< Offset of the end of the last block*/
+    size_t sym_bytes[MAP_SYM_CNT];
+    char line[MAP_LINE_LEN + 1];
+    uint32_t line_len;
+} heap_map_t;
+
+typedef struct {
+    lv_mem_track_trace_cb_t cb;
+    void * user_data;
+} trace_snapshot_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t block_home(const void * p);
+static lv_mem_track_block_t * block_find(const void * p);
+static lv_mem_track_block_t * block_insert(void * p);
+static void block_remove(lv_mem_track_block_t * b);
+static uint32_t get_tag_stack(void);
+static void set_tag_stack(uint32_t tag_stack);
+static uint32_t get_lifetime_index(uint32_t ms);
+static void trace(lv_mem_track_op_t op, uint32_t id, size_t size, uint8_t tag);
+static void dump_locked(void);
+static void summary_walker(void * ptr, size_t size, int used, void * user);
+static void map_walker(void * ptr, size_t size, int used, void * user);
+static void map_add(heap_map_t * map, size_t start, size_t size, uint32_t sym);
+static void map_put_cell(heap_map_t * map);
+static void snapshot_walker(void * ptr, size_t size, int used, void * user);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const char map_syms[MAP_SYM_CNT] = {'x', 'O', 'S', 'T', 'D', 'I', 'F', 'A', '.', '?'};
+static const char * const lifetime_names[LV_MEM_TRACK_LIFETIME_CNT] = {
+    "<16ms", "<64ms", "<256ms", "<1s", "<4s", "<16s", "<66s", "longer"
+};
+static const char * const free_range_names[FREE_RANGE_CNT] = {"<64", "<256", "<1K", "<4K", "<16K", "larger"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_mem_track_init(void)
+{
+    lv_memzero(&track, sizeof(track));
+    track.next_id = 1;
+#if LV_USE_OS == LV_OS_PTHREAD
+    pthread_key_create(&track.tag_key, NULL);
+#endif
+}
+
+void lv_mem_track_deinit(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    pthread_key_delete(track.tag_key);
+#endif
+    track.trace_cb = NULL;
+}
+
+void lv_mem_track_push_tag(lv_mem_tag_t tag)
+{
+    set_tag_stack((get_tag_stack() << TAG_BITS) | tag);
+}
+
+void lv_mem_track_pop_tag(void)
+{
+    set_tag_stack(get_tag_stack() >> TAG_BITS);
+}
+
+void lv_mem_track_alloc(void * p, size_t size)
+{
+    uint8_t tag = get_tag_stack() & TAG_MASK;
+    uint32_t id = track.next_id++;
+    if(track.next_id == 0) track.next_id = 1;
+
+    lv_mem_tag_monitor_t * tag_mon = &track.tags[tag];
+    tag_mon->alloc_cnt++;
+
+    lv_mem_track_block_t * b = block_insert(p);
+    if(b == NULL) {
+        /*It's not known when it's freed, so it's not counted as in use*/
+        track.untracked_cnt++;
+    }
+    else {
+        b->size = size;
+        b->id = id;
+        b->tag = tag;
+        b->tick = lv_tick_get();
+
+        tag_mon->cur_cnt++;
+        tag_mon->cur_size += size;
+        tag_mon->max_size = LV_MAX(tag_mon->max_size, tag_mon->cur_size);
+    }
+
+    trace(LV_MEM_TRACK_OP_ALLOC, id, size, tag);
+}
+
+void lv_mem_track_free(void * p)
+{
+    lv_mem_track_block_t * b = block_find(p);
+    if(b == NULL) return;
+
+    lv_mem_tag_monitor_t * tag_mon = &track.tags[b->tag];
+    tag_mon->cur_cnt--;
+    tag_mon->cur_size -= b->size;
+    tag_mon->lifetimes[get_lifetime_index(lv_tick_elaps(b->tick))]++;
+
+    trace(LV_MEM_TRACK_OP_FREE, b->id, 0, b->tag);
+    block_remove(b);
+}
+
+void lv_mem_track_realloc(void * p, void * p_new, size_t new_size)
+{
+    lv_mem_track_block_t * b = block_find(p);
+    if(b == NULL) {
+        lv_mem_track_alloc(p_new, new_size);
+        return;
+    }
+
+    lv_mem_track_block_t old = *b;
+    block_remove(b);
+
+    lv_mem_tag_monitor_t * tag_mon = &track.tags[old.tag];
+    tag_mon->cur_size = tag_mon->cur_size - old.size + new_size;
+    tag_mon->max_size = LV_MAX(tag_mon->max_size, tag_mon->cur_size);
+
+    b = block_insert(p_new);
+    if(b) {
+        *b = old;
+        b->p = p_new;
+        b->size = new_size;
+    }
+    else {
+        tag_mon->cur_cnt--;
+        tag_mon->cur_size -= new_size;
+        track.untracked_cnt++;
+    }
+
+    trace(LV_MEM_TRACK_OP_REALLOC, old.id, new_size, old.tag);
+}
+
+void lv_mem_track_fail(size_t size)
+{
+    uint8_t tag = get_tag_stack() & TAG_MASK;
+    track.tags[tag].fail_cnt++;
+    trace(LV_MEM_TRACK_OP_ALLOC, 0, size, tag);
+
+    if(!track.dumped) {
+        track.dumped = true;
+        LV_LOG_WARN("couldn't allocate %zu bytes for %s, dumping the heap", size,
+                    lv_mem_tag_get_name((lv_mem_tag_t)tag));
+        dump_locked();
+    }
+}
+
+void lv_mem_track_monitor(lv_mem_track_monitor_t * mon_p)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_memcpy(mon_p->tags, track.tags, sizeof(track.tags));
+    mon_p->untracked_cnt = track.untracked_cnt;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_track_reset(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_LAST; i++) {
+        lv_mem_tag_monitor_t * tag_mon = &track.tags[i];
+        tag_mon->alloc_cnt = 0;
+        tag_mon->fail_cnt = 0;
+        tag_mon->max_size = tag_mon->cur_size;
+        lv_memzero(tag_mon->lifetimes, sizeof(tag_mon->lifetimes));
+    }
+    track.untracked_cnt = 0;
+    track.dumped = false;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_track_dump(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    dump_locked();
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_track_set_trace_cb(lv_mem_track_trace_cb_t cb, void * user_data)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    track.trace_cb = cb;
+    track.trace_user_data = user_data;
+
+    if(cb) {
+        trace_snapshot_t snapshot = {cb, user_data};
+        uint32_t heap;
+        for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+            lv_pool_t * pool_p;
+            LV_LL_READ(&state.heaps[heap].pool_ll, pool_p) {
+                lv_tlsf_walk_pool(*pool_p, snapshot_walker, &snapshot);
+            }
+        }
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t block_home(const void * p)
+{
+    uint32_t h = (uint32_t)((uintptr_t)p >> 3) * 2654435761U;
+    return h % LV_MEM_TRACK_BLOCK_CNT;
+}
+
+static lv_mem_track_block_t * block_find(const void * p)
+{
+    uint32_t i = block_home(p);
+    while(track.blocks[i].p) {
+        if(track.blocks[i].p == p) return &track.blocks[i];
+        i = i + 1 == LV_MEM_TRACK_BLOCK_CNT ? 0 : i + 1;
+    }
+    return NULL;
+}
+
+/**
+ * Get an empty slot for a block
+ * @param p     the block
+ * @return      the slot with only `p` set, or NULL if the table is full
+ */
+static lv_mem_track_block_t * block_insert(void * p)
+{
+    if(track.block_cnt >= TRACK_BLOCK_MAX_CNT) return NULL;
+
+    uint32_t i = block_home(p);
+    while(track.blocks[i].p) {
+        i = i + 1 == LV_MEM_TRACK_BLOCK_CNT ? 0 : i + 1;
+    }
+
+    track.block_cnt++;
+    track.blocks[i].p = p;
+    return &track.blocks[i];
+}
+
+/**
+ * Empty a slot and move back the following blocks of the probe sequence to keep them reachable
+ * @param b     the slot to empty
+ */
+static void block_remove(lv_mem_track_block_t * b)
+{
+    uint32_t hole = b - track.blocks;
+    uint32_t i = hole;
+    while(1) {
+        i = i + 1 == LV_MEM_TRACK_BLOCK_CNT ? 0 : i + 1;
+        if(track.blocks[i].p == NULL) break;
+
+        /*The block can fill the hole if its home is not in (hole, i]*/
+        uint32_t home = block_home(track.blocks[i].p);
+        bool stays = hole < i ? (home > hole && home <= i) : (home > hole || home <= i);
+        if(!stays) {
+            track.blocks[hole] = track.blocks[i];
+            hole = i;
+        }
+    }
+
+    track.blocks[hole].p = NULL;
+    track.block_cnt--;
+}
+
+/**
+ * The tags pushed by the calling thread, 4 bits each, the current one in the lowest bits
+ */
+static uint32_t get_tag_stack(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    return (uint32_t)(uintptr_t)pthread_getspecific(track.tag_key);
+#else
+    return track.tag_stack;
+#endif
+}
+
+static void set_tag_stack(uint32_t tag_stack)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    pthread_setspecific(track.tag_key, (void *)(uintptr_t)tag_stack);
+#else
+    track.tag_stack = tag_stack;
+#endif
+}
+
+static uint32_t get_lifetime_index(uint32_t ms)
+{
+    uint32_t i = 0;
+    uint32_t limit = 16;
+    while(i < LV_MEM_TRACK_LIFETIME_CNT - 1 && ms >= limit) {
+        i++;
+        limit *= 4;
+    }
+    return i;
+}
+
+static void trace(lv_mem_track_op_t op, uint32_t id, size_t size, uint8_t tag)
+{
+    if(track.trace_cb == NULL) return;
+
+    lv_mem_track_event_t e;
+    e.op = op;
+    e.id = id;
+    e.size = (uint32_t)size;
+    e.tag = tag;
+    track.trace_cb(&e, track.trace_user_data);
+}
+
+static void dump_locked(void)
+{
+    heap_summary_t sums[LV_MEM_HEAP_CNT];
+    lv_memzero(sums, sizeof(sums));
+    uint32_t heap;
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        if(state.heaps[heap].tlsf == NULL) continue;
+
+        heap_summary_t * sum = &sums[heap];
+        lv_pool_t * pool_p;
+        LV_LL_READ(&state.heaps[heap].pool_ll, pool_p) {
+            lv_tlsf_walk_pool(*pool_p, summary_walker, sum);
+        }
+
+        uint32_t frag_pct = sum->free_size ? 100 - (uint32_t)((uint64_t)sum->free_biggest_size * 100 / sum->free_size) : 0;
+        LV_LOG_USER("%s heap: %zu bytes, %zu free, biggest free %zu, frag %" LV_PRIu32 " %%, "
+                    "%" LV_PRIu32 " used blocks (%" LV_PRIu32 " untracked)",
+                    lv_mem_heap_get_name((lv_mem_heap_t)heap), sum->total_size, sum->free_size, sum->free_biggest_size,
+                    frag_pct, sum->used_cnt, sum->untracked_cnt);
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_LAST; i++) {
+        const lv_mem_tag_monitor_t * tag_mon = &track.tags[i];
+        if(tag_mon->alloc_cnt == 0 && tag_mon->cur_cnt == 0) continue;
+        LV_LOG_USER("%c %-6s %5" LV_PRIu32 " blocks %7zu bytes (max %7zu), %6" LV_PRIu32 " allocs, %3" LV_PRIu32 " fails",
+                    map_syms[i], lv_mem_tag_get_name((lv_mem_tag_t)i), tag_mon->cur_cnt, tag_mon->cur_size,
+                    tag_mon->max_size, tag_mon->alloc_cnt, tag_mon->fail_cnt);
+
+        char buf[192];
+        uint32_t len = 0;
+        uint32_t l;
+        for(l = 0; l < LV_MEM_TRACK_LIFETIME_CNT; l++) {
+            len += lv_snprintf(buf + len, sizeof(buf) - len, " %s:%" LV_PRIu32, lifetime_names[l], tag_mon->lifetimes[l]);
+        }
+        LV_LOG_USER("    lifetimes%s", buf);
+    }
+
+    for(heap = 0; heap < LV_MEM_HEAP_CNT; heap++) {
+        if(state.heaps[heap].tlsf == NULL) continue;
+
+        const heap_summary_t * sum = &sums[heap];
+        const char * heap_name = lv_mem_heap_get_name((lv_mem_heap_t)heap);
+        char buf[128];
+        uint32_t len = 0;
+        for(i = 0; i < FREE_RANGE_CNT; i++) {
+            len += lv_snprintf(buf + len, sizeof(buf) - len, " %s:%" LV_PRIu32, free_range_names[i], sum->free_cnts[i]);
+        }
+        LV_LOG_USER("%s heap free blocks%s", heap_name, buf);
+
+        /*Use at most MAP_MAX_LINE_CNT lines for all the pools of the heap*/
+        size_t cell_size = (sum->total_size + MAP_LINE_LEN * MAP_MAX_LINE_CNT - 1) / (MAP_LINE_LEN * MAP_MAX_LINE_CNT);
+        cell_size = LV_MAX(LV_ALIGN_UP(cell_size, 8), 8);
+        LV_LOG_USER("%s heap map, %zu bytes per character ('.' free, '?' untracked, 'x' other):", heap_name, cell_size);
+
+        lv_pool_t * pool_p;
+        LV_LL_READ(&state.heaps[heap].pool_ll, pool_p) {
+            heap_map_t map;
+            lv_memzero(&map, sizeof(map));
+            map.cell_size = cell_size;
+            lv_tlsf_walk_pool(*pool_p, map_walker, &map);
+
+            /*Flush the last partial cell and line*/
+            map_put_cell(&map);
+            if(map.line_len) {
+                map.line[map.line_len] = '\0';
+                LV_LOG_USER("%s", map.line);
+            }
+        }
+    }
+}
+
+static void summary_walker(void * ptr, size_t size, int used, void * user)
+{
+    heap_summary_t * sum = user;
+    sum->total_size += size;
+    if(used) {
+        sum->used_cnt++;
+        if(block_find(ptr) == NULL) sum->untracked_cnt++;
+    }
+    else {
+        sum->free_size += size;
+        sum->free_biggest_size = LV_MAX(sum->free_biggest_size, size);
+
+        uint32_t i = 0;
+        size_t limit = 64;
+        while(i < FREE_RANGE_CNT - 1 && size >= limit) {
+            i++;
+            limit *= 4;
+        }
+        sum->free_cnts[i]++;
+    }
+}
+
+static void map_walker(void * ptr, size_t size, int used, void * user)
+{
+    heap_map_t * map = user;
+    if(map->base == NULL) map->base = ptr;
+
+    uint32_t sym = MAP_SYM_FREE;
+    if(used) {
+        lv_mem_track_block_t * b = block_find(ptr);
+        sym = b ? b->tag : MAP_SYM_UNTRACKED;
+    }
+
+    /*The header of the block is counted with it*/
+    size_t end = (size_t)((uint8_t *)ptr - map->base) + size;
+    map_add(map, map->end, end - map->end, sym);
+    map->end = end;
+}
+
+static void map_add(heap_map_t * map, size_t start, size_t size, uint32_t sym)
+{
+    size_t end = start + size;
+    while(start < end) {
+        size_t cell_end = map->cell_start + map->cell_size;
+        if(start >= cell_end) {
+            map_put_cell(map);
+            continue;
+        }
+
+        size_t part_end = LV_MIN(end, cell_end);
+        map->sym_bytes[sym] += part_end - start;
+        start = part_end;
+    }
+}
+
+/**
+ * Add the character of the current cell to the line and start the next cell
+ */
+static void map_put_cell(heap_map_t * map)
+{
+    uint32_t best = MAP_SYM_CNT;
+    size_t best_bytes = 0;
+    uint32_t i;
+    for(i = 0; i < MAP_SYM_CNT; i++) {
+        if(map->sym_bytes[i] > best_bytes) {
+            best_bytes = map->sym_bytes[i];
+            best = i;
+        }
+    }
+    if(best == MAP_SYM_CNT) return;
+
+    map->line[map->line_len++] = map_syms[best];
+    if(map->line_len == MAP_LINE_LEN) {
+        map->line[map->line_len] = '\0';
+        LV_LOG_USER("%s", map->line);
+        map->line_len = 0;
+    }
+
+    lv_memzero(map->sym_bytes, sizeof(map->sym_bytes));
+    map->cell_start += map->cell_size;
+}
+
+static void snapshot_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(size);
+    if(!used) return;
+
+    lv_mem_track_block_t * b = block_find(ptr);
+    if(b == NULL) return;
+
+    trace_snapshot_t * snapshot = user;
+    lv_mem_track_event_t e;
+    e.op = LV_MEM_TRACK_OP_ALLOC;
+    e.id = b->id;
+    e.size = b->size;
+    e.tag = b->tag;
+    snapshot->cb(&e, snapshot->user_data);
+}
+
+#endif /*LV_MEM_TRACK*/
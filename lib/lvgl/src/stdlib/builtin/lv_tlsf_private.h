@@ -17,29 +17,150 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** Most blocks a thread keeps of a size class*/
+#define LV_MEM_THREAD_CACHE_MAG_SIZE 32
+
+/** Most pools of the bulk heap*/
+#define LV_MEM_BULK_POOL_MAX 4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_MEM_THREAD_CACHE
 typedef struct {
-#if LV_USE_OS
-    lv_mutex_t mutex;
+    uint32_t hits;
+    uint32_t refills;
+    uint32_t flushes;
+} lv_mem_class_stats_t;
+
+/**
+ * Free blocks of a thread per size class. Only its thread uses the blocks without locking the heap,
+ * the others only read the statistics.
+ */
+typedef struct lv_mem_thread_cache_t {
+    struct lv_mem_thread_cache_t * next;
+    uint8_t cnt[LV_MEM_THREAD_CACHE_CLASS_CNT];
+    lv_mem_class_stats_t stats[LV_MEM_THREAD_CACHE_CLASS_CNT];
+    void * blocks[LV_MEM_THREAD_CACHE_CLASS_CNT][LV_MEM_THREAD_CACHE_MAG_SIZE];
+} lv_mem_thread_cache_t;
+#endif
+
+#if LV_MEM_TRACK
+typedef struct {
+    void * p;           /**< NULL: empty slot*/
+    uint32_t size;
+    uint32_t id;
+    uint32_t tick;      /**< Time of the allocation*/
+    uint8_t tag;
+} lv_mem_track_block_t;
+
+typedef struct {
+    lv_mem_track_block_t blocks[LV_MEM_TRACK_BLOCK_CNT];   /**< Open addressing hash table of the blocks in use*/
+    uint32_t block_cnt;
+    uint32_t next_id;
+    lv_mem_tag_monitor_t tags[LV_MEM_TAG_LAST];
+    uint32_t untracked_cnt;
+    lv_mem_track_trace_cb_t trace_cb;
+    void * trace_user_data;
+    bool dumped;        /**< The heap was dumped on a failed allocation*/
+#if LV_USE_OS == LV_OS_PTHREAD
+    pthread_key_t tag_key;
+#else
+    uint32_t tag_stack;
 #endif
-    lv_tlsf_t tlsf;
+} lv_mem_track_t;
+#endif
+
+typedef struct {
+    lv_tlsf_t tlsf;         /**< NULL: no pool was added to the heap yet*/
+    lv_ll_t  pool_ll;
+    size_t total_size;      /**< Bytes of the free and used blocks of the pools*/
     size_t cur_used;
     size_t max_used;
-    lv_ll_t  pool_ll;
+    uint32_t fallback_cnt;
+    uint32_t fail_cnt;
+} lv_mem_heap_state_t;
+
+#if LV_MEM_BULK
+/** Memory of a pool of the bulk heap to find the heap of a block without locking*/
+typedef struct {
+    const uint8_t * start;
+    const uint8_t * end;
+    lv_pool_t pool;
+} lv_mem_bulk_range_t;
+#endif
+
+typedef struct {
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+    lv_mem_heap_state_t heaps[LV_MEM_HEAP_CNT];
+#if LV_MEM_BULK
+    lv_mem_bulk_range_t bulk_ranges[LV_MEM_BULK_POOL_MAX];
+    uint32_t bulk_range_cnt;
+#endif
+#if LV_MEM_THREAD_CACHE
+    pthread_key_t cache_key;
+    lv_mem_thread_cache_t * caches;     /**< The caches of all the threads, linked with `next`*/
+    lv_mem_class_stats_t retired[LV_MEM_THREAD_CACHE_CLASS_CNT];   /**< Statistics of the exited threads*/
+    bool cache_disabled;
+#endif
+#if LV_MEM_TRACK
+    lv_mem_track_t track;
+#endif
 } lv_tlsf_state_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_MEM_TRACK
+
+/**
+ * Initialize the allocation tracker. Called by `lv_mem_init`.
+ */
+void lv_mem_track_init(void);
+
+void lv_mem_track_deinit(void);
+
+/*The functions below are called with the heap locked*/
+
+/**
+ * Record a new block with the tag of the calling thread
+ * @param p     the new block
+ * @param size  the requested size
+ */
+void lv_mem_track_alloc(void * p, size_t size);
+
+/**
+ * Forget a block before it's given back to the heap
+ * @param p     the block
+ */
+void lv_mem_track_free(void * p);
+
+/**
+ * Move the record of a reallocated block. Its tag, id and age are kept.
+ * @param p         the old block
+ * @param p_new     the new block
+ * @param new_size  the requested size
+ */
+void lv_mem_track_realloc(void * p, void * p_new, size_t new_size);
+
+/**
+ * Count a failed allocation for the tag of the calling thread and dump the heap the first time
+ * @param size  the requested size
+ */
+void lv_mem_track_fail(size_t size);
+
+#endif
+
 /**********************
  *      MACROS
  **********************/
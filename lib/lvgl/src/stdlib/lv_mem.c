@@ -45,6 +45,13 @@ lv_result_t lv_mem_test_core(void);
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const char * const tag_names[LV_MEM_TAG_LAST] = {
+    "other", "obj", "style", "text", "draw", "image", "font", "anim"
+};
+
+static const char * const heap_names[LV_MEM_HEAP_CNT] = {
+    "fast", "bulk"
+};
 
 /**********************
  *      MACROS
@@ -89,6 +96,31 @@ void * lv_malloc(size_t size)
     return alloc;
 }
 
+void * lv_malloc_heap(size_t size, lv_mem_heap_t heap)
+{
+#if LV_MEM_BULK
+    if(size == 0 || heap == LV_MEM_HEAP_FAST) return lv_malloc(size);
+
+    LV_TRACE_MEM("allocating %lu bytes in the %s heap", (unsigned long)size, lv_mem_heap_get_name(heap));
+    void * alloc = lv_malloc_heap_core(size, heap);
+    if(alloc == NULL) {
+        LV_LOG_INFO("couldn't allocate memory (%lu bytes) in the %s heap", (unsigned long)size,
+                    lv_mem_heap_get_name(heap));
+        return NULL;
+    }
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(alloc, 0xaa, size);
+#endif
+
+    LV_TRACE_MEM("allocated at %p", alloc);
+    return alloc;
+#else
+    LV_UNUSED(heap);
+    return lv_malloc(size);
+#endif
+}
+
 void * lv_malloc_zeroed(size_t size)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
@@ -163,6 +195,18 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+const char * lv_mem_heap_get_name(lv_mem_heap_t heap)
+{
+    if(heap >= LV_MEM_HEAP_CNT) return "?";
+    return heap_names[heap];
+}
+
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag)
+{
+    if(tag >= LV_MEM_TAG_LAST) return "?";
+    return tag_names[tag];
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -23,12 +23,94 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_USE_OS == LV_OS_PTHREAD && LV_MEM_THREAD_CACHE_SIZE > 0
+/** Small blocks are cached per thread in size classes (see `LV_MEM_THREAD_CACHE_SIZE`)*/
+#define LV_MEM_THREAD_CACHE 1
+#define LV_MEM_THREAD_CACHE_CLASS_CNT 8
+#else
+#define LV_MEM_THREAD_CACHE 0
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_TRACK_BLOCK_CNT > 0
+/** The blocks are recorded with their tag (see `LV_MEM_TRACK_BLOCK_CNT`)*/
+#define LV_MEM_TRACK 1
+/** Lifetime ranges of the freed blocks: < 16 ms, < 64 ms, < 256 ms, ... (4 times longer each), and longer*/
+#define LV_MEM_TRACK_LIFETIME_CNT 8
+#else
+#define LV_MEM_TRACK 0
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE > 0
+/** The draw buffers and the decoded images have their own heap (see `LV_MEM_BULK_SIZE`)*/
+#define LV_MEM_BULK 1
+#else
+#define LV_MEM_BULK 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 typedef void * lv_mem_pool_t;
 
+/**
+ * The heaps of the builtin allocator. There is only the fast heap without `LV_MEM_BULK_SIZE`.
+ */
+typedef enum {
+    LV_MEM_HEAP_FAST = 0,   /**< `LV_MEM_SIZE` heap, e.g. in internal SRAM: widgets, styles, draw tasks, ...*/
+    LV_MEM_HEAP_BULK,       /**< `LV_MEM_BULK_SIZE` heap, e.g. in SDRAM: draw buffers and decoded images*/
+    LV_MEM_HEAP_CNT,
+} lv_mem_heap_t;
+
+/**
+ * The subsystem an allocation is made for
+ */
+typedef enum {
+    LV_MEM_TAG_OTHER = 0,
+    LV_MEM_TAG_OBJ,         /**< Widgets and their children arrays*/
+    LV_MEM_TAG_STYLE,       /**< Style properties, style arrays and local styles of the widgets*/
+    LV_MEM_TAG_TEXT,        /**< Text of the labels*/
+    LV_MEM_TAG_DRAW,        /**< Draw tasks, layers and their buffers*/
+    LV_MEM_TAG_IMAGE,       /**< Decoded images and the image cache*/
+    LV_MEM_TAG_FONT,        /**< Glyph cache and lookup tables of the fonts*/
+    LV_MEM_TAG_ANIM,        /**< Animations*/
+    LV_MEM_TAG_LAST,
+} lv_mem_tag_t;
+
+typedef enum {
+    LV_MEM_TRACK_OP_ALLOC,
+    LV_MEM_TRACK_OP_FREE,
+    LV_MEM_TRACK_OP_REALLOC,
+} lv_mem_track_op_t;
+
+/**
+ * An allocation, free or reallocation of an allocation trace
+ */
+typedef struct {
+    uint32_t id;        /**< Sequence number of the allocation (kept by its reallocations). 0: failed allocation*/
+    uint32_t size;      /**< Requested size of an allocation or reallocation*/
+    uint8_t op;         /**< `lv_mem_track_op_t`*/
+    uint8_t tag;        /**< `lv_mem_tag_t` of the block*/
+} lv_mem_track_event_t;
+
+/**
+ * Receives the events of an allocation trace. It's called with the heap locked so it must not allocate.
+ */
+typedef void (*lv_mem_track_trace_cb_t)(const lv_mem_track_event_t * event, void * user_data);
+
+#if LV_MEM_THREAD_CACHE
+/**
+ * Statistics of a size class of the thread caches
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the blocks in bytes */
+    uint32_t cached_cnt;    /**< Free blocks kept by the threads */
+    uint32_t hits;          /**< Allocations served by a thread cache without locking the heap */
+    uint32_t refills;       /**< Batches of blocks taken from the heap */
+    uint32_t flushes;       /**< Batches of blocks given back to the heap */
+} lv_mem_class_monitor_t;
+#endif
+
 /**
  * Heap information structure.
  */
@@ -41,8 +123,47 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+#if LV_MEM_THREAD_CACHE
+    uint32_t thread_cnt;    /**< Threads having a cache */
+    size_t cached_size;     /**< Free blocks kept in the thread caches. They are counted as used above. */
+    lv_mem_class_monitor_t classes[LV_MEM_THREAD_CACHE_CLASS_CNT];
+#endif
 } lv_mem_monitor_t;
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+/**
+ * Usage of a heap
+ */
+typedef struct {
+    size_t total_size;      /**< Bytes of its pools. 0: the heap has no pool*/
+    size_t free_size;
+    size_t free_biggest_size;
+    size_t cur_used;        /**< Bytes of the blocks in use, with the blocks kept in the thread caches*/
+    size_t max_used;
+    uint32_t fallback_cnt;  /**< Allocations for this heap placed in the other one because it was full*/
+    uint32_t fail_cnt;      /**< Allocations for this heap which fit in none of the heaps*/
+} lv_mem_heap_monitor_t;
+#endif
+
+#if LV_MEM_TRACK
+/**
+ * Allocations of a tag
+ */
+typedef struct {
+    uint32_t cur_cnt;       /**< Blocks in use*/
+    size_t cur_size;        /**< Requested bytes in use*/
+    size_t max_size;        /**< Most requested bytes in use at once*/
+    uint32_t alloc_cnt;     /**< Allocations since the last reset*/
+    uint32_t fail_cnt;      /**< Failed allocations since the last reset*/
+    uint32_t lifetimes[LV_MEM_TRACK_LIFETIME_CNT];  /**< Freed blocks per lifetime range*/
+} lv_mem_tag_monitor_t;
+
+typedef struct {
+    lv_mem_tag_monitor_t tags[LV_MEM_TAG_LAST];
+    uint32_t untracked_cnt;     /**< Allocations not recorded because the table was full. Their frees are not traced.*/
+} lv_mem_track_monitor_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +180,12 @@ void lv_mem_deinit(void);
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
+/**
+ * Remove a pool added with `lv_mem_add_pool()`. Its blocks need to be freed.
+ * The blocks kept in the thread caches (`LV_MEM_THREAD_CACHE`) are freed here,
+ * so the other threads must not allocate or free meanwhile.
+ * @param pool      the pool to remove
+ */
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
 /**
@@ -68,6 +195,16 @@ void lv_mem_remove_pool(lv_mem_pool_t pool);
  */
 void * lv_malloc(size_t size);
 
+/**
+ * Allocate memory in a given heap. When it's full a fast allocation is placed in the bulk heap
+ * and a bulk allocation in the fast heap if a quarter of the fast heap stays free.
+ * It's `lv_malloc()` without the bulk heap. The block is freed and reallocated with `lv_free()` and `lv_realloc()`.
+ * @param size  requested size in bytes
+ * @param heap  the heap to use first
+ * @return      pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_heap(size_t size, lv_mem_heap_t heap);
+
 /**
  * Allocate zeroed memory dynamically
  * @param size requested size in bytes
@@ -96,6 +233,15 @@ void * lv_realloc(void * data_p, size_t new_size);
  */
 void * lv_malloc_core(size_t size);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+/**
+ * Used internally by `lv_malloc_heap()`
+ * @param size      size in bytes to `malloc`
+ * @param heap      the heap to use first
+ */
+void * lv_malloc_heap_core(size_t size, lv_mem_heap_t heap);
+#endif
+
 /**
  * Used internally to execute a plain `free` operation
  * @param p      memory address to free
@@ -124,16 +270,131 @@ lv_result_t lv_mem_test_core(void);
 lv_result_t lv_mem_test(void);
 
 /**
- * Give information about the work memory of dynamic allocation
+ * Give information about the work memory of dynamic allocation.
+ * With the builtin allocator it's the fast heap, see `lv_mem_heap_monitor()` for the bulk heap.
  * @param mon_p pointer to a lv_mem_monitor_t variable,
  *              the result of the analysis will be stored here
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Get the name of a heap, e.g. "bulk"
+ * @param heap  a heap
+ * @return      its name
+ */
+const char * lv_mem_heap_get_name(lv_mem_heap_t heap);
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+
+/**
+ * Add memory to a heap. The first pool of the bulk heap creates it, it can't be removed.
+ * @param heap      the heap to extend
+ * @param mem       start of the memory
+ * @param bytes     size of the memory, at most `LV_MEM_BULK_SIZE` for the bulk heap
+ * @return          the pool to remove it with `lv_mem_remove_pool()` or NULL on error
+ */
+lv_mem_pool_t lv_mem_add_heap_pool(lv_mem_heap_t heap, void * mem, size_t bytes);
+
+/**
+ * Get the heap of an allocated block
+ * @param p     a block allocated by `lv_malloc()` or `lv_malloc_heap()`
+ * @return      the heap it's placed in
+ */
+lv_mem_heap_t lv_mem_get_heap(const void * p);
+
+/**
+ * Get the usage, the fallbacks and the failures of a heap
+ * @param heap      a heap
+ * @param mon_p     pointer to a variable to store the result
+ */
+void lv_mem_heap_monitor(lv_mem_heap_t heap, lv_mem_heap_monitor_t * mon_p);
+
+/**
+ * Reset the fallback and failure counters and the maximal usage of the heaps
+ */
+void lv_mem_heap_reset_stats(void);
+
+#endif
+
+#if LV_MEM_THREAD_CACHE
+
+/**
+ * Enable or disable the thread caches, e.g. to compare the heap with and without them.
+ * The blocks already cached are kept until they are allocated or flushed.
+ * @param en    true: enable (default), false: lock the heap for every allocation
+ */
+void lv_mem_enable_thread_cache(bool en);
+
+/**
+ * Give back the cached blocks of the calling thread to the heap.
+ * The caches of the other threads are flushed when they exit.
+ */
+void lv_mem_flush_thread_cache(void);
+
+#endif
+
+/**
+ * Get the name of a tag, e.g. "style"
+ * @param tag   a tag
+ * @return      its name
+ */
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag);
+
+#if LV_MEM_TRACK
+
+/**
+ * Tag the next allocations of the calling thread until `lv_mem_track_pop_tag()`.
+ * The tags can be nested 8 levels deep, the innermost one is used.
+ * Use `LV_MEM_TAG_PUSH()` to compile it only with the tracker.
+ * @param tag   the subsystem the next allocations are made for
+ */
+void lv_mem_track_push_tag(lv_mem_tag_t tag);
+
+/**
+ * Restore the tag used before the last `lv_mem_track_push_tag()`
+ */
+void lv_mem_track_pop_tag(void);
+
+/**
+ * Get the current and the past allocations of each tag
+ * @param mon_p     pointer to a variable to store the result
+ */
+void lv_mem_track_monitor(lv_mem_track_monitor_t * mon_p);
+
+/**
+ * Reset the allocation, failure and lifetime counters and the maximums of the tags
+ */
+void lv_mem_track_reset(void);
+
+/**
+ * Log the allocations and lifetimes of each tag, the sizes of the free blocks and a map of the heap
+ * where each character shows the tag of the block covering most of its bytes.
+ * It's also logged on the first failed allocation.
+ */
+void lv_mem_track_dump(void);
+
+/**
+ * Send all the allocations, frees and reallocations to a callback, e.g. to replay them with other heaps.
+ * The blocks in use are sent first as allocations in address order.
+ * @param cb            the callback or NULL to stop the trace
+ * @param user_data     passed to the callback
+ */
+void lv_mem_track_set_trace_cb(lv_mem_track_trace_cb_t cb, void * user_data);
+
+#endif
+
 /**********************
  *      MACROS
  **********************/
 
+#if LV_MEM_TRACK
+#define LV_MEM_TAG_PUSH(tag) lv_mem_track_push_tag(tag)
+#define LV_MEM_TAG_POP() lv_mem_track_pop_tag()
+#else
+#define LV_MEM_TAG_PUSH(tag)
+#define LV_MEM_TAG_POP()
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -34,6 +34,10 @@ static void lv_image_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_image(lv_event_t * e);
 static void scale_update(lv_obj_t * obj, int32_t scale_x, int32_t scale_y);
 static void update_align(lv_obj_t * obj);
+#if LV_IMAGE_DECODER_ASYNC
+    static void image_decoded_cb(const void * src, void * user_data);
+    static void draw_placeholder(lv_obj_t * obj, lv_layer_t * layer, lv_draw_image_dsc_t * draw_dsc);
+#endif
 #if LV_USE_OBJ_PROPERTY
     static void lv_image_set_pivot_helper(lv_obj_t * obj, lv_point_t * pivot);
     static lv_point_t lv_image_get_pivot_helper(lv_obj_t * obj);
@@ -154,6 +158,13 @@ void lv_image_set_src(lv_obj_t * obj, const void * src)
     lv_image_src_t src_type = lv_image_src_get_type(src);
     lv_image_t * img = (lv_image_t *)obj;
 
+#if LV_IMAGE_DECODER_ASYNC
+    /*Requested again when it's drawn if the source doesn't change*/
+    if(img->src_type == LV_IMAGE_SRC_FILE || img->src_type == LV_IMAGE_SRC_VARIABLE) {
+        lv_image_decoder_cancel_async(img->src, obj);
+    }
+#endif
+
 #if LV_USE_LOG && LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
     switch(src_type) {
         case LV_IMAGE_SRC_FILE:
@@ -454,6 +465,16 @@ void lv_image_set_bitmap_map_src(lv_obj_t * obj, const lv_image_dsc_t * src)
     lv_obj_invalidate(obj);
 }
 
+#if LV_IMAGE_DECODER_ASYNC
+void lv_image_set_placeholder(lv_obj_t * obj, const void * src)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_image_t * img = (lv_image_t *)obj;
+    img->placeholder = src;
+    lv_obj_invalidate(obj);
+}
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -567,6 +588,17 @@ const lv_image_dsc_t * lv_image_get_bitmap_map_src(lv_obj_t * obj)
     return img->bitmap_mask_src;
 }
 
+#if LV_IMAGE_DECODER_ASYNC
+const void * lv_image_get_placeholder(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_image_t * img = (lv_image_t *)obj;
+
+    return img->placeholder;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -601,6 +633,11 @@ static void lv_image_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_image_t * img = (lv_image_t *)obj;
+#if LV_IMAGE_DECODER_ASYNC
+    if(img->src_type == LV_IMAGE_SRC_FILE || img->src_type == LV_IMAGE_SRC_VARIABLE) {
+        lv_image_decoder_cancel_async(img->src, obj);
+    }
+#endif
     if(img->src_type == LV_IMAGE_SRC_FILE || img->src_type == LV_IMAGE_SRC_SYMBOL) {
         lv_free((void *)img->src);
         img->src      = NULL;
@@ -698,6 +735,14 @@ static void draw_image(lv_event_t * e)
             return;
         }
 
+#if LV_IMAGE_DECODER_ASYNC
+        /*Only the placeholder will be drawn*/
+        if(lv_image_decoder_open_async(img->src, image_decoded_cb, obj) != LV_RESULT_OK) {
+            info->res = LV_COVER_RES_NOT_COVER;
+            return;
+        }
+#endif
+
         /*Non true color format might have "holes"*/
         if(lv_color_format_has_alpha(img->cf)) {
             info->res = LV_COVER_RES_NOT_COVER;
@@ -791,6 +836,15 @@ static void draw_image(lv_event_t * e)
                 coords = draw_dsc.image_area;
             }
 
+#if LV_IMAGE_DECODER_ASYNC
+            /*Redrawn by `image_decoded_cb` when it's decoded*/
+            if(lv_image_decoder_open_async(img->src, image_decoded_cb, obj) != LV_RESULT_OK) {
+                draw_placeholder(obj, layer, &draw_dsc);
+                layer->_clip_area = clip_area_ori;
+                return;
+            }
+#endif
+
             lv_draw_image(layer, &draw_dsc, &coords);
             layer->_clip_area = clip_area_ori;
 
@@ -883,3 +937,38 @@ static lv_point_t lv_image_get_pivot_helper(lv_obj_t * obj)
 #endif
 
 #endif
+
+#if LV_IMAGE_DECODER_ASYNC
+static void image_decoded_cb(const void * src, void * user_data)
+{
+    LV_UNUSED(src);
+    lv_obj_invalidate(user_data);
+}
+
+static void draw_placeholder(lv_obj_t * obj, lv_layer_t * layer, lv_draw_image_dsc_t * draw_dsc)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+    if(img->placeholder == NULL) return;
+
+    lv_image_header_t header;
+    if(lv_image_decoder_get_info(img->placeholder, &header) != LV_RESULT_OK) return;
+    if(header.w == 0 || header.h == 0) return;
+
+    /*Stretch it from the top left corner of the image to the image's size, without the other transformations*/
+    lv_area_t coords;
+    lv_area_set(&coords, draw_dsc->image_area.x1, draw_dsc->image_area.y1,
+                draw_dsc->image_area.x1 + header.w - 1, draw_dsc->image_area.y1 + header.h - 1);
+
+    draw_dsc->src = img->placeholder;
+    draw_dsc->image_area = coords;
+    draw_dsc->scale_x = img->w * LV_SCALE_NONE / header.w;
+    draw_dsc->scale_y = img->h * LV_SCALE_NONE / header.h;
+    draw_dsc->rotation = 0;
+    draw_dsc->pivot.x = 0;
+    draw_dsc->pivot.y = 0;
+    draw_dsc->tile = 0;
+    draw_dsc->bitmap_mask_src = NULL;
+
+    lv_draw_image(layer, draw_dsc, &coords);
+}
+#endif
@@ -203,6 +203,16 @@ void lv_image_set_inner_align(lv_obj_t * obj, lv_image_align_t align);
  */
 void lv_image_set_bitmap_map_src(lv_obj_t * obj, const lv_image_dsc_t * src);
 
+#if LV_IMAGE_DECODER_ASYNC
+/**
+ * Set an image to draw, stretched to the image's size, while the image is being decoded (see `LV_USE_IMAGE_DECODER_ASYNC`).
+ * E.g. a thumbnail of the image. Without placeholder only the background of the widget is drawn meanwhile.
+ * @param obj       pointer to an image object
+ * @param src       an image drawn directly from the memory (not compressed) or NULL; only the pointer is saved
+ */
+void lv_image_set_placeholder(lv_obj_t * obj, const void * src);
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -294,6 +304,15 @@ lv_image_align_t lv_image_get_inner_align(lv_obj_t * obj);
  */
 const lv_image_dsc_t * lv_image_get_bitmap_map_src(lv_obj_t * obj);
 
+#if LV_IMAGE_DECODER_ASYNC
+/**
+ * Get the image drawn while the image is being decoded
+ * @param obj       pointer to an image object
+ * @return          the placeholder's source or NULL
+ */
+const void * lv_image_get_placeholder(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
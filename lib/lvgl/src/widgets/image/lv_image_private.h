@@ -46,6 +46,9 @@ struct lv_image_t {
     uint32_t antialias : 1; /**< Apply anti-aliasing in transformations (rotate, zoom)*/
     uint32_t align: 4;      /**< Image size mode when image size and object size is different. See lv_image_align_t*/
     uint32_t blend_mode: 4; /**< Element of `lv_blend_mode_t`*/
+#if LV_IMAGE_DECODER_ASYNC
+    const void * placeholder;   /**< Drawn stretched while the image is being decoded*/
+#endif
 };
 
 
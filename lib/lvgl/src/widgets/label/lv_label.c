@@ -146,7 +146,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
 
     /*If set its own text then reallocate it (maybe its size changed)*/
     if(label->text == text && label->static_txt == 0) {
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_TEXT);
         label->text = lv_realloc(label->text, text_len);
+        LV_MEM_TAG_POP();
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
 
@@ -162,7 +164,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
             label->text = NULL;
         }
 
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_TEXT);
         label->text = lv_malloc(text_len);
+        LV_MEM_TAG_POP();
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
 
@@ -196,7 +200,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     va_list args;
     va_start(args, fmt);
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_TEXT);
     label->text = lv_text_set_text_vfmt(fmt, args);
+    LV_MEM_TAG_POP();
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
@@ -639,7 +645,9 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     size_t old_len = lv_strlen(label->text);
     size_t ins_len = lv_strlen(txt);
     size_t new_len = ins_len + old_len;
+    LV_MEM_TAG_PUSH(LV_MEM_TAG_TEXT);
     label->text        = lv_realloc(label->text, new_len + 1);
+    LV_MEM_TAG_POP();
     LV_ASSERT_MALLOC(label->text);
     if(label->text == NULL) return;
 
@@ -1214,7 +1222,9 @@ static bool lv_label_set_dot_tmp(lv_obj_t * obj, char * data, uint32_t len)
     if(len > sizeof(char *)) {
         /*Memory needs to be allocated. Allocates an additional byte
          *for a NULL-terminator so it can be copied.*/
+        LV_MEM_TAG_PUSH(LV_MEM_TAG_TEXT);
         label->dot.tmp_ptr = lv_malloc(len + 1);
+        LV_MEM_TAG_POP();
         if(label->dot.tmp_ptr == NULL) {
             LV_LOG_ERROR("Failed to allocate memory for dot_tmp_ptr");
             return false;
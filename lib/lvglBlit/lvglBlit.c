@@ -0,0 +1,161 @@
+#include "lvglBlit.h"
+
+/*********************
+ *  STATIC PROTOTYPES
+ *********************/
+
+static blit_res_t memcpy_start(const blit_rect_t * rect, blit_done_cb_t done_cb, void * user_data);
+static void flush_done_cb(void * user_data);
+
+/*********************
+ *  STATIC VARIABLES
+ *********************/
+
+static const blit_backend_t memcpy_backend = {
+    .name = "memcpy",
+    .start = memcpy_start,
+};
+
+static const blit_backend_t * active_backend = &memcpy_backend;
+
+static uint8_t * fb_start;
+static int32_t fb_hor_res;
+static int32_t fb_ver_res;
+static uint32_t fb_px_size;
+
+static blit_stats_t stats;
+static uint32_t frame_transfers;
+static uint32_t frame_bytes;
+
+/*********************
+ *   GLOBAL FUNCTIONS
+ *********************/
+
+void blit_set_framebuffer(void * fb, int32_t hor_res, int32_t ver_res, uint32_t px_size)
+{
+    fb_start = (uint8_t *)fb;
+    fb_hor_res = hor_res;
+    fb_ver_res = ver_res;
+    fb_px_size = px_size;
+}
+
+void * blit_get_framebuffer(void)
+{
+    return fb_start;
+}
+
+void blit_set_backend(const blit_backend_t * backend)
+{
+    active_backend = backend ? backend : &memcpy_backend;
+}
+
+const blit_backend_t * blit_get_backend(void)
+{
+    return active_backend;
+}
+
+const blit_backend_t * blit_backend_memcpy(void)
+{
+    return &memcpy_backend;
+}
+
+void blit_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    uint32_t src_stride = lv_draw_buf_width_to_stride(w, lv_display_get_color_format(disp));
+
+    blit_area(area, px_map, src_stride, lv_display_flush_is_last(disp), flush_done_cb, disp);
+}
+
+void blit_area(const lv_area_t * area, const uint8_t * px_map, uint32_t src_stride, bool last,
+               blit_done_cb_t done_cb, void * user_data)
+{
+    lv_area_t clipped;
+    clipped.x1 = LV_MAX(area->x1, 0);
+    clipped.y1 = LV_MAX(area->y1, 0);
+    clipped.x2 = LV_MIN(area->x2, fb_hor_res - 1);
+    clipped.y2 = LV_MIN(area->y2, fb_ver_res - 1);
+
+    if(fb_start == NULL || clipped.x1 > clipped.x2 || clipped.y1 > clipped.y2) {
+        if(done_cb) done_cb(user_data);
+        return;
+    }
+
+    blit_rect_t rect;
+    rect.px_size = fb_px_size;
+    rect.w = lv_area_get_width(&clipped);
+    rect.h = lv_area_get_height(&clipped);
+    rect.src_stride = src_stride;
+    rect.dst_stride = fb_hor_res * fb_px_size;
+    rect.src = px_map + (clipped.y1 - area->y1) * src_stride + (clipped.x1 - area->x1) * fb_px_size;
+    rect.dst = fb_start + clipped.y1 * rect.dst_stride + clipped.x1 * fb_px_size;
+
+    uint32_t bytes = rect.w * rect.h * rect.px_size;
+    stats.transfers++;
+    stats.bytes += bytes;
+    frame_transfers++;
+    frame_bytes += bytes;
+
+    if(last) {
+        stats.frames++;
+        stats.last_frame_transfers = frame_transfers;
+        stats.last_frame_bytes = frame_bytes;
+        frame_transfers = 0;
+        frame_bytes = 0;
+    }
+
+    /*Falling back to the CPU while the backend still copies the previous area
+     *would call the callbacks out of order, so wait for it*/
+    blit_res_t res;
+    do {
+        res = active_backend->start(&rect, done_cb, user_data);
+    } while(res == BLIT_RES_BUSY);
+
+    if(res == BLIT_RES_UNSUPPORTED) {
+        memcpy_start(&rect, done_cb, user_data);
+    }
+}
+
+void blit_get_stats(blit_stats_t * s)
+{
+    *s = stats;
+}
+
+void blit_reset_stats(void)
+{
+    lv_memzero(&stats, sizeof(stats));
+    frame_transfers = 0;
+    frame_bytes = 0;
+}
+
+/*********************
+ *   STATIC FUNCTIONS
+ *********************/
+
+static blit_res_t memcpy_start(const blit_rect_t * rect, blit_done_cb_t done_cb, void * user_data)
+{
+    const uint8_t * src = (const uint8_t *)rect->src;
+    uint8_t * dst = (uint8_t *)rect->dst;
+    uint32_t line_bytes = rect->w * rect->px_size;
+
+    if(line_bytes == rect->src_stride && line_bytes == rect->dst_stride) {
+        lv_memcpy(dst, src, line_bytes * rect->h);
+    }
+    else {
+        uint32_t y;
+        for(y = 0; y < rect->h; y++) {
+            lv_memcpy(dst, src, line_bytes);
+            src += rect->src_stride;
+            dst += rect->dst_stride;
+        }
+    }
+
+    if(done_cb) done_cb(user_data);
+    return BLIT_RES_OK;
+}
+
+static void flush_done_cb(void * user_data)
+{
+    lv_display_t * disp = (lv_display_t *)user_data;
+    lv_display_flush_ready(disp);
+}
@@ -0,0 +1,132 @@
+#ifndef LVGL_BLIT_H
+#define LVGL_BLIT_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+/**
+ * One rectangle to copy from an LVGL draw buffer into the framebuffer.
+ * Strides are in bytes, sizes in pixels.
+ */
+typedef struct {
+    const void * src;
+    void * dst;
+    uint32_t src_stride;
+    uint32_t dst_stride;
+    uint32_t w;
+    uint32_t h;
+    uint32_t px_size;
+} blit_rect_t;
+
+/** Called by a backend once the rectangle has fully landed in the framebuffer (may run in an ISR). Can be NULL. */
+typedef void (*blit_done_cb_t)(void * user_data);
+
+typedef enum {
+    BLIT_RES_OK,            /**< The copy started (or is done), `done_cb` will be called */
+    BLIT_RES_BUSY,          /**< The previous copy is still running, try again */
+    BLIT_RES_UNSUPPORTED,   /**< The backend can't copy this rectangle (e.g. its format), use the CPU */
+} blit_res_t;
+
+/**
+ * A blit backend. `start` has to copy `rect` and call `done_cb` (if not NULL) when finished.
+ * Asynchronous backends return right away and call `done_cb` from their completion interrupt.
+ * While a copy is running they return BLIT_RES_BUSY before checking the rectangle,
+ * so a copy with the CPU never completes before the previous one.
+ */
+typedef struct {
+    const char * name;
+    blit_res_t (*start)(const blit_rect_t * rect, blit_done_cb_t done_cb, void * user_data);
+} blit_backend_t;
+
+/** Transfer counters, `last_frame_*` is updated when the last area of a frame is flushed */
+typedef struct {
+    uint32_t frames;
+    uint32_t transfers;
+    uint64_t bytes;
+    uint32_t last_frame_transfers;
+    uint32_t last_frame_bytes;
+} blit_stats_t;
+
+/*********************
+ * GLOBAL PROTOTYPES
+ *********************/
+
+/**
+ * Set the framebuffer `blit_flush_cb` writes to
+ * @param fb        start address of the framebuffer
+ * @param hor_res   width of the framebuffer in pixels
+ * @param ver_res   height of the framebuffer in pixels
+ * @param px_size   bytes per pixel (must match the display's color format)
+ */
+void blit_set_framebuffer(void * fb, int32_t hor_res, int32_t ver_res, uint32_t px_size);
+
+/**
+ * Get the framebuffer set by `blit_set_framebuffer`
+ * @return          start address of the framebuffer or NULL
+ */
+void * blit_get_framebuffer(void);
+
+/**
+ * Select the backend used by `blit_flush_cb`
+ * @param backend   a backend, e.g. `blit_backend_memcpy()`
+ */
+void blit_set_backend(const blit_backend_t * backend);
+
+/**
+ * Get the currently used backend
+ * @return          the active backend
+ */
+const blit_backend_t * blit_get_backend(void);
+
+/**
+ * The CPU backend: copies row by row with `lv_memcpy` and completes synchronously.
+ * It's the default and is used as host model in the emulator.
+ * @return          pointer to the backend
+ */
+const blit_backend_t * blit_backend_memcpy(void);
+
+/**
+ * Flush callback for `lv_display_set_flush_cb`.
+ * Copies the area into the framebuffer with the active backend and calls `lv_display_flush_ready`
+ * from the backend's completion, so LVGL can render the next area into the other buffer meanwhile.
+ */
+void blit_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
+
+/**
+ * Copy an area to the framebuffer with the active backend. Used by `blit_flush_cb`,
+ * and directly when an other driver owns the display (e.g. the emulator's host model).
+ * Waits while the backend is busy with the previous copy. If the backend doesn't support the area,
+ * it's copied with the CPU, so `done_cb` is always called in order.
+ * @param area          area to copy in framebuffer coordinates
+ * @param px_map        rendered pixels of `area`
+ * @param src_stride    stride of `px_map` in bytes
+ * @param last          true: it's the last area of the frame
+ * @param done_cb       called when the copy finished, can be NULL
+ * @param user_data     passed to `done_cb`
+ */
+void blit_area(const lv_area_t * area, const uint8_t * px_map, uint32_t src_stride, bool last,
+               blit_done_cb_t done_cb, void * user_data);
+
+/**
+ * Get the transfer counters
+ * @param stats     store the counters here
+ */
+void blit_get_stats(blit_stats_t * stats);
+
+/**
+ * Clear the transfer counters
+ */
+void blit_reset_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LVGL_BLIT_H*/
@@ -0,0 +1,115 @@
+#include "lvglSwap.h"
+
+/*********************
+ *  STATIC PROTOTYPES
+ *********************/
+
+static void host_set_address(uintptr_t addr);
+static void host_reload_on_vblank(void);
+
+/*********************
+ *  STATIC VARIABLES
+ *********************/
+
+static lv_display_t * swap_disp;
+static const swap_layer_t * swap_layer;
+static void * volatile front_buf;
+static void * volatile pending_buf;
+static swap_stats_t stats;
+
+static const swap_layer_t host_layer = {
+    .set_address = host_set_address,
+    .reload_on_vblank = host_reload_on_vblank,
+};
+
+static uintptr_t host_shadow_address;
+static uintptr_t host_active_address;
+static bool host_reload_armed;
+
+/*********************
+ *   GLOBAL FUNCTIONS
+ *********************/
+
+void swap_init(lv_display_t * disp, const swap_layer_t * layer, void * front)
+{
+    swap_disp = disp;
+    swap_layer = layer;
+    front_buf = front;
+    pending_buf = NULL;
+    lv_memzero(&stats, sizeof(stats));
+
+    layer->set_address((uintptr_t)front);
+    layer->reload_on_vblank();
+}
+
+void swap_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+
+    if(px_map == front_buf) stats.front_buffer_writes++;
+
+    if(!lv_display_flush_is_last(disp)) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    /*`flushing` stays set until the swap happened, so LVGL won't render into the buffer just being sent*/
+    pending_buf = px_map;
+    swap_layer->set_address((uintptr_t)px_map);
+    swap_layer->reload_on_vblank();
+}
+
+void swap_vblank(void)
+{
+    if(pending_buf == NULL) return;
+
+    front_buf = pending_buf;
+    pending_buf = NULL;
+    stats.swaps++;
+
+    if(swap_disp) lv_display_flush_ready(swap_disp);
+}
+
+void * swap_get_front(void)
+{
+    return front_buf;
+}
+
+void swap_get_stats(swap_stats_t * s)
+{
+    *s = stats;
+}
+
+const swap_layer_t * swap_layer_host(void)
+{
+    return &host_layer;
+}
+
+bool swap_host_vblank(void)
+{
+    if(!host_reload_armed) return false;
+
+    host_reload_armed = false;
+    host_active_address = host_shadow_address;
+    swap_vblank();
+    return true;
+}
+
+uintptr_t swap_host_get_active_address(void)
+{
+    return host_active_address;
+}
+
+/*********************
+ *   STATIC FUNCTIONS
+ *********************/
+
+static void host_set_address(uintptr_t addr)
+{
+    host_shadow_address = addr;
+}
+
+static void host_reload_on_vblank(void)
+{
+    host_reload_armed = true;
+}
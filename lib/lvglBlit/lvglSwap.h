@@ -0,0 +1,94 @@
+#ifndef LVGL_SWAP_H
+#define LVGL_SWAP_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+/**
+ * Access to the scanned out layer. On the board it's the LTDC, on the host `swap_layer_host()`.
+ */
+typedef struct {
+    /** Write the frame buffer address to the shadow register, it's not used until the reload */
+    void (*set_address)(uintptr_t addr);
+    /** Load the shadow registers at the next vertical blanking and call `swap_vblank()` then */
+    void (*reload_on_vblank)(void);
+} swap_layer_t;
+
+/** Swap counters */
+typedef struct {
+    uint32_t swaps;
+    /** Areas flushed from the buffer which was being scanned out. Must stay 0. */
+    uint32_t front_buffer_writes;
+} swap_stats_t;
+
+/*********************
+ * GLOBAL PROTOTYPES
+ *********************/
+
+/**
+ * Drive a display with two full size frame buffers (DIRECT or FULL render mode)
+ * by swapping the layer address instead of copying.
+ * `refr_sync_areas` in LVGL keeps the two buffers in sync in DIRECT mode.
+ * @param disp      the display, buffers have to be set already
+ * @param layer     access to the layer registers
+ * @param front     address of the buffer scanned out initially,
+ *                  the second buffer as LVGL renders the first frame into the first one
+ */
+void swap_init(lv_display_t * disp, const swap_layer_t * layer, void * front);
+
+/**
+ * Flush callback for `lv_display_set_flush_cb`. Only the last area of a frame does something:
+ * it schedules the swap to its buffer and `lv_display_flush_ready` is called from `swap_vblank()`.
+ */
+void swap_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
+
+/**
+ * Call when the shadow registers were reloaded (e.g. from the LTDC reload interrupt).
+ * The new buffer is on screen and the old one can be rendered again.
+ */
+void swap_vblank(void);
+
+/**
+ * Get the address of the buffer being scanned out
+ * @return          address of the front buffer
+ */
+void * swap_get_front(void);
+
+/**
+ * Get the swap counters
+ * @param stats     store the counters here
+ */
+void swap_get_stats(swap_stats_t * stats);
+
+/**
+ * A stand-in for the LTDC layer address and reload registers.
+ * `swap_host_vblank()` plays the vertical blanking.
+ * @return          pointer to the layer
+ */
+const swap_layer_t * swap_layer_host(void);
+
+/**
+ * Simulated vertical blanking of `swap_layer_host()`:
+ * loads the shadow address if a reload is armed and calls `swap_vblank()`.
+ * @return          true: a reload happened
+ */
+bool swap_host_vblank(void);
+
+/**
+ * Get the address the host layer is scanning out
+ * @return          the active address register
+ */
+uintptr_t swap_host_get_active_address(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LVGL_SWAP_H*/
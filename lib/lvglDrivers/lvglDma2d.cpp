@@ -0,0 +1,91 @@
+#include "lvglDma2d.h"
+
+#include <Arduino.h>
+
+static DMA2D_HandleTypeDef hdma2d;
+static blit_done_cb_t pending_done_cb;
+static void *pending_user_data;
+// Set from the start of a transfer until its interrupt, also when there is no callback
+static volatile bool transfer_running;
+
+static void transfer_complete(DMA2D_HandleTypeDef *hdma)
+{
+    blit_done_cb_t done_cb = pending_done_cb;
+    pending_done_cb = NULL;
+    transfer_running = false;
+    if (done_cb)
+        done_cb(pending_user_data);
+}
+
+static void transfer_error(DMA2D_HandleTypeDef *hdma)
+{
+    // Don't leave LVGL waiting for a flush that will never finish
+    transfer_complete(hdma);
+}
+
+static blit_res_t dma2d_start(const blit_rect_t *rect, blit_done_cb_t done_cb, void *user_data)
+{
+    // Checked first: the caller must not copy with the CPU while the DMA2D still writes
+    if (transfer_running)
+        return BLIT_RES_BUSY;
+
+    if (rect->px_size != 4)
+        return BLIT_RES_UNSUPPORTED;
+
+    if ((rect->src_stride % 4) != 0 || (rect->dst_stride % 4) != 0)
+        return BLIT_RES_UNSUPPORTED;
+
+    hdma2d.Instance = DMA2D;
+    hdma2d.Init.Mode = DMA2D_M2M_PFC;
+    hdma2d.Init.ColorMode = DMA2D_OUTPUT_ARGB8888;
+    hdma2d.Init.OutputOffset = rect->dst_stride / 4 - rect->w;
+
+    hdma2d.LayerCfg[1].AlphaMode = DMA2D_REPLACE_ALPHA;
+    hdma2d.LayerCfg[1].InputAlpha = 0xFF;
+    hdma2d.LayerCfg[1].InputColorMode = DMA2D_INPUT_ARGB8888;
+    hdma2d.LayerCfg[1].InputOffset = rect->src_stride / 4 - rect->w;
+
+    hdma2d.XferCpltCallback = transfer_complete;
+    hdma2d.XferErrorCallback = transfer_error;
+
+    if (HAL_DMA2D_Init(&hdma2d) != HAL_OK || HAL_DMA2D_ConfigLayer(&hdma2d, 1) != HAL_OK)
+        return BLIT_RES_UNSUPPORTED;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // The DMA2D reads memory directly: write back what the CPU rendered into the cache
+    if (SCB->CCR & SCB_CCR_DC_Msk)
+        SCB_CleanDCache_by_Addr((uint32_t *)rect->src, rect->src_stride * rect->h);
+#endif
+
+    pending_done_cb = done_cb;
+    pending_user_data = user_data;
+    transfer_running = true;
+
+    if (HAL_DMA2D_Start_IT(&hdma2d, (uint32_t)rect->src, (uint32_t)rect->dst, rect->w, rect->h) != HAL_OK)
+    {
+        pending_done_cb = NULL;
+        transfer_running = false;
+        return BLIT_RES_UNSUPPORTED;
+    }
+
+    return BLIT_RES_OK;
+}
+
+static const blit_backend_t dma2d_backend = {
+    "dma2d",
+    dma2d_start,
+};
+
+const blit_backend_t *blit_backend_dma2d(void)
+{
+    __HAL_RCC_DMA2D_CLK_ENABLE();
+    HAL_NVIC_SetPriority(DMA2D_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+
+    return &dma2d_backend;
+}
+
+extern "C" void DMA2D_IRQHandler(void)
+{
+    HAL_DMA2D_IRQHandler(&hdma2d);
+}
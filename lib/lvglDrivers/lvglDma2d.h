@@ -0,0 +1,14 @@
+#ifndef LVGL_DMA2D_H
+#define LVGL_DMA2D_H
+
+#include "lvglBlit.h"
+
+/**
+ * Blit backend using the DMA2D in memory-to-memory with pixel format conversion mode.
+ * The alpha channel is replaced with 0xFF so LVGL's XRGB8888 output is shown opaque on the ARGB8888 layer.
+ * Completion is signalled from the DMA2D transfer complete interrupt.
+ * @return          pointer to the backend
+ */
+const blit_backend_t * blit_backend_dma2d(void);
+
+#endif // LVGL_DMA2D_H
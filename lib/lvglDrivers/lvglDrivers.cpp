@@ -1,34 +1,50 @@
 #include "lvglDrivers.h"
 #include "lv_conf.h"
 #include "stm32746g_discovery_lcd.h"
+#include "stm32746g_discovery_sdram.h"
 #include "stm32746g_discovery_ts.h"
+#include "lvglBlit.h"
+#include "lvglDma2d.h"
+#include "lvglSwap.h"
+#include "uiTiming.h"
 
 static void lvglTask(void *pvParameters)
 {
     while (1)
     {
-        uint32_t time_till_next = lv_timer_handler();
+        uint32_t time_till_next = ui_timing_timer_handler();
         vTaskDelay(pdMS_TO_TICKS(time_till_next));
     }
 }
 
-static void my_flush_cb(lv_display_t *display, const lv_area_t *area, uint8_t *px_map)
+#if LVGL_RENDER_MODE != LVGL_RENDER_PARTIAL
+extern LTDC_HandleTypeDef hLtdcHandler;
+
+static void ltdc_set_address(uintptr_t addr)
 {
-    uint32_t *buf = (uint32_t *)px_map;
-    int32_t x, y;
-    for (y = area->y1; y <= area->y2; y++)
-    {
-        for (x = area->x1; x <= area->x2; x++)
-        {
-            BSP_LCD_DrawPixel(x, y, *buf);
-            buf++;
-        }
-    }
+    BSP_LCD_SetLayerAddress_NoReload(0, addr);
+}
+
+static void ltdc_reload_on_vblank(void)
+{
+    BSP_LCD_Reload(LCD_RELOAD_VERTICAL_BLANKING);
+}
+
+static const swap_layer_t ltdc_layer = {
+    ltdc_set_address,
+    ltdc_reload_on_vblank,
+};
+
+extern "C" void LTDC_IRQHandler(void)
+{
+    HAL_LTDC_IRQHandler(&hLtdcHandler);
+}
 
-    // IMPORTANT!!!
-    // Inform LVGL that you are ready with the flushing and buf is not used anymore
-    lv_display_flush_ready(display);
+extern "C" void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+    swap_vblank();
 }
+#endif
 
 static void my_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
@@ -59,17 +75,49 @@ void setup()
 
     lv_init();
 
+    // Room for two framebuffers at the start of the SDRAM, whatever the render mode
+    uint32_t fb_size = 480 * 272 * sizeof(uint32_t);
+
+#if LV_MEM_BULK
+    // The rest of the SDRAM holds the draw buffers and the decoded images,
+    // the widgets, styles and draw tasks stay in the internal SRAM heap (LV_MEM_SIZE)
+    lv_mem_add_heap_pool(LV_MEM_HEAP_BULK, (void *)(SDRAM_DEVICE_ADDR + 2 * fb_size), SDRAM_DEVICE_SIZE - 2 * fb_size);
+#endif
+
     lv_log_register_print_cb([](lv_log_level_t level, const char *buf) {
         Serial.printf("%s", buf);
     });
 
     lv_display_t *display = lv_display_create(480, 272);
 
-    lv_display_set_flush_cb(display, my_flush_cb);
+#if LVGL_RENDER_MODE == LVGL_RENDER_PARTIAL
+    // Areas are copied to the LTDC framebuffer by the DMA2D while LVGL renders the next one in the other buffer
+    blit_set_framebuffer((void *)LCD_FB_START_ADDRESS, 480, 272, sizeof(uint32_t));
+    blit_set_backend(blit_backend_dma2d());
+    lv_display_set_flush_cb(display, blit_flush_cb);
 
-    static uint32_t buf[480 * 272 / 10];
+    static uint32_t buf1[480 * 272 / 10];
+    static uint32_t buf2[480 * 272 / 10];
 
-    lv_display_set_buffers(display, buf, NULL, sizeof(buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_buffers(display, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#else
+    // The LTDC scans out one SDRAM framebuffer while LVGL renders into the other, no copy at all.
+    // In DIRECT mode LVGL copies the areas changed in the last frame to the other buffer (refr_sync_areas).
+    void *fb1 = (void *)LCD_FB_START_ADDRESS;
+    void *fb2 = (void *)(LCD_FB_START_ADDRESS + fb_size);
+
+    // fb2 is scanned out until the first frame is flushed and is the first one rendered into after the swap.
+    // The SDRAM holds garbage after reset: clear it so no noise is shown nor kept by the partial DIRECT redraws.
+    lv_memzero(fb2, fb_size);
+
+    lv_display_set_buffers(display, fb1, fb2, fb_size,
+                           LVGL_RENDER_MODE == LVGL_RENDER_DIRECT ? LV_DISPLAY_RENDER_MODE_DIRECT : LV_DISPLAY_RENDER_MODE_FULL);
+    lv_display_set_flush_cb(display, swap_flush_cb);
+
+    HAL_NVIC_SetPriority(LTDC_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    swap_init(display, &ltdc_layer, fb2);
+#endif
 
     lv_indev_t *indev = lv_indev_create();
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
@@ -79,6 +127,9 @@ void setup()
 
     mySetup();
 
+    // Histogram of the lv_timer_handler durations on the serial port
+    ui_timing_log_every(10000);
+
     xTaskCreate(lvglTask, NULL, 16384, NULL, osPriorityNormal, NULL);
     xTaskCreate(myTask, NULL, 16384, NULL, osPriorityNormal, NULL);
 
@@ -6,6 +6,16 @@
 #include <Arduino.h>
 #include "STM32FreeRTOS.h"
 
+// LVGL_RENDER_PARTIAL: two strip buffers in SRAM copied to the framebuffer by the DMA2D
+// LVGL_RENDER_DIRECT/FULL: two framebuffers in SDRAM, the LTDC layer address is swapped on vblank
+#define LVGL_RENDER_PARTIAL 0
+#define LVGL_RENDER_DIRECT 1
+#define LVGL_RENDER_FULL 2
+
+#ifndef LVGL_RENDER_MODE
+#define LVGL_RENDER_MODE LVGL_RENDER_PARTIAL
+#endif
+
 void mySetup();
 void myTask(void *pvParameters);
 
@@ -0,0 +1,73 @@
+#include "sampleRing.h"
+#include <stddef.h>
+
+/*********************
+ *      MACROS
+ *********************/
+
+/*The sample has to be in memory before the producer publishes `head`, and read before the consumer publishes `tail`*/
+#define LOAD_ACQUIRE(p)         __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v)     __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define LOAD_RELAXED(p)         __atomic_load_n(p, __ATOMIC_RELAXED)
+
+/*********************
+ *   GLOBAL FUNCTIONS
+ *********************/
+
+void sample_ring_init(sample_ring_t * ring, sample_t * buf, uint32_t capacity)
+{
+    ring->buf = buf;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+bool sample_ring_push(sample_ring_t * ring, const sample_t * sample)
+{
+    uint32_t head = LOAD_RELAXED(&ring->head);
+    uint32_t tail = LOAD_ACQUIRE(&ring->tail);
+
+    if(head - tail > ring->mask) return false;
+
+    ring->buf[head & ring->mask] = *sample;
+    STORE_RELEASE(&ring->head, head + 1);
+    return true;
+}
+
+bool sample_ring_pop(sample_ring_t * ring, sample_t * sample)
+{
+    uint32_t tail = LOAD_RELAXED(&ring->tail);
+    uint32_t head = LOAD_ACQUIRE(&ring->head);
+
+    if(head == tail) return false;
+
+    if(sample) *sample = ring->buf[tail & ring->mask];
+    STORE_RELEASE(&ring->tail, tail + 1);
+    return true;
+}
+
+bool sample_ring_peek(const sample_ring_t * ring, uint32_t index, sample_t * sample)
+{
+    uint32_t tail = LOAD_RELAXED(&ring->tail);
+    uint32_t head = LOAD_ACQUIRE(&ring->head);
+
+    if(index >= head - tail) return false;
+
+    *sample = ring->buf[(tail + index) & ring->mask];
+    return true;
+}
+
+uint32_t sample_ring_count(const sample_ring_t * ring)
+{
+    return LOAD_ACQUIRE(&ring->head) - LOAD_ACQUIRE(&ring->tail);
+}
+
+uint32_t sample_ring_capacity(const sample_ring_t * ring)
+{
+    return ring->mask + 1;
+}
+
+void sample_ring_clear(sample_ring_t * ring)
+{
+    STORE_RELEASE(&ring->tail, LOAD_ACQUIRE(&ring->head));
+}
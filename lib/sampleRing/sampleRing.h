@@ -0,0 +1,93 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+typedef struct {
+    uint32_t timestamp;     /**< Tick of the measurement in ms */
+    int32_t value;
+} sample_t;
+
+/**
+ * Single-producer/single-consumer ring of samples.
+ * One thread (e.g. the sensor task) pushes and one thread (e.g. the LVGL thread) reads, without locks.
+ * The indices run freely and are masked, so the capacity has to be a power of two.
+ */
+typedef struct {
+    sample_t * buf;
+    uint32_t mask;
+    uint32_t head;          /**< Written only by the producer */
+    uint32_t tail;          /**< Written only by the consumer */
+} sample_ring_t;
+
+/*********************
+ * GLOBAL PROTOTYPES
+ *********************/
+
+/**
+ * Initialize a ring
+ * @param ring      the ring to initialize
+ * @param buf       storage for `capacity` samples
+ * @param capacity  number of samples, must be a power of two
+ */
+void sample_ring_init(sample_ring_t * ring, sample_t * buf, uint32_t capacity);
+
+/**
+ * Append a sample. Producer side.
+ * @param ring      pointer to a ring
+ * @param sample    the sample to copy
+ * @return          false if the ring is full
+ */
+bool sample_ring_push(sample_ring_t * ring, const sample_t * sample);
+
+/**
+ * Remove the oldest sample. Consumer side.
+ * @param ring      pointer to a ring
+ * @param sample    store the sample here, can be NULL
+ * @return          false if the ring is empty
+ */
+bool sample_ring_pop(sample_ring_t * ring, sample_t * sample);
+
+/**
+ * Read a sample without removing it. Consumer side.
+ * @param ring      pointer to a ring
+ * @param index     0: the oldest sample
+ * @param sample    store the sample here
+ * @return          false if there is no sample at `index`
+ */
+bool sample_ring_peek(const sample_ring_t * ring, uint32_t index, sample_t * sample);
+
+/**
+ * Get the number of samples in the ring
+ * @param ring      pointer to a ring
+ * @return          number of samples
+ */
+uint32_t sample_ring_count(const sample_ring_t * ring);
+
+/**
+ * Get the number of samples the ring can hold
+ * @param ring      pointer to a ring
+ * @return          the capacity
+ */
+uint32_t sample_ring_capacity(const sample_ring_t * ring);
+
+/**
+ * Drop every sample. Consumer side.
+ * @param ring      pointer to a ring
+ */
+void sample_ring_clear(sample_ring_t * ring);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*SAMPLE_RING_H*/
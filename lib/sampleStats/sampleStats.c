@@ -0,0 +1,176 @@
+#include "sampleStats.h"
+#include <math.h>
+#include <string.h>
+
+/*********************
+ *  STATIC PROTOTYPES
+ *********************/
+
+static uint32_t lower_bound(const int32_t * a, uint32_t n, int32_t x);
+
+/*********************
+ *   GLOBAL FUNCTIONS
+ *********************/
+
+void welford_reset(welford_t * w)
+{
+    w->n = 0;
+    w->mean = 0.0f;
+    w->m2 = 0.0f;
+}
+
+void welford_add(welford_t * w, float x)
+{
+    w->n++;
+    float delta = x - w->mean;
+    w->mean += delta / (float)w->n;
+    w->m2 += delta * (x - w->mean);
+}
+
+float welford_mean(const welford_t * w)
+{
+    return w->mean;
+}
+
+float welford_variance(const welford_t * w)
+{
+    if(w->n < 2) return 0.0f;
+    return w->m2 / (float)(w->n - 1);
+}
+
+float welford_stddev(const welford_t * w)
+{
+    return sqrtf(welford_variance(w));
+}
+
+void median_filter_init(median_filter_t * m, uint32_t size)
+{
+    if(size == 0) size = 1;
+    if(size > SAMPLE_STATS_WINDOW_MAX) size = SAMPLE_STATS_WINDOW_MAX;
+
+    m->size = size;
+    m->count = 0;
+    m->next = 0;
+}
+
+int32_t median_filter_add(median_filter_t * m, int32_t x)
+{
+    if(m->count == m->size) {
+        /*Remove the oldest sample from the sorted array*/
+        int32_t old = m->fifo[m->next];
+        uint32_t i = lower_bound(m->sorted, m->count, old);
+        memmove(&m->sorted[i], &m->sorted[i + 1], (m->count - i - 1) * sizeof(int32_t));
+        m->count--;
+    }
+
+    uint32_t i = lower_bound(m->sorted, m->count, x);
+    memmove(&m->sorted[i + 1], &m->sorted[i], (m->count - i) * sizeof(int32_t));
+    m->sorted[i] = x;
+    m->count++;
+
+    m->fifo[m->next] = x;
+    m->next++;
+    if(m->next == m->size) m->next = 0;
+
+    return m->sorted[(m->count - 1) / 2];
+}
+
+void outlier_rejector_init(outlier_rejector_t * r, uint32_t size, uint32_t k, int32_t min_dev)
+{
+    if(size == 0) size = 1;
+    if(size > SAMPLE_STATS_WINDOW_MAX) size = SAMPLE_STATS_WINDOW_MAX;
+
+    r->size = size;
+    r->count = 0;
+    r->next = 0;
+    r->sum = 0;
+    r->sum_sq = 0;
+    r->k = k;
+    r->min_dev = min_dev;
+    r->rejected_in_row = 0;
+}
+
+bool outlier_rejector_add(outlier_rejector_t * r, int32_t x)
+{
+    if(r->count == r->size) {
+        /*Scaled by n to stay in integers: n * (x - mean) and n^2 * variance*/
+        int64_t n = r->count;
+        int64_t dev = n * x - r->sum;
+        int64_t var_n2 = n * r->sum_sq - r->sum * r->sum;
+        int64_t min_dev = n * r->min_dev;
+
+        bool outlier = dev * dev > (int64_t)(r->k * r->k) * var_n2 && dev * dev > min_dev * min_dev;
+        if(outlier) {
+            r->rejected_in_row++;
+            if(r->rejected_in_row < r->size) return false;
+
+            /*Not an outlier but a step: start over from here*/
+            r->count = 0;
+            r->next = 0;
+            r->sum = 0;
+            r->sum_sq = 0;
+        }
+        else {
+            int32_t old = r->fifo[r->next];
+            r->sum -= old;
+            r->sum_sq -= (int64_t)old * old;
+            r->count--;
+        }
+    }
+
+    r->rejected_in_row = 0;
+    r->fifo[r->next] = x;
+    r->sum += x;
+    r->sum_sq += (int64_t)x * x;
+    r->count++;
+    r->next++;
+    if(r->next == r->size) r->next = 0;
+
+    return true;
+}
+
+void sample_filter_init(sample_filter_t * f, uint32_t median_size, uint32_t reject_size, uint32_t k,
+                        int32_t min_dev)
+{
+    outlier_rejector_init(&f->rejector, reject_size, k, min_dev);
+    median_filter_init(&f->median, median_size);
+    welford_reset(&f->stats);
+}
+
+bool sample_filter_add(sample_filter_t * f, int32_t x, int32_t * out)
+{
+    if(!outlier_rejector_add(&f->rejector, x)) return false;
+
+    welford_add(&f->stats, (float)x);
+    *out = median_filter_add(&f->median, x);
+    return true;
+}
+
+const welford_t * sample_filter_get_stats(const sample_filter_t * f)
+{
+    return &f->stats;
+}
+
+void sample_filter_reset_stats(sample_filter_t * f)
+{
+    welford_reset(&f->stats);
+}
+
+/*********************
+ *   STATIC FUNCTIONS
+ *********************/
+
+/**
+ * Index of the first element not less than `x` in a sorted array
+ */
+static uint32_t lower_bound(const int32_t * a, uint32_t n, int32_t x)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    while(lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if(a[mid] < x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
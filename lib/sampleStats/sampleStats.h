@@ -0,0 +1,170 @@
+#ifndef SAMPLE_STATS_H
+#define SAMPLE_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Largest window of the median filter and the outlier rejector */
+#define SAMPLE_STATS_WINDOW_MAX 16
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+/** Running mean and variance of every sample since the last reset (Welford). Single precision for the FPU of the M7. */
+typedef struct {
+    uint32_t n;
+    float mean;
+    float m2;
+} welford_t;
+
+/** Median of the last `size` samples */
+typedef struct {
+    int32_t fifo[SAMPLE_STATS_WINDOW_MAX];     /**< Samples in arrival order */
+    int32_t sorted[SAMPLE_STATS_WINDOW_MAX];   /**< The same samples sorted */
+    uint32_t size;
+    uint32_t count;
+    uint32_t next;
+} median_filter_t;
+
+/**
+ * Rejects a sample which is farther than `k` standard deviations (but at least `min_dev`)
+ * from the mean of the last `size` accepted samples.
+ */
+typedef struct {
+    int32_t fifo[SAMPLE_STATS_WINDOW_MAX];
+    uint32_t size;
+    uint32_t count;
+    uint32_t next;
+    int64_t sum;
+    int64_t sum_sq;
+    uint32_t k;
+    int32_t min_dev;
+    uint32_t rejected_in_row;
+} outlier_rejector_t;
+
+/** Rejector -> median, with the running statistics of the accepted samples */
+typedef struct {
+    outlier_rejector_t rejector;
+    median_filter_t median;
+    welford_t stats;
+} sample_filter_t;
+
+/*********************
+ * GLOBAL PROTOTYPES
+ *********************/
+
+/**
+ * Forget every sample
+ * @param w         pointer to the statistics
+ */
+void welford_reset(welford_t * w);
+
+/**
+ * Add a sample in O(1)
+ * @param w         pointer to the statistics
+ * @param x         the new sample
+ */
+void welford_add(welford_t * w, float x);
+
+/**
+ * Get the mean
+ * @param w         pointer to the statistics
+ * @return          mean of the samples, 0 without samples
+ */
+float welford_mean(const welford_t * w);
+
+/**
+ * Get the sample variance
+ * @param w         pointer to the statistics
+ * @return          the variance, 0 with less than 2 samples
+ */
+float welford_variance(const welford_t * w);
+
+/**
+ * Get the sample standard deviation
+ * @param w         pointer to the statistics
+ * @return          square root of `welford_variance`
+ */
+float welford_stddev(const welford_t * w);
+
+/**
+ * Initialize a median filter
+ * @param m         the filter to initialize
+ * @param size      window size, 1..SAMPLE_STATS_WINDOW_MAX
+ */
+void median_filter_init(median_filter_t * m, uint32_t size);
+
+/**
+ * Add a sample. The oldest one leaves the window, binary search finds both slots in `sorted`.
+ * @param m         pointer to a filter
+ * @param x         the new sample
+ * @return          median of the window (the lower one of the two middle values for even counts)
+ */
+int32_t median_filter_add(median_filter_t * m, int32_t x);
+
+/**
+ * Initialize an outlier rejector
+ * @param r         the rejector to initialize
+ * @param size      window size, 1..SAMPLE_STATS_WINDOW_MAX
+ * @param k         tolerated distance from the mean in standard deviations
+ * @param min_dev   always tolerate at least this distance from the mean (e.g. the sensor's resolution)
+ */
+void outlier_rejector_init(outlier_rejector_t * r, uint32_t size, uint32_t k, int32_t min_dev);
+
+/**
+ * Test a sample in O(1) and add it to the window if it's accepted.
+ * If the window is not full yet every sample is accepted.
+ * If `size` samples are rejected in a row the signal really moved: the window restarts from the new value.
+ * @param r         pointer to a rejector
+ * @param x         the new sample
+ * @return          true: accepted; false: it's an outlier
+ */
+bool outlier_rejector_add(outlier_rejector_t * r, int32_t x);
+
+/**
+ * Initialize a filter
+ * @param f             the filter to initialize
+ * @param median_size   window of the median filter
+ * @param reject_size   window of the outlier rejector
+ * @param k             see `outlier_rejector_init`
+ * @param min_dev       see `outlier_rejector_init`
+ */
+void sample_filter_init(sample_filter_t * f, uint32_t median_size, uint32_t reject_size, uint32_t k,
+                        int32_t min_dev);
+
+/**
+ * Feed a raw sample
+ * @param f         pointer to a filter
+ * @param x         the raw sample
+ * @param out       store the filtered value here if the sample was accepted
+ * @return          true: `out` was updated; false: the sample was rejected
+ */
+bool sample_filter_add(sample_filter_t * f, int32_t x, int32_t * out);
+
+/**
+ * Get the running statistics of the accepted samples
+ * @param f         pointer to a filter
+ * @return          mean and variance of the samples accepted since the init or `sample_filter_reset_stats`
+ */
+const welford_t * sample_filter_get_stats(const sample_filter_t * f);
+
+/**
+ * Restart the running statistics, e.g. for each saved measurement. The windows of the filter are kept.
+ * @param f         pointer to a filter
+ */
+void sample_filter_reset_stats(sample_filter_t * f);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*SAMPLE_STATS_H*/
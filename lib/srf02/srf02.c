@@ -0,0 +1,160 @@
+#include "srf02.h"
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define REG_COMMAND 0x00
+#define REG_RANGE_HIGH 0x02
+
+#define CMD_RANGE_CM 0x51
+
+/*********************
+ *  STATIC PROTOTYPES
+ *********************/
+
+static bool trigger(srf02_t * sensor, uint32_t now);
+static bool fake_write_reg(uint8_t addr, uint8_t reg, uint8_t value, void * user_data);
+static bool fake_read_regs(uint8_t addr, uint8_t reg, uint8_t * buf, uint8_t len, void * user_data);
+
+/*********************
+ *  STATIC VARIABLES
+ *********************/
+
+static const srf02_bus_t fake_bus = {
+    .write_reg = fake_write_reg,
+    .read_regs = fake_read_regs,
+    .user_data = NULL,
+};
+
+static uint32_t fake_now;
+static uint32_t fake_ranging_start;
+static bool fake_ranging;
+static uint16_t fake_range;
+static uint32_t fake_seed = 1;
+
+/*********************
+ *   GLOBAL FUNCTIONS
+ *********************/
+
+void srf02_init(srf02_t * sensor, const srf02_bus_t * bus, uint8_t addr)
+{
+    sensor->bus = bus;
+    sensor->addr = addr;
+    sensor->state = SRF02_STATE_IDLE;
+    sensor->single_shot = false;
+    sensor->period = 0;
+    sensor->last_trigger = 0;
+}
+
+void srf02_request(srf02_t * sensor)
+{
+    __atomic_store_n(&sensor->single_shot, true, __ATOMIC_RELAXED);
+}
+
+void srf02_set_period(srf02_t * sensor, uint32_t period)
+{
+    __atomic_store_n(&sensor->period, period, __ATOMIC_RELAXED);
+}
+
+srf02_res_t srf02_poll(srf02_t * sensor, uint32_t now, int32_t * distance)
+{
+    switch(sensor->state) {
+        case SRF02_STATE_IDLE: {
+                /*Set by an other task: a request made meanwhile is kept for the next poll, not cleared*/
+                uint32_t period = __atomic_load_n(&sensor->period, __ATOMIC_RELAXED);
+                bool periodic_due = period && now - sensor->last_trigger >= period;
+                bool single_shot = __atomic_exchange_n(&sensor->single_shot, false, __ATOMIC_RELAXED);
+                if(!single_shot && !periodic_due) return SRF02_RES_NONE;
+
+                if(!trigger(sensor, now)) return SRF02_RES_ERROR;
+                return SRF02_RES_NONE;
+            }
+
+        case SRF02_STATE_RANGING: {
+                if(now - sensor->last_trigger < SRF02_RANGING_TIME_MS) return SRF02_RES_NONE;
+
+                sensor->state = SRF02_STATE_IDLE;
+
+                uint8_t buf[2];
+                if(!sensor->bus->read_regs(sensor->addr, REG_RANGE_HIGH, buf, 2, sensor->bus->user_data)) {
+                    return SRF02_RES_ERROR;
+                }
+
+                *distance = (buf[0] << 8) | buf[1];
+                return SRF02_RES_SAMPLE;
+            }
+    }
+
+    return SRF02_RES_NONE;
+}
+
+const srf02_bus_t * srf02_fake_bus(void)
+{
+    return &fake_bus;
+}
+
+void srf02_fake_set_time(uint32_t now)
+{
+    fake_now = now;
+}
+
+/*********************
+ *   STATIC FUNCTIONS
+ *********************/
+
+static bool trigger(srf02_t * sensor, uint32_t now)
+{
+    sensor->last_trigger = now;
+
+    if(!sensor->bus->write_reg(sensor->addr, REG_COMMAND, CMD_RANGE_CM, sensor->bus->user_data)) {
+        return false;
+    }
+
+    sensor->state = SRF02_STATE_RANGING;
+    return true;
+}
+
+static bool fake_write_reg(uint8_t addr, uint8_t reg, uint8_t value, void * user_data)
+{
+    (void)user_data;
+
+    if(addr != SRF02_DEFAULT_ADDRESS) return false;
+    if(fake_ranging && fake_now - fake_ranging_start < SRF02_RANGING_TIME_MS - 5) return false;
+
+    if(reg == REG_COMMAND && value == CMD_RANGE_CM) {
+        /*A slow triangle between 20 and 300 cm over 20 s with +-3 cm of noise*/
+        uint32_t t = fake_now % 20000;
+        int32_t range = t < 10000 ? 20 + (int32_t)(t * 280 / 10000) : 300 - (int32_t)((t - 10000) * 280 / 10000);
+        fake_seed = fake_seed * 1103515245 + 12345;
+        range += (int32_t)((fake_seed >> 16) % 7) - 3;
+
+        fake_range = (uint16_t)range;
+        fake_ranging = true;
+        fake_ranging_start = fake_now;
+    }
+
+    return true;
+}
+
+static bool fake_read_regs(uint8_t addr, uint8_t reg, uint8_t * buf, uint8_t len, void * user_data)
+{
+    (void)user_data;
+
+    if(addr != SRF02_DEFAULT_ADDRESS) return false;
+
+    /*The SRF02 doesn't respond on the bus while ranging*/
+    if(fake_ranging && fake_now - fake_ranging_start < SRF02_RANGING_TIME_MS - 5) return false;
+    fake_ranging = false;
+
+    uint8_t i;
+    for(i = 0; i < len; i++) {
+        uint8_t r = reg + i;
+        if(r == REG_RANGE_HIGH) buf[i] = fake_range >> 8;
+        else if(r == REG_RANGE_HIGH + 1) buf[i] = fake_range & 0xFF;
+        else buf[i] = 0;
+    }
+
+    return true;
+}
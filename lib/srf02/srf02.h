@@ -0,0 +1,106 @@
+#ifndef SRF02_H
+#define SRF02_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define SRF02_DEFAULT_ADDRESS 0x70
+
+/** The datasheet gives 65 ms for a ranging, keep a little margin */
+#define SRF02_RANGING_TIME_MS 70
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+/**
+ * I2C access used by the driver. Both return false if the device didn't acknowledge.
+ */
+typedef struct {
+    bool (*write_reg)(uint8_t addr, uint8_t reg, uint8_t value, void * user_data);
+    bool (*read_regs)(uint8_t addr, uint8_t reg, uint8_t * buf, uint8_t len, void * user_data);
+    void * user_data;
+} srf02_bus_t;
+
+typedef enum {
+    SRF02_STATE_IDLE,
+    SRF02_STATE_RANGING,
+} srf02_state_t;
+
+typedef enum {
+    SRF02_RES_NONE,     /**< Nothing new, call again later */
+    SRF02_RES_SAMPLE,   /**< A new distance is available */
+    SRF02_RES_ERROR,    /**< The device didn't answer */
+} srf02_res_t;
+
+typedef struct {
+    const srf02_bus_t * bus;
+    uint8_t addr;
+    srf02_state_t state;
+    bool single_shot;       /**< Written by `srf02_request` from any task, accessed atomically */
+    uint32_t period;        /**< Written by `srf02_set_period` from any task, accessed atomically */
+    uint32_t last_trigger;
+} srf02_t;
+
+/*********************
+ * GLOBAL PROTOTYPES
+ *********************/
+
+/**
+ * Initialize a sensor
+ * @param sensor    the sensor to initialize
+ * @param bus       I2C access
+ * @param addr      7 bit I2C address of the sensor
+ */
+void srf02_init(srf02_t * sensor, const srf02_bus_t * bus, uint8_t addr);
+
+/**
+ * Request one measurement. It's started by the next `srf02_poll`.
+ * Can be called from an other task than `srf02_poll`.
+ * @param sensor    pointer to a sensor
+ */
+void srf02_request(srf02_t * sensor);
+
+/**
+ * Measure continuously. Can be called from an other task than `srf02_poll`.
+ * @param sensor    pointer to a sensor
+ * @param period    time between two triggers in ms, 0 to stop
+ */
+void srf02_set_period(srf02_t * sensor, uint32_t period);
+
+/**
+ * Advance the state machine. Never waits: it triggers a ranging if one is due,
+ * or reads the result once the ranging time elapsed.
+ * @param sensor    pointer to a sensor
+ * @param now       current time in ms
+ * @param distance  store the distance in cm here on `SRF02_RES_SAMPLE`
+ * @return          SRF02_RES_NONE/SAMPLE/ERROR
+ */
+srf02_res_t srf02_poll(srf02_t * sensor, uint32_t now, int32_t * distance);
+
+/**
+ * A fake SRF02 for the emulator: it ignores the bus while ranging like the real one
+ * and answers a distance following a slow triangle between 20 and 300 cm with some noise.
+ * @return          I2C access to the fake device
+ */
+const srf02_bus_t * srf02_fake_bus(void);
+
+/**
+ * Advance the fake device's clock. Call it before `srf02_poll` with the same time.
+ * @param now       current time in ms
+ */
+void srf02_fake_set_time(uint32_t now);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*SRF02_H*/
@@ -0,0 +1,57 @@
+#include "uiTiming.h"
+
+static void log_timer_cb(lv_timer_t * t);
+
+static const uint32_t bucket_limits[UI_TIMING_BUCKET_CNT - 1] = UI_TIMING_BUCKETS;
+static ui_timing_hist_t hist;
+
+uint32_t ui_timing_timer_handler(void)
+{
+    uint32_t start = lv_tick_get();
+    uint32_t time_till_next = lv_timer_handler();
+    uint32_t elapsed = lv_tick_elaps(start);
+
+    uint32_t i;
+    for(i = 0; i < UI_TIMING_BUCKET_CNT - 1; i++) {
+        if(elapsed < bucket_limits[i]) break;
+    }
+
+    hist.count[i]++;
+    hist.total++;
+    if(elapsed > hist.max) hist.max = elapsed;
+
+    return time_till_next;
+}
+
+void ui_timing_get(ui_timing_hist_t * h)
+{
+    *h = hist;
+}
+
+void ui_timing_reset(void)
+{
+    lv_memzero(&hist, sizeof(hist));
+}
+
+void ui_timing_log(void)
+{
+    uint32_t i;
+    LV_LOG_USER("lv_timer_handler duration over %u calls, max %u ms:", (unsigned)hist.total, (unsigned)hist.max);
+    for(i = 0; i < UI_TIMING_BUCKET_CNT - 1; i++) {
+        LV_LOG_USER("  < %3u ms: %u", (unsigned)bucket_limits[i], (unsigned)hist.count[i]);
+    }
+    LV_LOG_USER(" >= %3u ms: %u", (unsigned)bucket_limits[UI_TIMING_BUCKET_CNT - 2],
+                (unsigned)hist.count[UI_TIMING_BUCKET_CNT - 1]);
+}
+
+void ui_timing_log_every(uint32_t period)
+{
+    lv_timer_create(log_timer_cb, period, NULL);
+}
+
+static void log_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    ui_timing_log();
+    ui_timing_reset();
+}
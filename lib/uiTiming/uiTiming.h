@@ -0,0 +1,53 @@
+#ifndef UI_TIMING_H
+#define UI_TIMING_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Upper bounds of the histogram buckets in ms, the last bucket takes everything above */
+#define UI_TIMING_BUCKETS {1, 2, 5, 10, 20, 50, 100}
+#define UI_TIMING_BUCKET_CNT 8
+
+typedef struct {
+    uint32_t count[UI_TIMING_BUCKET_CNT];
+    uint32_t max;
+    uint32_t total;
+} ui_timing_hist_t;
+
+/**
+ * Call `lv_timer_handler` and add its duration to the histogram.
+ * Anything blocking the UI thread (a sensor read, a long redraw) shows up here.
+ * @return          the return value of `lv_timer_handler`
+ */
+uint32_t ui_timing_timer_handler(void);
+
+/**
+ * Get the histogram
+ * @param hist      store the histogram here
+ */
+void ui_timing_get(ui_timing_hist_t * hist);
+
+/**
+ * Clear the histogram
+ */
+void ui_timing_reset(void);
+
+/**
+ * Print the histogram with LV_LOG_USER
+ */
+void ui_timing_log(void);
+
+/**
+ * Print and clear the histogram periodically
+ * @param period    time between two prints in ms
+ */
+void ui_timing_log_every(uint32_t period);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*UI_TIMING_H*/
@@ -1,49 +1,87 @@
 #include "lvgl.h"          // Bibliothèque graphique LVGL
-#include <Wire.h>          // Communication I2C
+#include "srf02.h"         // Machine d'états non bloquante du capteur SRF02
+#include "sampleRing.h"    // File circulaire d'échantillons horodatés, sans verrou
+#include "sampleStats.h"   // Filtrage des échantillons (rejet des aberrations, médiane, Welford)
+#include <stdio.h>         // snprintf
 #include <string.h>        // Fonctions pour manipuler les chaînes de caractères
 
-#define SFR02_ADDRESS 0x70 // Adresse I2C du capteur SFR02
-#define MAX_HISTORY_SIZE 10 // Nombre maximal de mesures sauvegardées
+#define MAX_HISTORY_SIZE 4096 // Nombre maximal de mesures sauvegardées (puissance de 2)
+#define HISTORY_VISIBLE 10    // Nombre de mesures affichées
+#define ACQ_RING_SIZE 16      // Échantillons en attente entre la tâche d'acquisition et l'interface
+#define DISTANCE_NONE INT32_MIN // Valeur initiale de distance_subject, avant la première mesure
+#define MEDIAN_SIZE 5         // Fenêtre de la médiane
+#define REJECT_SIZE 8         // Fenêtre du rejet des aberrations
+#define REJECT_K 3            // Écart toléré en écarts-types
+#define REJECT_MIN_DEV 4      // Écart toujours toléré (cm)
+#define MEASURE_PERIOD 500  // Période de la mesure continue (ms)
 
 // Déclarations des objets LVGL utilisés pour l'interface
 static lv_obj_t* label_distance;
 static lv_obj_t* label_valeur1;
 static lv_obj_t* label_valeur2;
 static lv_obj_t* label_surface;
-static lv_timer_t* measure_timer = NULL; // Timer pour les mesures continues
+
+// Capteur et dernière distance filtrée publiée (-1 : erreur I2C, DISTANCE_NONE : aucune mesure)
+// La tâche d'acquisition pousse ses échantillons bruts dans acq_ring sans verrou,
+// l'interface les vide, les filtre et publie le résultat via distance_subject
+static srf02_t sensor;
+static sample_t acq_buf[ACQ_RING_SIZE];
+static sample_ring_t acq_ring;
+static sample_filter_t distance_filter;
+static lv_subject_t distance_subject;
+
+// Change le texte d'un label seulement s'il est différent : évite de redessiner pour rien
+static void label_set_text_if_changed(lv_obj_t * label, const char * text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
 
 // Variables pour stockage des mesures
 static int last_measured_distance = -1;
-static int distance_history[MAX_HISTORY_SIZE];
-static int history_index = 0;
-static lv_obj_t* history_list_label;
-
-// Met à jour l'affichage de l'historique des mesures
-static void update_history_display(void) {
-    char history_buf[MAX_HISTORY_SIZE * 15 + 50];
-    strcpy(history_buf, "Mesures enregistrees :\n");
-
-    for (int i = 0; i < history_index; i++) {
-        char temp_buf[20];
-        snprintf(temp_buf, sizeof(temp_buf), "%d cm\n", distance_history[i]);
-        strcat(history_buf, temp_buf);
+static uint32_t last_measured_time;
+static sample_t history_buf[MAX_HISTORY_SIZE];
+static sample_ring_t history;
+static lv_obj_t* history_title;
+static lv_obj_t* history_cont;
+
+// Met à jour le titre de l'historique (nombre de mesures)
+static void update_history_title(void) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "Mesures enregistrees (%u) :", (unsigned)sample_ring_count(&history));
+    lv_label_set_text(history_title, buf);
+}
+
+// Ajoute une mesure à l'affichage : seules les HISTORY_VISIBLE dernières ont une ligne.
+// Quand la fenêtre est pleine, la ligne la plus ancienne est réutilisée et passée en bas,
+// un seul label est donc modifié par mesure.
+// spread : écart type des échantillons acceptés depuis l'enregistrement précédent (cm)
+static void history_display_append(const sample_t * sample, float spread) {
+    lv_obj_t * row;
+    if (lv_obj_get_child_count(history_cont) < HISTORY_VISIBLE + 1) {
+        row = lv_label_create(history_cont);
+    } else {
+        row = lv_obj_get_child(history_cont, 1);
+        lv_obj_move_to_index(row, -1);
     }
-    lv_label_set_text(history_list_label, history_buf);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%d cm (+/- %.1f)", (int)sample->value, spread);
+    lv_label_set_text(row, buf);
+    update_history_title();
 }
 
 // Callback : enregistre la dernière distance mesurée dans l'historique
 static void save_distance_event_cb(lv_event_t * e) {
     if (last_measured_distance != -1) {
-        if (history_index < MAX_HISTORY_SIZE) {
-            distance_history[history_index++] = last_measured_distance;
-        } else {
-            // Décalage des valeurs pour faire de la place
-            for (int i = 0; i < MAX_HISTORY_SIZE - 1; i++) {
-                distance_history[i] = distance_history[i+1];
-            }
-            distance_history[MAX_HISTORY_SIZE - 1] = last_measured_distance;
+        sample_t sample = { last_measured_time, last_measured_distance };
+        // Historique plein : on oublie la plus ancienne mesure, sans décalage
+        if (!sample_ring_push(&history, &sample)) {
+            sample_ring_pop(&history, NULL);
+            sample_ring_push(&history, &sample);
         }
-        update_history_display(); // Rafraîchit l'affichage
+        // Dispersion des échantillons depuis le dernier enregistrement, puis on repart de zéro
+        history_display_append(&sample, welford_stddev(sample_filter_get_stats(&distance_filter))); // Rafraîchit l'affichage
+        sample_filter_reset_stats(&distance_filter);
     }
 }
 
@@ -56,13 +94,13 @@ static void valeur1(lv_event_t * e){
     char buf[32];
     val1 = last_measured_distance;
     snprintf(buf, sizeof(buf), "valeur1 : %d cm", val1);
-    lv_label_set_text(label_valeur1, buf);
+    label_set_text_if_changed(label_valeur1, buf);
 
     // Calcule la surface si val2 est déjà défini
     if(val2 != 0){
         surface = ((val1/100.0f)*(val2/100.0f));
         snprintf(buf, sizeof(buf), "surface : %.2f m2", surface);
-        lv_label_set_text(label_surface, buf);
+        label_set_text_if_changed(label_surface, buf);
     }
 }
 
@@ -71,56 +109,68 @@ static void valeur2(lv_event_t * e){
     char buf[32];
     val2 = last_measured_distance;
     snprintf(buf, sizeof(buf), "valeur2 : %d cm", val2);
-    lv_label_set_text(label_valeur2, buf);
+    label_set_text_if_changed(label_valeur2, buf);
 
     // Calcule la surface si val1 est déjà défini
     if(val1 != 0){
         surface = ((val1/100.0f)*(val2/100.0f));
         snprintf(buf, sizeof(buf), "surface : %.2f m2", surface);
-        lv_label_set_text(label_surface, buf);
+        label_set_text_if_changed(label_surface, buf);
     }
 }
 
 // Callback : réinitialise l'historique des mesures
 static void clear_history_event_cb(lv_event_t * e) {
-    history_index = 0;
-    for (int i = 0; i < MAX_HISTORY_SIZE; i++) {
-        distance_history[i] = 0;
+    sample_ring_clear(&history);
+    // On garde le titre (premier enfant), on supprime les lignes
+    while (lv_obj_get_child_count(history_cont) > 1) {
+        lv_obj_delete(lv_obj_get_child(history_cont, -1));
     }
-    update_history_display();
+    update_history_title();
 }
 
-// Fonction de mesure de la distance via le capteur SFR02
-static void measure_distance(lv_timer_t * timer)
+// Observateur : affiche chaque distance publiée par la tâche d'acquisition
+static void distance_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
 {
-    // Envoi de la commande de mesure (0x51)
-    Wire.beginTransmission(SFR02_ADDRESS);
-    Wire.write(0x00);
-    Wire.write(0x51);
-    Wire.endTransmission();
-
-    delay(70); // Attente du résultat de la mesure
-
-    // Lecture du résultat (2 octets)
-    Wire.beginTransmission(SFR02_ADDRESS);
-    Wire.write(0x02); // Registre de lecture
-    Wire.endTransmission(false);
-
-    Wire.requestFrom(SFR02_ADDRESS, 2);
-    if (Wire.available() == 2) {
-        uint8_t highByte = Wire.read();
-        uint8_t lowByte = Wire.read();
-        int distance_cm = (highByte << 8) | lowByte;
-
-        last_measured_distance = distance_cm;
+    int32_t distance_cm = lv_subject_get_int(subject);
+    if (distance_cm == DISTANCE_NONE) return; // Pas encore de mesure
+    last_measured_distance = distance_cm;
 
+    if (distance_cm >= 0) {
         char buf[32];
-        snprintf(buf, sizeof(buf), "Distance : %d cm", distance_cm);
-        lv_label_set_text(label_distance, buf);
+        snprintf(buf, sizeof(buf), "Distance : %d cm", (int)distance_cm);
+        label_set_text_if_changed(label_distance, buf);
     } else {
         // Erreur de communication I2C
-        lv_label_set_text(label_distance, "Erreur I2C !");
-        last_measured_distance = -1;
+        label_set_text_if_changed(label_distance, "Erreur I2C !");
+    }
+}
+
+// Fait avancer la machine d'états du capteur sans jamais attendre et pousse le résultat
+// Sur la carte : appelée par la tâche d'acquisition, sans toucher à LVGL
+static void sensor_poll(uint32_t now)
+{
+    int32_t distance_cm;
+    srf02_res_t res = srf02_poll(&sensor, now, &distance_cm);
+    if (res == SRF02_RES_NONE) return;
+
+    sample_t sample = { now, res == SRF02_RES_SAMPLE ? distance_cm : -1 };
+    sample_ring_push(&acq_ring, &sample); // File pleine : l'interface est en retard, on perd l'échantillon
+}
+
+// Timer de l'interface : filtre et publie les échantillons reçus de la tâche d'acquisition
+// Un écho aberrant est rejeté et ne change pas la distance affichée
+static void sensor_drain_cb(lv_timer_t * timer)
+{
+    sample_t sample;
+    while (sample_ring_pop(&acq_ring, &sample)) {
+        int32_t filtered = -1;
+        if (sample.value >= 0 && !sample_filter_add(&distance_filter, sample.value, &filtered)) continue;
+
+        last_measured_time = sample.timestamp;
+        if (filtered != lv_subject_get_int(&distance_subject)) {
+            lv_subject_set_int(&distance_subject, filtered);
+        }
     }
 }
 
@@ -133,23 +183,13 @@ static void event_handler(lv_event_t * e)
     if(code == LV_EVENT_CLICKED) {
         // Si bouton de mesure cliqué -> effectuer une mesure
         if (obj == lv_obj_get_child(lv_obj_get_parent(label_distance), 0)) {
-            measure_distance(NULL);
+            srf02_request(&sensor);
         }
     }
     else if(code == LV_EVENT_VALUE_CHANGED) {
         // Démarrage/arrêt de la mesure continue
         bool toggled = lv_obj_has_state(obj, LV_STATE_CHECKED);
-
-        if(toggled) {
-            if(measure_timer == NULL) {
-                measure_timer = lv_timer_create(measure_distance, 500, NULL); // toutes les 500ms
-            }
-        } else {
-            if(measure_timer) {
-                lv_timer_del(measure_timer);
-                measure_timer = NULL;
-            }
-        }
+        srf02_set_period(&sensor, toggled ? MEASURE_PERIOD : 0);
     }
 }
 
@@ -179,15 +219,21 @@ void testLvgl()
     label_distance = lv_label_create(lv_scr_act());
     lv_label_set_text(label_distance,"Distance : ---");
     lv_obj_align(label_distance, LV_ALIGN_CENTER, 0, 0);
-
-    // Affichage de l'historique
-    history_list_label = lv_label_create(lv_scr_act());
-    lv_label_set_text(history_list_label, "Mesures enregistrees:\n");
-    lv_obj_set_width(history_list_label, LV_SIZE_CONTENT);
-    lv_obj_set_height(history_list_label, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(history_list_label, LV_LABEL_LONG_WRAP);
-    lv_obj_align(history_list_label, LV_ALIGN_TOP_RIGHT, -10, 5);
-    update_history_display();
+    lv_subject_init_int(&distance_subject, DISTANCE_NONE);
+    lv_subject_add_observer_obj(&distance_subject, distance_observer_cb, label_distance, NULL);
+    sample_ring_init(&acq_ring, acq_buf, ACQ_RING_SIZE);
+    sample_filter_init(&distance_filter, MEDIAN_SIZE, REJECT_SIZE, REJECT_K, REJECT_MIN_DEV);
+    lv_timer_create(sensor_drain_cb, 20, NULL);
+
+    // Affichage de l'historique : un titre puis une ligne par mesure visible
+    sample_ring_init(&history, history_buf, MAX_HISTORY_SIZE);
+    history_cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(history_cont);
+    lv_obj_set_size(history_cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(history_cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_align(history_cont, LV_ALIGN_TOP_RIGHT, -10, 5);
+    history_title = lv_label_create(history_cont);
+    update_history_title();
 
     // Bouton "Enregistrer"
     lv_obj_t * btn_save = lv_button_create(lv_scr_act());
@@ -238,12 +284,42 @@ void testLvgl()
 #ifdef ARDUINO
 
 #include "lvglDrivers.h"
+#include <Wire.h>          // Communication I2C
+
+// Accès I2C au SRF02 via Wire, utilisé uniquement par la tâche d'acquisition
+static bool wire_write_reg(uint8_t addr, uint8_t reg, uint8_t value, void *user_data)
+{
+    Wire.beginTransmission(addr);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+static bool wire_read_regs(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len, void *user_data)
+{
+    Wire.beginTransmission(addr);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0) return false;
+
+    if (Wire.requestFrom(addr, len) != len) return false;
+    for (uint8_t i = 0; i < len; i++) {
+        buf[i] = Wire.read();
+    }
+    return true;
+}
+
+static const srf02_bus_t wire_bus = {
+    wire_write_reg,
+    wire_read_regs,
+    NULL,
+};
 
 // Setup Arduino
 void mySetup()
 {
     Serial.begin(115200);
     Wire.begin();      // Initialisation I2C
+    srf02_init(&sensor, &wire_bus, SRF02_DEFAULT_ADDRESS);
     testLvgl();        // Création de l'interface
 }
 
@@ -253,12 +329,13 @@ void loop() {
 
 void myTask(void *pvParameters)
 {
-    // Tâche périodique (non utilisée ici)
+    // Tâche d'acquisition : interroge le capteur toutes les 5 ms sans bloquer l'affichage
     TickType_t xLastWakeTime;
     xLastWakeTime = xTaskGetTickCount();
     while (1)
     {
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(200));
+        sensor_poll(xTaskGetTickCount());
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(5));
     }
 }
 
@@ -267,6 +344,100 @@ void myTask(void *pvParameters)
 #include "lvgl.h"
 #include "app_hal.h"
 #include <cstdio>
+#include <cstdlib>
+
+#ifdef EMULATOR_BENCHMARK
+#include "demos/benchmark/lv_demo_benchmark.h"
+#include "drawBench.h"
+
+// Fin du benchmark : le résumé CSV est déjà affiché, on quitte pour les exécutions scriptées
+static void benchmark_end_cb(void)
+{
+    fflush(stdout);
+    exit(0);
+}
+
+// Fin des scènes de demos/benchmark : on ajoute les compteurs des caches de glyphes (multiple_labels, screen_sized_text)
+// et de dégradés (widgets_demo)
+static void benchmark_scenes_end_cb(void)
+{
+    draw_bench_glyph_cache_log();
+    draw_bench_gradient_cache_log();
+    benchmark_end_cb();
+}
+
+// Relit une trace enregistrée avec MEM_TRACE et la rejoue avec des tas de plusieurs tailles
+static void mem_trace_replay(const char * path)
+{
+    FILE * f = fopen(path, "r");
+    if(f == NULL) {
+        printf("Impossible d'ouvrir %s\n", path);
+        return;
+    }
+
+    lv_mem_track_event_t * events = NULL;
+    uint32_t event_cnt = 0;
+    uint32_t event_size = 0;
+    char op;
+    unsigned id, size, tag;
+    while(fscanf(f, " %c %u %u %u", &op, &id, &size, &tag) == 4) {
+        if(event_cnt == event_size) {
+            event_size = event_size ? event_size * 2 : 4096;
+            lv_mem_track_event_t * new_events = (lv_mem_track_event_t *)realloc(events, event_size * sizeof(lv_mem_track_event_t));
+            if(new_events == NULL) break;
+            events = new_events;
+        }
+        lv_mem_track_event_t * e = &events[event_cnt++];
+        e->op = op == 'a' ? LV_MEM_TRACK_OP_ALLOC : op == 'f' ? LV_MEM_TRACK_OP_FREE : LV_MEM_TRACK_OP_REALLOC;
+        e->id = id;
+        e->size = size;
+        e->tag = (uint8_t)tag;
+    }
+    fclose(f);
+
+    draw_bench_mem_replay_log(events, event_cnt);
+    free(events);
+}
+#endif
+
+#if LV_MEM_TRACK
+// Une ligne par événement de la trace : "a|f|r <id> <taille> <tag>", relue par BENCH_MEM_REPLAY
+static void mem_trace_cb(const lv_mem_track_event_t * event, void * user_data)
+{
+    fprintf((FILE *)user_data, "%c %u %u %u\n", "afr"[event->op], (unsigned)event->id, (unsigned)event->size,
+            (unsigned)event->tag);
+}
+
+// La trace est écrite sur le disque chaque seconde pour garder l'essentiel si le simulateur est tué
+static void mem_trace_flush_cb(lv_timer_t * timer)
+{
+    fflush((FILE *)lv_timer_get_user_data(timer));
+}
+
+static void mem_trace_start(const char * path)
+{
+    FILE * f = fopen(path, "w");
+    if(f == NULL) {
+        printf("Impossible de créer %s\n", path);
+        return;
+    }
+    lv_mem_track_set_trace_cb(mem_trace_cb, f);
+    lv_timer_create(mem_trace_flush_cb, 1000, f);
+}
+
+static void mem_dump_timer_cb(lv_timer_t * timer)
+{
+    lv_mem_track_dump();
+}
+#endif
+
+// Sur le simulateur, un faux SRF02 est interrogé depuis un timer : le sondage ne bloque jamais
+static void sensor_timer_cb(lv_timer_t * timer)
+{
+    uint32_t now = lv_tick_get();
+    srf02_fake_set_time(now);
+    sensor_poll(now);
+}
 
 // Main pour simulateur PC
 int main(void)
@@ -277,7 +448,120 @@ int main(void)
     lv_init();      // Initialisation LVGL
     hal_setup();    // Initialisation matérielle simulée
 
+#if LV_MEM_TRACK
+    // MEM_TRACE=<fichier> : enregistre les allocations de LVGL pour les rejouer avec BENCH_MEM_REPLAY
+    if(getenv("MEM_TRACE")) mem_trace_start(getenv("MEM_TRACE"));
+    // MEM_DUMP=<s> : affiche toutes les <s> secondes l'occupation du tas par sous-système et sa carte
+    if(getenv("MEM_DUMP")) lv_timer_create(mem_dump_timer_cb, atoi(getenv("MEM_DUMP")) * 1000, NULL);
+#endif
+
+#ifdef EMULATOR_BENCHMARK
+    // BENCH_DISPATCH : mesure seulement le coût de la file des tâches de dessin puis quitte
+    if(getenv("BENCH_DISPATCH")) {
+        draw_bench_dispatch_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_INV : compare les pixels invalidés et les pixels redessinés (défilement, étiquettes) puis quitte
+    if(getenv("BENCH_INV")) {
+        draw_bench_inv_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_BLEND : vérifie les noyaux SIMD de mélange contre le code C et compare leurs débits puis quitte
+    if(getenv("BENCH_BLEND")) {
+        draw_bench_blend_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_TEXT : mesure la mise en page d'un long texte (recherche des glyphes et du crénage) puis quitte
+    if(getenv("BENCH_TEXT")) {
+        draw_bench_text_layout_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_SHADOW : redessine des cartes avec des ombres d'une ou de plusieurs largeurs (cache des coins) puis quitte
+    if(getenv("BENCH_SHADOW")) {
+        draw_bench_shadow_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_RADIUS : redessine des boutons arrondis avec un ou plusieurs rayons (cache des cercles) puis quitte
+    if(getenv("BENCH_RADIUS")) {
+        draw_bench_radius_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_STYLE : redessine des boutons très stylés avec et sans le cache des propriétés de style résolues puis quitte
+    if(getenv("BENCH_STYLE")) {
+        draw_bench_style_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_PROPS : mesure la recherche des propriétés dans des styles de différentes tailles puis quitte
+    if(getenv("BENCH_PROPS")) {
+        draw_bench_style_props_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_TIMER : mesure lv_timer_handler() avec 10, 100 et 1000 timers puis quitte
+    if(getenv("BENCH_TIMER")) {
+        draw_bench_timer_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_ANIM : mesure lv_anim_refr_now() avec 50 et 500 animations simultanées puis quitte
+    if(getenv("BENCH_ANIM")) {
+        draw_bench_anim_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_MEM : mesure lv_malloc/lv_free depuis 1, 2 et 4 threads avec et sans caches par thread puis quitte
+    if(getenv("BENCH_MEM")) {
+        draw_bench_mem_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_MEM_REPLAY=<fichier> : rejoue une trace de MEM_TRACE avec des tas TLSF de 64 à 256 Ko et malloc puis quitte
+    if(getenv("BENCH_MEM_REPLAY")) {
+        mem_trace_replay(getenv("BENCH_MEM_REPLAY"));
+        benchmark_end_cb();
+    }
+
+    // BENCH_HEAPS : place des petits blocs et des buffers de dessin dans le tas rapide seul puis avec un tas
+    // de masse de 256 Ko et de 1 Mo (SRAM interne et SDRAM simulées) puis quitte
+    // Une règle de placement non respectée fait échouer l'exécution (code de sortie 1)
+    if(getenv("BENCH_HEAPS")) {
+        if(draw_bench_heaps_log() != 0) {
+            fflush(stdout);
+            exit(1);
+        }
+        benchmark_end_cb();
+    }
+
+    // BENCH_IMAGE_CACHE : grille d'images décodées avec un cache de 25 %, 50 % et 100 % des images,
+    // éviction LRU puis GreedyDual-Size (temps de décodage par octet), puis quitte
+    if(getenv("BENCH_IMAGE_CACHE")) {
+        draw_bench_image_cache_log();
+        benchmark_end_cb();
+    }
+
+    // BENCH_IMAGE_ASYNC : défilement d'une galerie de PNG, images décodées pendant le dessin puis dans un thread
+    // (espace réservé en attendant), percentiles du temps de trame, puis quitte
+    if(getenv("BENCH_IMAGE_ASYNC")) {
+        draw_bench_image_async_log();
+        benchmark_end_cb();
+    }
+
+    // Scènes de demos/benchmark à la place de l'application, BENCH_SCENES permet d'en choisir
+    lv_demo_benchmark_set_scenes(getenv("BENCH_SCENES"));
+    lv_demo_benchmark_set_end_cb(benchmark_scenes_end_cb);
+    lv_demo_benchmark();
+#else
+    srf02_init(&sensor, srf02_fake_bus(), SRF02_DEFAULT_ADDRESS);
     testLvgl();     // Création de l'interface
+    lv_timer_create(sensor_timer_cb, 5, NULL);
+#endif
 
     hal_loop();     // Boucle principale
     return 0;
@@ -0,0 +1,49 @@
+# Draw unit scaling benchmark of the emulator.
+# Builds the emulator_benchmark env with 1, 2, 4 and 8 software draw units,
+# runs the demos/benchmark scenes headless and prints the render time of each scene.
+#
+#   python support/bench_draw_units.py [scenes] [units...]
+#   python support/bench_draw_units.py "moving_wallpaper,screen_sized_text" 1 4
+#
+# Set BENCH_SPLIT_MIN_AREA (e.g. 10000) to also split large draw tasks into bands
+# rendered by all the idle draw units (LV_DRAW_SW_SPLIT_MIN_AREA).
+import os
+import subprocess
+import sys
+
+ENV = "emulator_benchmark"
+PROGRAM = os.path.join(".pio", "build", ENV, "program.exe" if sys.platform.startswith("win") else "program")
+
+scenes = sys.argv[1] if len(sys.argv) > 1 else ""
+units_list = [int(u) for u in sys.argv[2:]] or [1, 2, 4, 8]
+split_min_area = int(os.environ.get("BENCH_SPLIT_MIN_AREA", "0"))
+
+results = {}    # scene -> {units: render time}
+for units in units_list:
+    build_env = dict(os.environ)
+    build_env["PLATFORMIO_BUILD_FLAGS"] = "-D LV_DRAW_SW_DRAW_UNIT_CNT={} -D LV_DRAW_SW_SPLIT_MIN_AREA={}".format(
+        units, split_min_area)
+    subprocess.run(["pio", "run", "-e", ENV], env=build_env, check=True, stdout=subprocess.DEVNULL)
+
+    run_env = dict(os.environ)
+    run_env["BENCH_SCENES"] = scenes
+    run_env.setdefault("SDL_VIDEODRIVER", "dummy")
+    out = subprocess.run([PROGRAM], env=run_env, check=True, capture_output=True, text=True).stdout
+
+    # CSV after "Benchmark Summary": name, CPU, FPS, time, render time, flush time
+    summary = out[out.find("Benchmark Summary"):].splitlines()[2:]
+    for line in summary:
+        cols = [c.strip() for c in line.split(",")]
+        if len(cols) != 6:
+            continue
+        results.setdefault(cols[0], {})[units] = int(cols[4])
+
+print("Render time [ms] per frame" + (", tasks from {} px split".format(split_min_area) if split_min_area else ""))
+print("{:<28}".format("Scene") + "".join("{:>8}".format("{} unit".format(u)) for u in units_list) + "  speedup")
+for scene, times in results.items():
+    row = "{:<28}".format(scene) + "".join("{:>8}".format(times.get(u, "-")) for u in units_list)
+    first = times.get(units_list[0])
+    last = times.get(units_list[-1])
+    if first and last:
+        row += "  x{:.2f}".format(first / last)
+    print(row)
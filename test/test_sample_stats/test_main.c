@@ -0,0 +1,198 @@
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include "sampleStats.h"
+
+#define TRACE_LEN 2000
+
+// Bruit pseudo-aléatoire reproductible dans [-amp, amp]
+static uint32_t seed;
+
+static int32_t noise(int32_t amp)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int32_t)((seed >> 8) % (uint32_t)(2 * amp + 1)) - amp;
+}
+
+static int cmp_int32(const void * a, const void * b)
+{
+    int32_t va = *(const int32_t *)a;
+    int32_t vb = *(const int32_t *)b;
+    return va < vb ? -1 : va > vb;
+}
+
+void setUp(void)
+{
+    seed = 12345;
+}
+
+void tearDown(void)
+{
+}
+
+// Welford contre la moyenne et la variance calculées en deux passes (double précision)
+static void test_welford_matches_two_pass(void)
+{
+    static float trace[TRACE_LEN];
+    welford_t w;
+    welford_reset(&w);
+    for (int i = 0; i < TRACE_LEN; i++) {
+        trace[i] = 150.0f + (float)noise(20) + (i > TRACE_LEN / 2 ? 30.0f : 0.0f);
+        welford_add(&w, trace[i]);
+    }
+
+    double mean = 0.0;
+    for (int i = 0; i < TRACE_LEN; i++) mean += trace[i];
+    mean /= TRACE_LEN;
+    double var = 0.0;
+    for (int i = 0; i < TRACE_LEN; i++) var += (trace[i] - mean) * (trace[i] - mean);
+    var /= TRACE_LEN - 1;
+
+    TEST_ASSERT_EQUAL_UINT32(TRACE_LEN, w.n);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, (float)mean, welford_mean(&w));
+    TEST_ASSERT_FLOAT_WITHIN((float)var * 1e-3f, (float)var, welford_variance(&w));
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, (float)sqrt(var), welford_stddev(&w));
+}
+
+// Moins de deux échantillons : variance nulle
+static void test_welford_few_samples(void)
+{
+    welford_t w;
+    welford_reset(&w);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, welford_mean(&w));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, welford_variance(&w));
+    welford_add(&w, 42.0f);
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, welford_mean(&w));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, welford_variance(&w));
+}
+
+// Médiane glissante contre le tri des derniers échantillons, pour toutes les tailles de fenêtre
+static void test_median_matches_sorted_window(void)
+{
+    static int32_t trace[TRACE_LEN];
+    for (int i = 0; i < TRACE_LEN; i++) trace[i] = 100 + noise(50);
+
+    for (uint32_t size = 1; size <= SAMPLE_STATS_WINDOW_MAX; size++) {
+        median_filter_t m;
+        median_filter_init(&m, size);
+        for (int i = 0; i < TRACE_LEN; i++) {
+            int32_t median = median_filter_add(&m, trace[i]);
+
+            int32_t window[SAMPLE_STATS_WINDOW_MAX];
+            uint32_t n = (uint32_t)i + 1 < size ? (uint32_t)i + 1 : size;
+            for (uint32_t j = 0; j < n; j++) window[j] = trace[i - j];
+            qsort(window, n, sizeof(int32_t), cmp_int32);
+            TEST_ASSERT_EQUAL_INT32(window[(n - 1) / 2], median);
+        }
+    }
+}
+
+// Un pic isolé ne change pas la médiane
+static void test_median_ignores_spike(void)
+{
+    median_filter_t m;
+    median_filter_init(&m, 5);
+    for (int i = 0; i < 5; i++) median_filter_add(&m, 200);
+    TEST_ASSERT_EQUAL_INT32(200, median_filter_add(&m, 3000));
+    TEST_ASSERT_EQUAL_INT32(200, median_filter_add(&m, 0));
+}
+
+// Trace bruitée avec des échos aberrants : les pics sont rejetés, le bruit est accepté
+static void test_outlier_rejects_spikes(void)
+{
+    outlier_rejector_t r;
+    outlier_rejector_init(&r, 8, 3, 4);
+
+    uint32_t spikes = 0;
+    uint32_t rejected_spikes = 0;
+    uint32_t rejected_noise = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        bool spike = i >= 8 && i % 37 == 0;
+        int32_t x = spike ? (i % 2 ? 600 : 20) : 200 + noise(2);
+        bool accepted = outlier_rejector_add(&r, x);
+        if (spike) {
+            spikes++;
+            if (!accepted) rejected_spikes++;
+        } else if (!accepted) {
+            rejected_noise++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(spikes, rejected_spikes);
+    TEST_ASSERT_EQUAL_UINT32(0, rejected_noise);
+}
+
+// Tant que la fenêtre n'est pas pleine, tout est accepté ; un signal constant tolère min_dev
+static void test_outlier_min_dev(void)
+{
+    outlier_rejector_t r;
+    outlier_rejector_init(&r, 4, 3, 4);
+    TEST_ASSERT_TRUE(outlier_rejector_add(&r, 100));
+    TEST_ASSERT_TRUE(outlier_rejector_add(&r, 900));
+    outlier_rejector_init(&r, 4, 3, 4);
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(outlier_rejector_add(&r, 100));
+    TEST_ASSERT_TRUE(outlier_rejector_add(&r, 104));
+    TEST_ASSERT_FALSE(outlier_rejector_add(&r, 110));
+}
+
+// Un vrai changement de distance : rejeté size - 1 fois, puis la fenêtre repart de la nouvelle valeur
+static void test_outlier_step_recovery(void)
+{
+    outlier_rejector_t r;
+    outlier_rejector_init(&r, 8, 3, 4);
+    for (int i = 0; i < 50; i++) TEST_ASSERT_TRUE(outlier_rejector_add(&r, 100 + noise(1)));
+
+    for (int i = 0; i < 7; i++) TEST_ASSERT_FALSE(outlier_rejector_add(&r, 300 + noise(1)));
+    TEST_ASSERT_TRUE(outlier_rejector_add(&r, 300 + noise(1)));
+    for (int i = 0; i < 50; i++) TEST_ASSERT_TRUE(outlier_rejector_add(&r, 300 + noise(1)));
+
+    // Retour à l'ancienne valeur : même délai
+    for (int i = 0; i < 7; i++) TEST_ASSERT_FALSE(outlier_rejector_add(&r, 100));
+    TEST_ASSERT_TRUE(outlier_rejector_add(&r, 100));
+}
+
+// Chaîne complète : la sortie reste près de la vraie distance malgré les pics, et suit un changement
+static void test_sample_filter_trace(void)
+{
+    sample_filter_t f;
+    sample_filter_init(&f, 5, 8, 3, 4);
+
+    uint32_t accepted = 0;
+    int32_t out = -1;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        int32_t truth = i < TRACE_LEN / 2 ? 150 : 250;
+        bool spike = i % 23 == 11;
+        int32_t x = spike ? truth * 3 : truth + noise(3);
+        if (!sample_filter_add(&f, x, &out)) continue;
+        accepted++;
+
+        // Hors de la transition, la médiane reste dans le bruit
+        if (i > 20 && (i < TRACE_LEN / 2 || i > TRACE_LEN / 2 + 20)) {
+            TEST_ASSERT_INT32_WITHIN(3, truth, out);
+        }
+    }
+
+    TEST_ASSERT_INT32_WITHIN(3, 250, out);
+    const welford_t * stats = sample_filter_get_stats(&f);
+    TEST_ASSERT_EQUAL_UINT32(accepted, stats->n);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 200.0f, welford_mean(stats));
+
+    sample_filter_reset_stats(&f);
+    TEST_ASSERT_EQUAL_UINT32(0, sample_filter_get_stats(&f)->n);
+    TEST_ASSERT_TRUE(sample_filter_add(&f, 251, &out));
+    TEST_ASSERT_INT32_WITHIN(3, 250, out);
+}
+
+int main(int argc, char ** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_welford_matches_two_pass);
+    RUN_TEST(test_welford_few_samples);
+    RUN_TEST(test_median_matches_sorted_window);
+    RUN_TEST(test_median_ignores_spike);
+    RUN_TEST(test_outlier_rejects_spikes);
+    RUN_TEST(test_outlier_min_dev);
+    RUN_TEST(test_outlier_step_recovery);
+    RUN_TEST(test_sample_filter_trace);
+    return UNITY_END();
+}
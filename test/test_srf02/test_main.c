@@ -0,0 +1,245 @@
+#include <unity.h>
+#include "srf02.h"
+
+// Bus simulé : enregistre les accès et peut refuser l'écriture ou la lecture (pas d'acquittement)
+typedef struct {
+    uint32_t writes;
+    uint32_t reads;
+    uint8_t last_write_reg;
+    uint8_t last_write_value;
+    uint8_t last_read_reg;
+    uint8_t last_read_len;
+    bool write_nak;
+    bool read_nak;
+    uint16_t range;
+} bus_log_t;
+
+static bus_log_t bus_log;
+
+static bool log_write_reg(uint8_t addr, uint8_t reg, uint8_t value, void * user_data)
+{
+    bus_log_t * log = (bus_log_t *)user_data;
+    TEST_ASSERT_EQUAL_HEX8(SRF02_DEFAULT_ADDRESS, addr);
+    log->writes++;
+    log->last_write_reg = reg;
+    log->last_write_value = value;
+    return !log->write_nak;
+}
+
+static bool log_read_regs(uint8_t addr, uint8_t reg, uint8_t * buf, uint8_t len, void * user_data)
+{
+    bus_log_t * log = (bus_log_t *)user_data;
+    TEST_ASSERT_EQUAL_HEX8(SRF02_DEFAULT_ADDRESS, addr);
+    log->reads++;
+    log->last_read_reg = reg;
+    log->last_read_len = len;
+    if (log->read_nak) return false;
+    buf[0] = log->range >> 8;
+    buf[1] = log->range & 0xFF;
+    return true;
+}
+
+static const srf02_bus_t log_bus = {
+    .write_reg = log_write_reg,
+    .read_regs = log_read_regs,
+    .user_data = &bus_log,
+};
+
+static srf02_t sensor;
+
+void setUp(void)
+{
+    bus_log = (bus_log_t){0};
+    bus_log.range = 0x0123;
+    srf02_init(&sensor, &log_bus, SRF02_DEFAULT_ADDRESS);
+}
+
+void tearDown(void)
+{
+}
+
+// Sans demande ni période, le capteur reste au repos et le bus n'est pas utilisé
+static void test_idle_without_request(void)
+{
+    int32_t distance = -1;
+    for (uint32_t t = 0; t < 1000; t += 5) {
+        TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, t, &distance));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, bus_log.writes);
+    TEST_ASSERT_EQUAL_UINT32(0, bus_log.reads);
+    TEST_ASSERT_EQUAL_INT32(-1, distance);
+}
+
+// Une demande envoie la commande 0x51, le résultat est lu une fois le temps de mesure écoulé
+static void test_request_reads_after_ranging_time(void)
+{
+    int32_t distance = -1;
+    srf02_request(&sensor);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, 1000, &distance));
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+    TEST_ASSERT_EQUAL_HEX8(0x00, bus_log.last_write_reg);
+    TEST_ASSERT_EQUAL_HEX8(0x51, bus_log.last_write_value);
+    TEST_ASSERT_EQUAL(SRF02_STATE_RANGING, sensor.state);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&sensor, 1000 + SRF02_RANGING_TIME_MS, &distance));
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.reads);
+    TEST_ASSERT_EQUAL_HEX8(0x02, bus_log.last_read_reg);
+    TEST_ASSERT_EQUAL_UINT8(2, bus_log.last_read_len);
+    TEST_ASSERT_EQUAL_INT32(0x0123, distance);
+    TEST_ASSERT_EQUAL(SRF02_STATE_IDLE, sensor.state);
+
+    // Une seule mesure par demande
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, 2000, &distance));
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+}
+
+// Pendant la mesure le SRF02 ne répond pas : aucune lecture avant la fin du temps de mesure
+static void test_no_read_before_ranging_ends(void)
+{
+    int32_t distance = -1;
+    srf02_request(&sensor);
+    srf02_poll(&sensor, 0, &distance);
+
+    for (uint32_t t = 0; t < SRF02_RANGING_TIME_MS; t++) {
+        TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, t, &distance));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, bus_log.reads);
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+    TEST_ASSERT_EQUAL_INT32(-1, distance);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&sensor, SRF02_RANGING_TIME_MS, &distance));
+}
+
+// Le temps de mesure est correct quand le compteur de ms repasse par 0
+static void test_ranging_time_across_tick_wrap(void)
+{
+    int32_t distance = -1;
+    uint32_t start = UINT32_MAX - 10;
+    srf02_request(&sensor);
+    srf02_poll(&sensor, start, &distance);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, start + SRF02_RANGING_TIME_MS - 1, &distance));
+    TEST_ASSERT_EQUAL_UINT32(0, bus_log.reads);
+    TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&sensor, start + SRF02_RANGING_TIME_MS, &distance));
+}
+
+// Mode continu : une mesure par période, la suivante n'est lancée qu'après la lecture
+static void test_periodic_triggers(void)
+{
+    int32_t distance = -1;
+    uint32_t samples = 0;
+    srf02_set_period(&sensor, 100);
+
+    for (uint32_t t = 0; t < 1000; t += 5) {
+        if (srf02_poll(&sensor, t, &distance) == SRF02_RES_SAMPLE) samples++;
+    }
+    // Déclenchements à 100, 200, ..., 900 ; la mesure lancée à 900 est lue à 970
+    TEST_ASSERT_EQUAL_UINT32(9, bus_log.writes);
+    TEST_ASSERT_EQUAL_UINT32(9, samples);
+
+    // Période 0 : arrêt
+    srf02_set_period(&sensor, 0);
+    for (uint32_t t = 1000; t < 2000; t += 5) {
+        srf02_poll(&sensor, t, &distance);
+    }
+    TEST_ASSERT_EQUAL_UINT32(9, bus_log.writes);
+}
+
+// Commande non acquittée : erreur, pas de lecture, la demande est abandonnée
+static void test_trigger_bus_error(void)
+{
+    int32_t distance = -1;
+    bus_log.write_nak = true;
+    srf02_request(&sensor);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_ERROR, srf02_poll(&sensor, 0, &distance));
+    TEST_ASSERT_EQUAL(SRF02_STATE_IDLE, sensor.state);
+    for (uint32_t t = 5; t < 500; t += 5) {
+        TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, t, &distance));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+    TEST_ASSERT_EQUAL_UINT32(0, bus_log.reads);
+
+    // Le bus revient : une nouvelle demande fonctionne
+    bus_log.write_nak = false;
+    srf02_request(&sensor);
+    srf02_poll(&sensor, 500, &distance);
+    TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&sensor, 500 + SRF02_RANGING_TIME_MS, &distance));
+}
+
+// En mode continu, une erreur de commande est réessayée à la période suivante
+static void test_periodic_retries_after_bus_error(void)
+{
+    int32_t distance = -1;
+    bus_log.write_nak = true;
+    srf02_set_period(&sensor, 100);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_ERROR, srf02_poll(&sensor, 100, &distance));
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, 150, &distance));
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+
+    bus_log.write_nak = false;
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, 200, &distance));
+    TEST_ASSERT_EQUAL_UINT32(2, bus_log.writes);
+    TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&sensor, 200 + SRF02_RANGING_TIME_MS, &distance));
+}
+
+// Lecture non acquittée : erreur, retour au repos, la distance n'est pas modifiée
+static void test_read_bus_error(void)
+{
+    int32_t distance = -1;
+    bus_log.read_nak = true;
+    srf02_request(&sensor);
+    srf02_poll(&sensor, 0, &distance);
+
+    TEST_ASSERT_EQUAL(SRF02_RES_ERROR, srf02_poll(&sensor, SRF02_RANGING_TIME_MS, &distance));
+    TEST_ASSERT_EQUAL(SRF02_STATE_IDLE, sensor.state);
+    TEST_ASSERT_EQUAL_INT32(-1, distance);
+
+    // Pas de nouvelle lecture sans nouvelle mesure
+    TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&sensor, 1000, &distance));
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.reads);
+    TEST_ASSERT_EQUAL_UINT32(1, bus_log.writes);
+}
+
+// Le capteur simulé de l'émulateur refuse la lecture pendant la mesure et répond dans [20, 300] cm ensuite
+static void test_fake_device(void)
+{
+    const srf02_bus_t * bus = srf02_fake_bus();
+    srf02_t fake;
+    int32_t distance = -1;
+    uint8_t buf[2];
+    srf02_init(&fake, bus, SRF02_DEFAULT_ADDRESS);
+
+    for (uint32_t start = 0; start < 40000; start += 1000) {
+        srf02_fake_set_time(start);
+        srf02_request(&fake);
+        TEST_ASSERT_EQUAL(SRF02_RES_NONE, srf02_poll(&fake, start, &distance));
+
+        srf02_fake_set_time(start + 10);
+        TEST_ASSERT_FALSE(bus->read_regs(SRF02_DEFAULT_ADDRESS, 0x02, buf, 2, bus->user_data));
+
+        srf02_fake_set_time(start + SRF02_RANGING_TIME_MS);
+        TEST_ASSERT_EQUAL(SRF02_RES_SAMPLE, srf02_poll(&fake, start + SRF02_RANGING_TIME_MS, &distance));
+        TEST_ASSERT_INT32_WITHIN(143, 160, distance);
+    }
+
+    // Mauvaise adresse : pas d'acquittement
+    TEST_ASSERT_FALSE(bus->read_regs(SRF02_DEFAULT_ADDRESS + 1, 0x02, buf, 2, bus->user_data));
+}
+
+int main(int argc, char ** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_without_request);
+    RUN_TEST(test_request_reads_after_ranging_time);
+    RUN_TEST(test_no_read_before_ranging_ends);
+    RUN_TEST(test_ranging_time_across_tick_wrap);
+    RUN_TEST(test_periodic_triggers);
+    RUN_TEST(test_trigger_bus_error);
+    RUN_TEST(test_periodic_retries_after_bus_error);
+    RUN_TEST(test_read_bus_error);
+    RUN_TEST(test_fake_device);
+    return UNITY_END();
+}